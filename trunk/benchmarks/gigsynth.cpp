@@ -35,7 +35,8 @@ float* pOutputR;
 
 void printmode(int mode) {
     printf("Synthesis Mode: %d ",mode);
-    printf("(BITDEPTH=%s,%s,DOLOOP=%s,FILTER=%s,INTERPOLATE=%s)\n",
+    printf("(IMPL=%s,BITDEPTH=%s,%s,DOLOOP=%s,FILTER=%s,INTERPOLATE=%s)\n",
+           (SYNTHESIS_MODE_GET_IMPLEMENTATION(mode)) ? "SIMD" : "CPP",
            (SYNTHESIS_MODE_GET_BITDEPTH24(mode)) ? "24" : "16",
            (SYNTHESIS_MODE_GET_CHANNELS(mode)) ? "STEREO" : "MONO",
            (SYNTHESIS_MODE_GET_LOOP(mode)) ? "y" : "n",
@@ -64,6 +65,7 @@ int main() {
     pParam->fFinalVolumeDeltaLeft = 0;
     pParam->fFinalVolumeDeltaRight = 0;
     pParam->pSrc = pSampleInputBuf;
+    pParam->Interpolation = DEFAULT_INTERPOLATION;
 
     // define some loop points
     Loop* pLoop = new Loop;
@@ -72,7 +74,7 @@ int main() {
     pLoop->uiSize  = 16;
     pLoop->uiTotalCycles = 0; // infinity
 
-    for (int mode = 0; mode < 32; mode++) {
+    for (int mode = 0; mode < 64; mode++) {
             // zero out output buffers
             memset(pOutputL,0,FRAGMENTSIZE*sizeof(float));
             memset(pOutputR,0,FRAGMENTSIZE*sizeof(float));
@@ -80,6 +82,13 @@ int main() {
             pParam->filterLeft.Reset();
             pParam->filterRight.Reset();
 
+            // constant volume on both channels
+            int mixerMode = 0;
+            MIXER_MODE_SET_LEFT(mixerMode, true);
+            MIXER_MODE_SET_RIGHT(mixerMode, true);
+            MIXER_MODE_SET_IMPLEMENTATION(mixerMode, SYNTHESIS_MODE_GET_IMPLEMENTATION(mode));
+            pParam->pMixFunction = Mixer::GetMixFunction(mixerMode);
+
             printf("Benchmarking ");
             printmode(mode);
 
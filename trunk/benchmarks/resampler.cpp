@@ -0,0 +1,133 @@
+/*
+    Resampler benchmark
+
+    Compares the interpolation algorithms of the sampler's synthesis core
+    (linear, cubic and windowed sinc) in terms of CPU time and audio
+    quality. A pure sine wave is resampled by various pitch factors and the
+    output is compared with the mathematically exact result. The quality
+    is given as signal-to-noise ratio (SNR) in dB, where "noise" is the sum
+    of all interpolation errors, including aliasing products. Higher SNR
+    values are better.
+
+    Call 'make resampler' to compile and then './resampler' to run it.
+*/
+
+#include <math.h>
+#include <time.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <gig.h>
+
+#include "../src/engines/gig/SynthesisParam.h"
+#include "../src/engines/gig/Synthesizer.h"
+
+#define FRAGMENTSIZE    256
+#define SAMPLES         (FRAGMENTSIZE * 20) // length of test signal (without read ahead area)
+#define RUNS            20000
+#define AMPLITUDE       16384.0
+
+using namespace LinuxSampler;
+using namespace LinuxSampler::gig;
+
+int16_t pSampleInputBuf[SAMPLES * 4];
+float pOutputL[FRAGMENTSIZE];
+float pOutputR[FRAGMENTSIZE];
+
+static const char* algorithmName(interpolation_t algorithm) {
+    switch (algorithm) {
+        case interpolation_linear: return "LINEAR";
+        case interpolation_cubic:  return "CUBIC";
+        case interpolation_sinc:   return "SINC";
+    }
+    return "?";
+}
+
+static void prepareParams(SynthesisParam* pParam, int mode, interpolation_t algorithm, float pitch) {
+    int mixerMode = 0;
+    MIXER_MODE_SET_LEFT(mixerMode, true);
+    MIXER_MODE_SET_RIGHT(mixerMode, true);
+    MIXER_MODE_SET_IMPLEMENTATION(mixerMode, SYNTHESIS_MODE_GET_IMPLEMENTATION(mode));
+    pParam->pMixFunction = Mixer::GetMixFunction(mixerMode);
+    pParam->fFinalPitch = pitch;
+    pParam->fFinalVolumeLeft = 1.0f;
+    pParam->fFinalVolumeRight = 1.0f;
+    pParam->fFinalVolumeDeltaLeft = 0;
+    pParam->fFinalVolumeDeltaRight = 0;
+    pParam->pSrc = pSampleInputBuf;
+    pParam->Interpolation = algorithm;
+    pParam->dPos = 0.0;
+    pParam->pOutLeft  = pOutputL;
+    pParam->pOutRight = pOutputR;
+    pParam->uiToGo = FRAGMENTSIZE;
+}
+
+// SNR of one fragment rendered at the given pitch from a sine with
+// frequency 'freq' (relative to the sample rate)
+static double measureSNR(int mode, interpolation_t algorithm, float pitch, double freq) {
+    for (int i = 0; i < SAMPLES * 4; i++)
+        pSampleInputBuf[i] = int16_t(AMPLITUDE * sin(2.0 * M_PI * freq * i));
+    memset(pOutputL, 0, sizeof(pOutputL));
+    memset(pOutputR, 0, sizeof(pOutputR));
+
+    SynthesisParam param;
+    prepareParams(&param, mode, algorithm, pitch);
+    param.dPos = 1000.25; // arbitrary start position, far enough from the start of the signal
+    const double startPos = param.dPos;
+    RunSynthesisFunction(mode, &param, NULL);
+
+    double signal = 0.0, noise = 0.0;
+    for (int i = 0; i < FRAGMENTSIZE; i++) {
+        // the playback position lags behind the sample point heard
+        const double pos   = startPos + double(i) * pitch + INTERPOLATION_PRE_ROLL;
+        const double exact = AMPLITUDE * sin(2.0 * M_PI * freq * pos);
+        signal += exact * exact;
+        noise  += (pOutputL[i] - exact) * (pOutputL[i] - exact);
+    }
+    return 10.0 * log10(signal / noise);
+}
+
+static double measureTime(int mode, interpolation_t algorithm, float pitch) {
+    SynthesisParam param;
+    clock_t start_time = clock();
+    for (uint i = 0; i < RUNS; i++) {
+        prepareParams(&param, mode, algorithm, pitch);
+        RunSynthesisFunction(mode, &param, NULL);
+    }
+    clock_t stop_time = clock();
+    return (stop_time - start_time) / (double(CLOCKS_PER_SEC) / 1000.0);
+}
+
+int main() {
+    const interpolation_t algorithms[] = { interpolation_linear, interpolation_cubic, interpolation_sinc };
+    const float pitches[] = { 0.5f, 0.97f, 1.5f };
+    const double freqs[]  = { 0.01, 0.1, 0.25 };
+
+    // mono, no filter, no loop, interpolation on (scalar and SIMD implementation)
+    const int modes[] = { 0x01, 0x21 };
+
+    printf("Interpolation quality (SNR in dB, higher is better):\n");
+    printf("%-8s", "");
+    for (int p = 0; p < 3; p++)
+        for (int f = 0; f < 3; f++)
+            printf(" p=%-4.2f f=%-4.2f", pitches[p], freqs[f]);
+    printf("\n");
+    for (int a = 0; a < 3; a++) {
+        printf("%-8s", algorithmName(algorithms[a]));
+        for (int p = 0; p < 3; p++)
+            for (int f = 0; f < 3; f++)
+                printf(" %15.1f", measureSNR(modes[0], algorithms[a], pitches[p], freqs[f]));
+        printf("\n");
+    }
+
+    printf("\nCPU time (%d x %d output sample points, mono):\n", RUNS, FRAGMENTSIZE);
+    for (int m = 0; m < 2; m++) {
+        for (int a = 0; a < 3; a++) {
+            printf("%-8s (%s)\t: %1.0f ms\n", algorithmName(algorithms[a]),
+                   SYNTHESIS_MODE_GET_IMPLEMENTATION(modes[m]) ? "SIMD" : "CPP",
+                   measureTime(modes[m], algorithms[a], 1.5f));
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
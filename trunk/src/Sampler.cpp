@@ -785,6 +785,17 @@ namespace LinuxSampler {
         return count;
     }
 
+    int Sampler::GetCulledVoiceCount() {
+        int count = 0;
+        std::set<Engine*>::iterator it = EngineFactory::EngineInstances().begin();
+
+        for(; it != EngineFactory::EngineInstances().end(); it++) {
+            count += (*it)->CulledVoiceCount();
+        }
+
+        return count;
+    }
+
     int Sampler::GetGlobalMaxVoices() {
         return GLOBAL_MAX_VOICES; // see common/global_private.cpp
     }
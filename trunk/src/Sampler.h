@@ -564,6 +564,14 @@ namespace LinuxSampler {
              */
             int GetVoiceCount();
 
+            /**
+             * Gets the total number of voices faded out early by all
+             * sampler engines, because they were inaudible.
+             *
+             * @see Engine::CulledVoiceCount()
+             */
+            int GetCulledVoiceCount();
+
             /**
              * @see SetGlobalMaxVoices()
              */
@@ -752,7 +760,10 @@ namespace LinuxSampler {
             /**
              * Advise the FPU to treat denormal floating point numbers as
              * zero, to avoid severe performance penalty when dealing with
-             * such extreme floating point values.
+             * such extreme floating point values. This only applies to the
+             * calling thread. LinuxSampler's own threads and the audio
+             * rendering of all audio output devices (including the ones of
+             * plugin hosts) already do this by themselves.
              *
              * @returns @c true if FPU supports it, @c false otherwise
              */
@@ -58,26 +58,101 @@ void Features::detect() {
 void Features::detect() {}
 #endif // CONFIG_ASM && ARCH_X86
 
+// Access to the control register of the floating point unit used for
+// (scalar and vector) single precision floating point math, and the bits
+// which make it flush denormal numbers to zero.
+#if HAVE_FPU_FTZ_MODE && !defined(__aarch64__)
+# define FPU_FTZ_MODE_BITS 0x8040 // MXCSR: FZ (flush to zero) | DAZ (denormals are zero)
+
+static inline bool supportsFTZMode() {
+    #ifdef __x86_64__
+    return true; // SSE2 is part of x86-64
+    #else
+    return Features::supportsSSE2();
+    #endif
+}
+
+static inline uint64_t getFPUControl() {
+    uint32_t x;
+    __asm__ __volatile__ ("stmxcsr %0" : "=m" (x));
+    return x;
+}
+
+static inline void setFPUControl(uint64_t value) {
+    uint32_t x = (uint32_t) value;
+    __asm__ __volatile__ ("ldmxcsr %0" :: "m" (x));
+}
+#elif HAVE_FPU_FTZ_MODE
+# define FPU_FTZ_MODE_BITS (1 << 24) // FPCR: FZ (flush to zero)
+
+static inline bool supportsFTZMode() {
+    return true;
+}
+
+static inline uint64_t getFPUControl() {
+    uint64_t x;
+    __asm__ __volatile__ ("mrs %0, fpcr" : "=r" (x));
+    return x;
+}
+
+static inline void setFPUControl(uint64_t x) {
+    __asm__ __volatile__ ("msr fpcr, %0" :: "r" (x));
+}
+#endif
+
+/**
+ * Advises the FPU to flush denormal numbers to zero (FTZ) and to treat
+ * denormal input numbers as zero (DAZ, if supported by the CPU). Note that
+ * this is a per thread setting, so it has to be called by each thread which
+ * does floating point DSP math (see Thread and AudioOutputDevice::RenderAudio()).
+ *
+ * @returns @c true if FPU supports it, @c false otherwise
+ */
 bool Features::enableDenormalsAreZeroMode() {
-    #if CONFIG_ASM && ARCH_X86
-    if (supportsSSE2()) {
-        int x;
-        __asm__ __volatile__ (
-            "stmxcsr %0\n\t"
-            "movl    %0, %%eax\n\t"
-            "orl     $0x40, %%eax\n\t"
-            "movl    %%eax, %0\n\t"
-            "ldmxcsr %0\n\t"
-            :: "m" (x)
-            : "%eax"
-        );
+    #if HAVE_FPU_FTZ_MODE
+    if (supportsFTZMode()) {
+        const uint64_t mode = getFPUControl();
+        if ((mode & FPU_FTZ_MODE_BITS) != FPU_FTZ_MODE_BITS)
+            setFPUControl(mode | FPU_FTZ_MODE_BITS);
         return true;
     }
+    #endif
     return false;
-    #else
+}
 
+/**
+ * Returns whether the FPU supports flushing denormal numbers to zero (see
+ * enableDenormalsAreZeroMode()).
+ */
+bool Features::supportsDenormalsAreZeroMode() {
+    #if HAVE_FPU_FTZ_MODE
+    return supportsFTZMode();
+    #else
     return false;
-    #endif // CONFIG_ASM && ARCH_X86
+    #endif
+}
+
+Features::DenormalsAreZeroScope::DenormalsAreZeroScope(bool bEnable) {
+    #if HAVE_FPU_FTZ_MODE
+    bRestore = supportsFTZMode();
+    if (bRestore) {
+        previousMode = getFPUControl();
+        const uint64_t mode = (bEnable) ? previousMode | FPU_FTZ_MODE_BITS
+                                        : previousMode & ~uint64_t(FPU_FTZ_MODE_BITS);
+        if (mode != previousMode)
+            setFPUControl(mode);
+        else
+            bRestore = false;
+    }
+    #else
+    bRestore = false;
+    #endif
+}
+
+Features::DenormalsAreZeroScope::~DenormalsAreZeroScope() {
+    #if HAVE_FPU_FTZ_MODE
+    if (bRestore) setFPUControl(previousMode);
+    #endif
 }
 
 String Features::featuresAsString() {
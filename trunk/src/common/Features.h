@@ -26,6 +26,16 @@
 
 #include "global_private.h"
 
+// Whether the FPU which is used for (scalar and vector) single precision
+// floating point math can flush denormal numbers to zero (see
+// Features::enableDenormalsAreZeroMode()). If not, the DSP code has to
+// prevent denormal numbers by itself.
+#if defined(__x86_64__) || defined(__aarch64__) || (CONFIG_ASM && ARCH_X86 && defined(__SSE_MATH__))
+# define HAVE_FPU_FTZ_MODE 1
+#else
+# define HAVE_FPU_FTZ_MODE 0
+#endif
+
 /**
  * Detects system / CPU specific features at runtime.
  */
@@ -33,6 +43,7 @@ class Features {
     public:
         static void   detect();
         static bool   enableDenormalsAreZeroMode();
+        static bool   supportsDenormalsAreZeroMode();
         static String featuresAsString();
 
         #if CONFIG_ASM && ARCH_X86
@@ -40,6 +51,22 @@ class Features {
         inline static bool supportsSSE() { return bSSE; }
         inline static bool supportsSSE2() { return bSSE2; }
         #endif // CONFIG_ASM && ARCH_X86
+
+        /**
+         * Enables the FPU's flush to zero / denormals are zero mode for the
+         * calling thread for the life time of this object, and restores the
+         * thread's previous FPU mode afterwards. Used on threads which are
+         * not owned by LinuxSampler, i.e. audio callbacks of plugin hosts.
+         * If @a bEnable is false, the mode is disabled instead.
+         */
+        class DenormalsAreZeroScope {
+            public:
+                DenormalsAreZeroScope(bool bEnable = true);
+                ~DenormalsAreZeroScope();
+            private:
+                uint64_t previousMode;
+                bool     bRestore;
+        };
     private:
         #if CONFIG_ASM && ARCH_X86
         static bool bMMX;
@@ -0,0 +1,140 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_MULTIPRODUCERRINGBUFFER_H__
+#define __LS_MULTIPRODUCERRINGBUFFER_H__
+
+#include "lsatomic.h"
+
+namespace LinuxSampler {
+
+    /** @brief Lock free ring buffer for several sending threads
+     *
+     * Like RingBuffer, this constant size buffer sends elements of type
+     * @c T to exactly one receiving thread, but it may be written by any
+     * amount of sending threads at the same time. Neither side ever blocks or
+     * allocates memory, so it can be used on real-time threads, i.e. by
+     * voices which may be rendered by several threads in parallel.
+     *
+     * Each slot carries a sequence number, which tells whether the slot
+     * is free for the sender of the respective position or contains an
+     * element for the receiver (bounded queue design by Dmitry Vyukov).
+     * Senders reserve a position by a compare and swap, so a sender
+     * merely retries if another sender was faster. An element whose
+     * sender reserved its slot but did not finish writing it yet, is
+     * not popped before it is complete, which also delays the elements
+     * behind it.
+     *
+     * Elements are copied with their assignment operator.
+     */
+    template<class T>
+    class MultiProducerRingBuffer {
+    public:
+        /**
+         * Creates a ring buffer for at least @a sz elements (rounded up to
+         * the next power of two).
+         */
+        MultiProducerRingBuffer(int sz) {
+            size = 1;
+            while (size < sz) size <<= 1;
+            size_mask = size - 1;
+            cells = new cell_t[size];
+            init();
+        }
+
+        virtual ~MultiProducerRingBuffer() {
+            delete[] cells;
+        }
+
+        /**
+         * Empties the buffer. Must not be called while other threads
+         * access the buffer.
+         */
+        void init() {
+            for (int i = 0; i < size; i++)
+                cells[i].sequence.store(i, memory_order_relaxed);
+            write_pos.store(0, memory_order_relaxed);
+            read_pos = 0;
+            atomic_thread_fence(memory_order_seq_cst);
+        }
+
+        /**
+         * Appends a copy of the given element. May be called by several
+         * sending threads at the same time.
+         *
+         * @returns 1 on success, 0 if the buffer is full
+         */
+        int push(const T* src) {
+            int pos = write_pos.load(memory_order_relaxed);
+            while (true) {
+                cell_t& cell = cells[pos & size_mask];
+                const int dif = int((unsigned int)(cell.sequence.load(memory_order_acquire)) - (unsigned int)(pos));
+                if (dif == 0) {
+                    // slot is free, try to reserve it (updates pos on failure)
+                    if (write_pos.compare_exchange_strong(pos, int((unsigned int)(pos) + 1))) {
+                        cell.data = *src;
+                        cell.sequence.store(int((unsigned int)(pos) + 1), memory_order_release);
+                        return 1;
+                    }
+                } else if (dif < 0) {
+                    return 0; // full
+                } else {
+                    // another sender already took this position
+                    pos = write_pos.load(memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Removes the oldest element and copies it to @a dst. Must only be
+         * called by the receiving thread.
+         *
+         * @returns 1 on success, 0 if there is no (completely written)
+         *          element
+         */
+        int pop(T* dst) {
+            cell_t& cell = cells[read_pos & size_mask];
+            if (cell.sequence.load(memory_order_acquire) != int((unsigned int)(read_pos) + 1))
+                return 0;
+            *dst = cell.data;
+            cell.sequence.store(int((unsigned int)(read_pos) + size), memory_order_release);
+            read_pos = int((unsigned int)(read_pos) + 1);
+            return 1;
+        }
+
+    private:
+        struct cell_t {
+            atomic<int> sequence;
+            T           data;
+        };
+
+        cell_t*     cells;
+        int         size;
+        int         size_mask;
+        atomic<int> write_pos; ///< next position to be reserved by a sender
+        int         read_pos;  ///< next position to be popped by the receiver
+    };
+
+} // namespace LinuxSampler
+
+#endif // __LS_MULTIPRODUCERRINGBUFFER_H__
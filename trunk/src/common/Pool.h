@@ -40,6 +40,8 @@
 
 #include <iostream>
 
+#include "lsatomic.h"
+
 #if CONFIG_DEVMODE
 # include <string>
 # include <stdexcept>
@@ -76,18 +78,14 @@ class RTListBase {
             _Node<T1>* next;
             _Node<T1>* prev;
             T1* data;
-            #if CONFIG_DEVMODE
             RTListBase<T1>* list; // list to which this node currently belongs to
-            #endif // CONFIG_DEVMODE
             uint reincarnation; // just for Pool::fromID()
 
             _Node() {
                 next = NULL;
                 prev = NULL;
                 data = NULL;
-                #if CONFIG_DEVMODE
                 list = NULL;
-                #endif // CONFIG_DEVMODE
                 reincarnation = 0;
             }
 
@@ -448,15 +446,25 @@ class RTListBase {
             return _begin.next == &_end;
         }
 
-        inline int count() {
-            int elements = 0;
-            for (Iterator it = first(); it != end(); ++it) ++elements;
-            return elements;
+        /**
+         * Returns the amount of elements currently on this list. The counter
+         * is maintained on each list operation, so this is a constant time
+         * operation, and it may also be called by another thread than the
+         * one modifying the list (which then might just get a slightly
+         * outdated value).
+         */
+        inline int count() const {
+            return elements.load(LinuxSampler::memory_order_relaxed);
         }
 
     protected:
         Node _begin; // fake node (without data) which represents the begin of the list - not the first element!
         Node _end;   // fake node (without data) which represents the end of the list - not the last element!
+        LinuxSampler::atomic<int> elements; // amount of elements on this list (only modified by the thread owning the list)
+
+        inline void addCount(int n) {
+            elements.store(elements.load(LinuxSampler::memory_order_relaxed) + n, LinuxSampler::memory_order_relaxed);
+        }
 
         RTListBase() {
             init();
@@ -470,10 +478,9 @@ class RTListBase {
             _end.next = &_end;
             _end.prev = &_begin;
             _end.data = NULL;
-            #if CONFIG_DEVMODE
             _begin.list = this;
             _end.list   = this;
-            #endif // CONFIG_DEVMODE
+            elements.store(0, LinuxSampler::memory_order_relaxed);
         }
 
         inline void append(Iterator itElement) {
@@ -483,9 +490,8 @@ class RTListBase {
             pNode->prev = last; // if a segfault happens here, then because 'itElement' Iterator became invalidated
             pNode->next = &_end;
             _end.prev   = pNode;
-            #if CONFIG_DEVMODE
             pNode->list = this;
-            #endif // CONFIG_DEVMODE
+            addCount(1);
         }
 
         inline void append(Iterator itFirst, Iterator itLast) {
@@ -496,12 +502,7 @@ class RTListBase {
             pFirst->prev = last;  // if a segfault happens here, then because 'itFirst' Iterator became invalidated
             pLast->next  = &_end; // if a segfault happens here, then because 'itLast' Iterator became invalidated
             _end.prev    = pLast;
-            #if CONFIG_DEVMODE
-            for (Node* pNode = pFirst; true; pNode = pNode->next) {
-                pNode->list = this;
-                if (pNode == pLast) break;
-            }
-            #endif // CONFIG_DEVMODE
+            adopt(pFirst, pLast);
         }
 
         inline void prepend(Iterator itElement) {
@@ -511,9 +512,8 @@ class RTListBase {
             pNode->prev = &_begin; // if a segfault happens here, then because 'itElement' Iterator became invalidated
             pNode->next = first;
             first->prev = pNode;
-            #if CONFIG_DEVMODE
             pNode->list = this;
-            #endif // CONFIG_DEVMODE
+            addCount(1);
         }
 
         inline void prepend(Iterator itFirst, Iterator itLast) {
@@ -524,12 +524,18 @@ class RTListBase {
             pFirst->prev = &_begin; // if a segfault happens here, then because 'itFirst' Iterator became invalidated
             pLast->next  = first;   // if a segfault happens here, then because 'itLast' Iterator became invalidated
             first->prev  = pLast;
-            #if CONFIG_DEVMODE
+            adopt(pFirst, pLast);
+        }
+
+        // assigns the (already linked) nodes pFirst .. pLast to this list
+        inline void adopt(Node* pFirst, Node* pLast) {
+            int n = 0;
             for (Node* pNode = pFirst; true; pNode = pNode->next) {
                 pNode->list = this;
+                ++n;
                 if (pNode == pLast) break;
             }
-            #endif // CONFIG_DEVMODE
+            addCount(n);
         }
 
         static inline void prependBefore(Iterator itSrc, Iterator itDst) {
@@ -540,9 +546,8 @@ class RTListBase {
             dst->prev  = src;
             src->prev  = prev;
             src->next  = dst;
-            #if CONFIG_DEVMODE
-            src->list = dst->list;
-            #endif // CONFIG_DEVMODE
+            src->list  = dst->list;
+            src->list->addCount(1);
         }
 
         static inline void appendAfter(Iterator itSrc, Iterator itDst) {
@@ -553,9 +558,8 @@ class RTListBase {
             dst->next  = src;
             src->prev  = dst;
             src->next  = next;
-            #if CONFIG_DEVMODE
-            src->list = dst->list;
-            #endif // CONFIG_DEVMODE
+            src->list  = dst->list;
+            src->list->addCount(1);
         }
 
         static inline void detach(Iterator itElement) {
@@ -564,13 +568,22 @@ class RTListBase {
             Node* next = pNode->next;
             prev->next = next;
             next->prev = prev;
+            pNode->list->addCount(-1);
         }
 
         static inline void detach(Iterator itFirst, Iterator itLast) {
-            Node* prev = itFirst.node()->prev; // if a segfault happens here, then because 'itFirst' Iterator became invalidated
-            Node* next = itLast.node()->next;  // if a segfault happens here, then because 'itLast' Iterator became invalidated
+            Node* pFirst = itFirst.node();
+            Node* pLast  = itLast.node();
+            Node* prev = pFirst->prev; // if a segfault happens here, then because 'itFirst' Iterator became invalidated
+            Node* next = pLast->next;  // if a segfault happens here, then because 'itLast' Iterator became invalidated
             prev->next = next;
             next->prev = prev;
+            int n = 0;
+            for (Node* pNode = pFirst; true; pNode = pNode->next) {
+                ++n;
+                if (pNode == pLast) break;
+            }
+            pFirst->list->addCount(-n);
         }
 
         friend class _Iterator<T>;
@@ -711,13 +724,15 @@ class Pool : public RTList<T> {
          *
          * @see poolIsEmpty()
          */
-        bool poolHasFreeElements(int elements) {
-            for (Iterator it = freelist.first(); it != freelist.end() && elements >= 0; ++it)
-                --elements;
-            return elements <= 0;
+        bool poolHasFreeElements(int elements) const {
+            return freelist.count() >= elements;
         }
 
-        int countFreeElements() {
+        /**
+         * Returns the amount of elements which are currently not allocated.
+         * This is a constant time operation.
+         */
+        int countFreeElements() const {
             return freelist.count();
         }
 
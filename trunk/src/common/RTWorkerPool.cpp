@@ -0,0 +1,159 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#include "RTWorkerPool.h"
+
+#if !defined(WIN32)
+# include <unistd.h>
+#endif
+
+// amount of polling iterations a worker busy waits for new jobs before it
+// goes to sleep (roughly some 10 microseconds), this is long enough to catch
+// the jobs of all engines within the same audio fragment cycle, but the
+// workers don't burn the CPU between the audio fragment cycles
+#define RT_WORKER_SPIN_COUNT 4096
+
+namespace LinuxSampler {
+
+    // tells the CPU that we are in a busy wait loop
+    static inline void cpuRelax() {
+        #if defined(__i386__) || defined(__x86_64__)
+        __asm__ __volatile__("pause" : : : "memory");
+        #elif defined(__aarch64__)
+        __asm__ __volatile__("yield" : : : "memory");
+        #else
+        atomic_thread_fence(memory_order_seq_cst);
+        #endif
+    }
+
+
+// *************** Worker ***************
+// *
+
+    RTWorkerPool::Worker::Worker(RTWorkerPool* pPool, bool RealTime)
+        : Thread(true, RealTime, 1, RealTime ? 0 : -2), Sleeping(0), pPool(pPool) {
+    }
+
+    int RTWorkerPool::Worker::Main() {
+        int generation = pPool->Generation.load(memory_order_acquire);
+        while (true) {
+            // wait for the next Run() call
+            for (int spins = 0; pPool->Generation.load(memory_order_acquire) == generation; ) {
+                if (++spins < RT_WORKER_SPIN_COUNT) {
+                    cpuRelax();
+                    continue;
+                }
+                // nothing arrived for a while, so go to sleep; Run() checks
+                // our Sleeping flag after it incremented the generation, so
+                // the generation has to be checked again after setting it
+                Sleeping.store(1);
+                if (pPool->Generation.load() == generation) {
+                    wakeup.WaitIf(false);
+                    wakeup.PreLockedSet(false);
+                    wakeup.Unlock();
+                }
+                Sleeping.store(0);
+                spins = 0;
+                #if CONFIG_PTHREAD_TESTCANCEL
+                TestCancel();
+                #endif
+            }
+            generation = pPool->Generation.load(memory_order_acquire);
+
+            pPool->ProcessJobs();
+        }
+        return 0;
+    }
+
+
+// *************** RTWorkerPool ***************
+// *
+
+    RTWorkerPool::RTWorkerPool(int Threads, bool RealTime)
+        : pJob(NULL), iJobCount(0), Generation(0), Running(0), NextJob(0),
+          CompletedJobs(0), ActiveWorkers(0)
+    {
+        // the workers busy wait and are real-time threads, so more threads
+        // than CPU cores would just steal CPU time from each other
+        #if defined(_SC_NPROCESSORS_ONLN)
+        const int cores = int(sysconf(_SC_NPROCESSORS_ONLN));
+        if (RealTime && cores > 0 && Threads > cores - 1) Threads = cores - 1;
+        #endif
+        for (int i = 0; i < Threads; ++i) {
+            Worker* pWorker = new Worker(this, RealTime);
+            workers.push_back(pWorker);
+            pWorker->StartThread();
+        }
+        dmsg(1,("RTWorkerPool: %d %sworker threads launched\n", Threads, RealTime ? "real-time " : ""));
+    }
+
+    RTWorkerPool::~RTWorkerPool() {
+        for (int i = 0; i < workers.size(); ++i) {
+            workers[i]->StopThread();
+            delete workers[i];
+        }
+    }
+
+    void RTWorkerPool::Run(Job* pJob, int JobCount) {
+        if (JobCount <= 0) return;
+        // Running is only set while jobs of the outer Run() call are
+        // processed, so if it is set here, we were called by one of its jobs
+        if (workers.empty() || JobCount == 1 || Running.load(memory_order_relaxed)) {
+            for (int i = 0; i < JobCount; ++i) pJob->Process(i);
+            return;
+        }
+
+        this->pJob = pJob;
+        iJobCount  = JobCount;
+        NextJob.store(0, memory_order_relaxed);
+        CompletedJobs.store(0, memory_order_relaxed);
+        Running.store(1, memory_order_release);
+        Generation.store(Generation.load(memory_order_relaxed) + 1);
+
+        // wake up those workers which went to sleep meanwhile
+        for (int i = 0; i < workers.size(); ++i)
+            if (workers[i]->Sleeping.load()) workers[i]->wakeup.Set(true);
+
+        // lend a hand
+        ProcessJobs();
+
+        while (CompletedJobs.load(memory_order_acquire) < JobCount) cpuRelax();
+
+        // don't return before the last worker left ProcessJobs(), otherwise
+        // it might grab a job of the next Run() call with stale job data
+        Running.store(0);
+        while (ActiveWorkers.load(memory_order_acquire)) cpuRelax();
+    }
+
+    void RTWorkerPool::ProcessJobs() {
+        ActiveWorkers.fetch_add(1);
+        if (Running.load()) {
+            for (int i = NextJob.fetch_add(1); i < iJobCount; i = NextJob.fetch_add(1)) {
+                pJob->Process(i);
+                CompletedJobs.fetch_add(1);
+            }
+        }
+        ActiveWorkers.fetch_sub(1);
+    }
+
+} // namespace LinuxSampler
@@ -0,0 +1,118 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_RTWORKERPOOL_H__
+#define __LS_RTWORKERPOOL_H__
+
+#include <vector>
+
+#include "global_private.h"
+#include "Thread.h"
+#include "Condition.h"
+#include "lsatomic.h"
+
+namespace LinuxSampler {
+
+    /** @brief Real-time worker threads for parallel audio rendering
+     *
+     * Pool of pre-spawned real-time threads, which help the audio thread
+     * to process a set of independent jobs in parallel within the current
+     * audio fragment cycle. Dispatching jobs with Run() neither allocates
+     * memory nor takes any locks: the workers busy wait for new jobs for a
+     * short while after they finished their last job, and only if nothing
+     * arrived in the meantime they go to sleep on a condition, in which
+     * case Run() has to wake them up again.
+     *
+     * Only one thread at a time may call Run(). A job may call Run() again
+     * though, in which case the nested jobs are simply processed by the
+     * thread of the calling job.
+     *
+     * The workers may also be ordinary (non real-time) threads, for jobs
+     * which block, for example on disk I/O.
+     */
+    class RTWorkerPool {
+    public:
+        /**
+         * Abstract interface of the work to be done by Run(). Process()
+         * is called exactly once for each job index, by an arbitrary
+         * thread of the pool and in arbitrary order, so the individual
+         * jobs must not depend on each other.
+         */
+        class Job {
+        public:
+            virtual void Process(int iJob) = 0;
+            virtual ~Job() {}
+        };
+
+        /**
+         * Creates and launches the given amount of worker threads. The
+         * thread calling Run() is always working on the jobs as well, so
+         * up to @a Threads + 1 jobs are processed in parallel.
+         *
+         * @param Threads  - amount of worker threads
+         * @param RealTime - whether the workers should be real-time
+         *                   threads, in which case they are limited to the
+         *                   amount of CPU cores
+         */
+        RTWorkerPool(int Threads, bool RealTime = true);
+        virtual ~RTWorkerPool();
+
+        /**
+         * Returns the amount of worker threads (not counting the thread
+         * calling Run()).
+         */
+        int ThreadCount() const { return int(workers.size()); }
+
+        /**
+         * Processes the jobs 0 .. @a JobCount - 1 of @a pJob in parallel and
+         * blocks until all of them are finished.
+         */
+        void Run(Job* pJob, int JobCount);
+
+    private:
+        class Worker : public Thread {
+        public:
+            Worker(RTWorkerPool* pPool, bool RealTime);
+            int Main() OVERRIDE;
+
+            Condition   wakeup;   ///< set by Run() in case this worker went to sleep
+            atomic<int> Sleeping; ///< 1 while this worker is about to sleep or sleeping
+        private:
+            RTWorkerPool* pPool;
+        };
+
+        void ProcessJobs();
+
+        std::vector<Worker*> workers;
+        Job*                 pJob;
+        int                  iJobCount;
+        atomic<int>          Generation;    ///< incremented on each Run() call
+        atomic<int>          Running;       ///< 1 while jobs of the current Run() call may be grabbed
+        atomic<int>          NextJob;       ///< index of the next job to be grabbed
+        atomic<int>          CompletedJobs; ///< amount of jobs of the current Run() call which are finished
+        atomic<int>          ActiveWorkers; ///< amount of threads currently inside ProcessJobs()
+    };
+
+} // namespace LinuxSampler
+
+#endif // __LS_RTWORKERPOOL_H__
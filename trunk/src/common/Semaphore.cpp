@@ -0,0 +1,114 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#include "Semaphore.h"
+
+#if !defined(WIN32) && !defined(__APPLE__)
+# include <errno.h>
+# include <sys/time.h>
+#endif
+#include <limits.h>
+
+namespace LinuxSampler {
+
+#if defined(WIN32)
+
+    Semaphore::Semaphore() {
+        hSemaphore = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+    }
+
+    Semaphore::~Semaphore() {
+        CloseHandle(hSemaphore);
+    }
+
+    void Semaphore::Post() {
+        ReleaseSemaphore(hSemaphore, 1, NULL);
+    }
+
+    void Semaphore::Wait() {
+        WaitForSingleObject(hSemaphore, INFINITE);
+    }
+
+    int Semaphore::TimedWait(long TimeoutMicroSeconds) {
+        DWORD res = WaitForSingleObject(hSemaphore, TimeoutMicroSeconds / 1000);
+        return (res == WAIT_OBJECT_0) ? 0 : -1;
+    }
+
+#elif defined(__APPLE__)
+
+    // unnamed POSIX semaphores (sem_init()) are not supported on Mac OS X
+    Semaphore::Semaphore() {
+        semaphore = dispatch_semaphore_create(0);
+    }
+
+    Semaphore::~Semaphore() {
+        dispatch_release(semaphore);
+    }
+
+    void Semaphore::Post() {
+        dispatch_semaphore_signal(semaphore);
+    }
+
+    void Semaphore::Wait() {
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    }
+
+    int Semaphore::TimedWait(long TimeoutMicroSeconds) {
+        dispatch_time_t timeout = dispatch_time(DISPATCH_TIME_NOW, int64_t(TimeoutMicroSeconds) * 1000);
+        return (dispatch_semaphore_wait(semaphore, timeout) == 0) ? 0 : -1;
+    }
+
+#else
+
+    Semaphore::Semaphore() {
+        sem_init(&semaphore, 0, 0);
+    }
+
+    Semaphore::~Semaphore() {
+        sem_destroy(&semaphore);
+    }
+
+    void Semaphore::Post() {
+        sem_post(&semaphore);
+    }
+
+    void Semaphore::Wait() {
+        while (sem_wait(&semaphore) == -1 && errno == EINTR);
+    }
+
+    int Semaphore::TimedWait(long TimeoutMicroSeconds) {
+        // sem_timedwait() expects an absolute time
+        struct timeval now;
+        gettimeofday(&now, 0);
+        struct timespec timeout;
+        long usec = now.tv_usec + TimeoutMicroSeconds;
+        timeout.tv_sec  = now.tv_sec + usec / 1000000;
+        timeout.tv_nsec = (usec % 1000000) * 1000;
+        int res;
+        while ((res = sem_timedwait(&semaphore, &timeout)) == -1 && errno == EINTR);
+        return (res == 0) ? 0 : -1;
+    }
+
+#endif
+
+} // namespace LinuxSampler
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_SEMAPHORE_H__
+#define __LS_SEMAPHORE_H__
+
+#if defined(WIN32)
+# include <windows.h>
+#elif defined(__APPLE__)
+# include <dispatch/dispatch.h>
+#else
+# include <semaphore.h>
+#endif
+
+namespace LinuxSampler {
+
+    /** @brief Counting semaphore
+     *
+     * Lightweight wrapper around the system's counting semaphore. Contrary
+     * to Condition, Post() neither takes a lock nor allocates memory, so it
+     * may be called by the real-time audio thread to wake up a sleeping
+     * non real-time thread (e.g. the disk thread).
+     */
+    class Semaphore {
+    public:
+        Semaphore();
+        virtual ~Semaphore();
+
+        /**
+         * Increments the semaphore, which wakes up one thread waiting in
+         * Wait() or TimedWait(). This call is real-time safe.
+         */
+        void Post();
+
+        /**
+         * Blocks the calling thread until the semaphore is greater than
+         * zero and decrements it.
+         */
+        void Wait();
+
+        /**
+         * Same as Wait(), but gives up after the given amount of time.
+         *
+         * @param TimeoutMicroSeconds - max. wait time in microseconds
+         * @returns 0 if the semaphore was decremented, a value less than 0
+         *          if the timeout exceeded
+         */
+        int TimedWait(long TimeoutMicroSeconds);
+
+    private:
+    #if defined(WIN32)
+        HANDLE hSemaphore;
+    #elif defined(__APPLE__)
+        dispatch_semaphore_t semaphore;
+    #else
+        sem_t semaphore;
+    #endif
+
+        Semaphore(const Semaphore&); // not allowed
+        Semaphore& operator=(const Semaphore&); // not allowed
+    };
+
+} // namespace LinuxSampler
+
+#endif // __LS_SEMAPHORE_H__
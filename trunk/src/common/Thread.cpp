@@ -22,6 +22,7 @@
  ***************************************************************************/
 
 #include "Thread.h"
+#include "Features.h"
 
 #if HAVE_CONFIG_H
 # include <config.h>
@@ -450,6 +451,9 @@ DWORD WINAPI Thread::win32threadLauncher(LPVOID lpParameter) {
     t->SetSchedulingPriority();
     t->LockMemory();
     t->EnableDestructor();
+    // prevent slow denormal FPU modes (on all our threads, since this is a
+    // per thread setting)
+    Features::enableDenormalsAreZeroMode();
     t->Main();
     return 0;
 }
@@ -468,6 +472,9 @@ void* Thread::pthreadLauncher(void* thread) {
     t->SetSchedulingPriority();
     t->LockMemory();
     t->EnableDestructor();
+    // prevent slow denormal FPU modes (on all our threads, since this is a
+    // per thread setting)
+    Features::enableDenormalsAreZeroMode();
     t->Main();
     return NULL;
 }
@@ -33,6 +33,12 @@
 #ifndef CONFIG_GLOBAL_ATTENUATION_DEFAULT
 # error "Configuration macro CONFIG_GLOBAL_ATTENUATION_DEFAULT not defined!"
 #endif // CONFIG_GLOBAL_ATTENUATION_DEFAULT
+#ifndef CONFIG_SILENCE_THRESHOLD_DEFAULT
+# error "Configuration macro CONFIG_SILENCE_THRESHOLD_DEFAULT not defined!"
+#endif // CONFIG_SILENCE_THRESHOLD_DEFAULT
+#ifndef CONFIG_SILENCE_HOLD_TIME
+# error "Configuration macro CONFIG_SILENCE_HOLD_TIME not defined!"
+#endif // CONFIG_SILENCE_HOLD_TIME
 #ifndef CONFIG_MAX_PITCH
 # error "Configuration macro CONFIG_MAX_PITCH not defined!"
 #endif // CONFIG_MAX_PITCH
@@ -48,6 +54,10 @@
 #ifndef CONFIG_REFILL_STREAMS_PER_RUN
 # error "Configuration macro CONFIG_REFILL_STREAMS_PER_RUN not defined!"
 #endif // CONFIG_REFILL_STREAMS_PER_RUN
+#ifndef CONFIG_DISK_READER_THREADS
+# error "Configuration macro CONFIG_DISK_READER_THREADS not defined!"
+#endif // CONFIG_DISK_READER_THREADS
+
 #ifndef CONFIG_STREAM_MIN_REFILL_SIZE
 # error "Configuration macro CONFIG_STREAM_MIN_REFILL_SIZE not defined!"
 #endif // CONFIG_STREAM_MIN_REFILL_SIZE
@@ -92,6 +102,10 @@
 // sampler engine implementations
 double GLOBAL_VOLUME = CONFIG_GLOBAL_ATTENUATION_DEFAULT;
 
+// this is the sampler global threshold (in dBFS) below which voices are
+// considered inaudible and faded out early by the sampler engines
+double GLOBAL_SILENCE_THRESHOLD = CONFIG_SILENCE_THRESHOLD_DEFAULT;
+
 // this is the sampler global setting for maximum voices
 int GLOBAL_MAX_VOICES = CONFIG_DEFAULT_MAX_VOICES;
 
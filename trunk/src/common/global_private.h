@@ -52,11 +52,18 @@ typedef int16_t sample_t;
 #define GNUC_VERSION_PREREQ(major,minor) (__GNUC__ > (major) || (__GNUC__ == (major) && __GNUC_MINOR__ >= (minor)))
 
 // macro which checks if GCC vector extensions are avialable
-#define HAVE_GCC_VECTOR_EXTENSIONS ( GNUC_VERSION_PREREQ(3,3) && ( defined(__i386__) || defined(__x86_64__) || defined(_ARCH_PPC) ) )
+#define HAVE_GCC_VECTOR_EXTENSIONS ( GNUC_VERSION_PREREQ(3,3) && ( defined(__i386__) || defined(__x86_64__) || defined(_ARCH_PPC) || defined(__aarch64__) || defined(__ARM_NEON__) ) )
 
 #if HAVE_GCC_VECTOR_EXTENSIONS
 // v4sf is used by some routines that make use of GCC vector extensions (ie AudioChannel.cpp)
 typedef float v4sf __attribute__ ((vector_size(16)));
+// same as v4sf, but may be used to access memory which is not 16 byte aligned (ie audio output buffers at arbitrary sample offsets)
+typedef float v4sf_unaligned __attribute__ ((vector_size(16), aligned(4), __may_alias__));
+// allows to access the 4 individual cells of a v4sf vector (ie to gather sample points)
+union v4sf_cells {
+    v4sf  v;
+    float f[4];
+};
 #endif
 
 // circumvents a bug in GCC 4.x which causes a sizeof() expression applied
@@ -127,6 +134,7 @@ class Runnable {
 };
 
 extern double GLOBAL_VOLUME;
+extern double GLOBAL_SILENCE_THRESHOLD;
 extern int GLOBAL_MAX_VOICES;
 extern int GLOBAL_MAX_STREAMS;
 
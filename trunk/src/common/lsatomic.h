@@ -75,6 +75,9 @@
  * - load and store of atomic<int> with relaxed, acquire/release or
  *   seq_cst memory ordering
  *
+ * - fetch_add, fetch_sub, exchange and compare_exchange_strong of atomic<int>
+ *   (always seq_cst)
+ *
  * The supported architectures are x86, powerpc and ARMv7.
  */
 
@@ -201,6 +204,27 @@ namespace LinuxSampler {
                 break;
             }
         }
+
+        // read-modify-write operations are always sequentially consistent
+        int fetch_add(int m, memory_order order = memory_order_seq_cst) volatile {
+            return __sync_fetch_and_add(&f, m);
+        }
+
+        int fetch_sub(int m, memory_order order = memory_order_seq_cst) volatile {
+            return __sync_fetch_and_sub(&f, m);
+        }
+
+        int exchange(int m, memory_order order = memory_order_seq_cst) volatile {
+            __sync_synchronize(); // __sync_lock_test_and_set() is only an acquire barrier
+            return __sync_lock_test_and_set(&f, m);
+        }
+
+        bool compare_exchange_strong(int& expected, int desired, memory_order order = memory_order_seq_cst) volatile {
+            const int previous = __sync_val_compare_and_swap(&f, expected, desired);
+            if (previous == expected) return true;
+            expected = previous;
+            return false;
+        }
     private:
         int f;
         atomic(const atomic&); // not allowed
@@ -25,9 +25,31 @@
 #include "AudioOutputDevice.h"
 #include "../../common/global_private.h"
 #include "../../common/IDGenerator.h"
+#include "../../common/Features.h"
+#include "../../common/RTWorkerPool.h"
+
+// max. amount of engines of one audio device being rendered in parallel at once
+// (there is only one engine per sampler format, so this is plenty), further
+// engines are rendered in further batches
+#define MAX_PARALLEL_ENGINES 16
 
 namespace LinuxSampler {
 
+    // Renders one engine per job.
+    class EngineRenderJob : public RTWorkerPool::Job {
+        public:
+            EngineRenderJob(Engine** ppEngines, int* pResults, uint Samples) :
+                ppEngines(ppEngines), pResults(pResults), Samples(Samples) { }
+
+            virtual void Process(int iJob) OVERRIDE {
+                pResults[iJob] = ppEngines[iJob]->RenderAudio(Samples);
+            }
+        private:
+            Engine** ppEngines;
+            int*     pResults;
+            uint     Samples;
+    };
+
 // *************** ParameterActive ***************
 // *
 
@@ -185,6 +207,14 @@ namespace LinuxSampler {
         : EnginesReader(Engines) {
         this->Parameters = DriverParameters;
         EffectChainIDs = new IDGenerator();
+        pRenderWorkers = NULL;
+        if (CONFIG_RENDER_THREADS > 0) {
+            pRenderWorkers = new RTWorkerPool(CONFIG_RENDER_THREADS);
+            if (!pRenderWorkers->ThreadCount()) { // i.e. single core system
+                delete pRenderWorkers;
+                pRenderWorkers = NULL;
+            }
+        }
     }
 
     AudioOutputDevice::~AudioOutputDevice() {
@@ -219,6 +249,8 @@ namespace LinuxSampler {
         }
         
         delete EffectChainIDs;
+
+        if (pRenderWorkers) delete pRenderWorkers;
     }
 
     void AudioOutputDevice::Connect(Engine* pEngine) {
@@ -226,6 +258,8 @@ namespace LinuxSampler {
         if (engines.find(pEngine) == engines.end()) {
             engines.insert(pEngine);
             Engines.SwitchConfig().insert(pEngine);
+            if (RendersEnginesInParallel() && engines.size() > MAX_PARALLEL_ENGINES)
+                dmsg(1,("AudioOutputDevice: more than %d engines connected, rendering them in several batches\n", MAX_PARALLEL_ENGINES));
             // make sure the engine knows about the connection
             //pEngine->Connect(this);
         }
@@ -335,6 +369,22 @@ namespace LinuxSampler {
     uint AudioOutputDevice::MasterEffectChainCount() const {
         return SendEffectChainCount();
     }
+
+    RTWorkerPool* AudioOutputDevice::RenderWorkers() const {
+        return pRenderWorkers;
+    }
+
+    bool AudioOutputDevice::RendersEnginesInParallel() const {
+        #if CONFIG_PARALLEL_ENGINES
+        return pRenderWorkers;
+        #else
+        return false;
+        #endif
+    }
+
+    Mutex& AudioOutputDevice::SendEffectChainsInputMutex() {
+        return EffectInputMutex;
+    }
     
     float AudioOutputDevice::latency() {
         return float(MaxSamplesPerCycle()) / float(SampleRate());
@@ -343,6 +393,10 @@ namespace LinuxSampler {
     int AudioOutputDevice::RenderAudio(uint Samples) {
         if (Channels.empty()) return 0;
 
+        // this might be a thread of the audio system or of a plugin host,
+        // so flush denormals to zero just while we are rendering here
+        Features::DenormalsAreZeroScope denormalsAreZero;
+
         // reset all channels with silence
         {
             std::vector<AudioChannel*>::iterator iterChannels = Channels.begin();
@@ -368,9 +422,28 @@ namespace LinuxSampler {
         {
             std::set<Engine*>::iterator iterEngine = engines.begin();
             std::set<Engine*>::iterator end        = engines.end();
-            for (; iterEngine != end; iterEngine++) {
-                int res = (*iterEngine)->RenderAudio(Samples);
-                if (res != 0) result = res;
+            if (RendersEnginesInParallel()) {
+                Engine* ppEngines[MAX_PARALLEL_ENGINES];
+                int     results[MAX_PARALLEL_ENGINES];
+                while (iterEngine != end) {
+                    int n = 0;
+                    for (; iterEngine != end && n < MAX_PARALLEL_ENGINES; iterEngine++)
+                        ppEngines[n++] = *iterEngine;
+                    EngineRenderJob job(ppEngines, results, Samples);
+                    pRenderWorkers->Run(&job, n);
+                    for (int i = 0; i < n; i++)
+                        if (results[i] != 0) result = results[i];
+                }
+
+                // all engines are done, so mix their private output channels
+                // to our channels (always in the same order)
+                for (iterEngine = engines.begin(); iterEngine != end; iterEngine++)
+                    (*iterEngine)->MixPrivateOutputChannels(Samples);
+            } else {
+                for (; iterEngine != end; iterEngine++) {
+                    int res = (*iterEngine)->RenderAudio(Samples);
+                    if (res != 0) result = res;
+                }
             }
         }
         #if CONFIG_RT_EXCEPTIONS
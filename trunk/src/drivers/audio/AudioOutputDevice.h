@@ -36,6 +36,7 @@
 #include "../../engines/Engine.h"
 #include "AudioChannel.h"
 #include "../../common/SynchronizedConfig.h"
+#include "../../common/Mutex.h"
 #include "../../effects/EffectChain.h"
 
 namespace LinuxSampler {
@@ -44,6 +45,7 @@ namespace LinuxSampler {
     class Engine;
     class AudioOutputDeviceFactory;
     class IDGenerator;
+    class RTWorkerPool;
 
     /** Abstract base class for audio output drivers in LinuxSampler
      *
@@ -326,6 +328,30 @@ namespace LinuxSampler {
              */
             uint MasterEffectChainCount() const DEPRECATED_API;
 
+            /**
+             * Returns the real-time worker threads which the engines
+             * connected to this audio device may use to render their voices
+             * in parallel, or @c NULL if the voices shall just be rendered
+             * by the audio thread (which is the default).
+             */
+            RTWorkerPool* RenderWorkers() const;
+
+            /**
+             * Returns @c true if the engines connected to this audio device
+             * are rendered in parallel by the RenderWorkers(). In that case
+             * each engine renders into its own private copies of the
+             * device's audio channels, which are mixed to the device's
+             * channels after all engines finished rendering (see
+             * Engine::MixPrivateOutputChannels()).
+             */
+            bool RendersEnginesInParallel() const;
+
+            /**
+             * Has to be locked by engines rendered in parallel while they
+             * are mixing to the input channels of the send effects.
+             */
+            Mutex& SendEffectChainsInputMutex();
+
         protected:
             SynchronizedConfig<std::set<Engine*> >    Engines;     ///< All sampler engines that are connected to the audio output device.
             SynchronizedConfig<std::set<Engine*> >::Reader EnginesReader; ///< Audio thread access to Engines.
@@ -333,6 +359,8 @@ namespace LinuxSampler {
             std::map<String,DeviceCreationParameter*> Parameters;  ///< All device parameters.
             std::vector<EffectChain*>                 vEffectChains;
             IDGenerator*                              EffectChainIDs;
+            RTWorkerPool*                             pRenderWorkers;
+            Mutex                                     EffectInputMutex;
 
             AudioOutputDevice(std::map<String,DeviceCreationParameter*> DriverParameters);
 
@@ -62,6 +62,8 @@ namespace LinuxSampler {
             dmsg(4,("Creating new Engine.\n"));
             pEngine = (AbstractEngine*) EngineFactory::Create(pChannel->EngineName());
             pEngine->CreateInstrumentScriptVM();
+            pEngine->SetPipelined(EngineFactory::Pipelined(pChannel->EngineName()));
+            pEngine->SetSubfragmentSize(EngineFactory::SubfragmentSize(pChannel->EngineName()));
             pEngine->Connect(pDevice);
             engines[pChannel->GetEngineFormat()][pDevice] = pEngine;
         }
@@ -85,9 +87,23 @@ namespace LinuxSampler {
         RandomSeed         = 0;
         pDedicatedVoiceChannelLeft = pDedicatedVoiceChannelRight = NULL;
         pScriptVM          = NULL;
+        RenderLoad         = 0.0f;
+        ReducedQuality     = false;
+        pPipelineThread    = NULL;
+        PipelineBusy       = false;
+        PrivateOutputPending = false;
+        iSubfragmentSize   = CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+        SilenceThreshold   = 0.0f;
+        atomic_set(&CulledVoices, 0);
     }
 
     AbstractEngine::~AbstractEngine() {
+        // FreeEngine() already stopped the pipeline, this is just a safety net
+        if (pPipelineThread) {
+            pPipelineThread->Wait();
+            pPipelineThread->StopThread();
+            delete pPipelineThread;
+        }
         if (pEventQueue) delete pEventQueue;
         if (pEventPool)  delete pEventPool;
         if (pEventGenerator) delete pEventGenerator;
@@ -95,6 +111,7 @@ namespace LinuxSampler {
         if (pSysexBuffer) delete pSysexBuffer;
         if (pDedicatedVoiceChannelLeft) delete pDedicatedVoiceChannelLeft;
         if (pDedicatedVoiceChannelRight) delete pDedicatedVoiceChannelRight;
+        DeletePrivateOutputChannels();
         if (pScriptVM) delete pScriptVM;
         Unregister();
     }
@@ -111,6 +128,11 @@ namespace LinuxSampler {
      * engine instance and if that engine instance is not used by any other
      * engine channel anymore, then that engine instance will be destroyed.
      *
+     * The engine channel has to stop the engine's pipeline with
+     * SetPipelined(false) before it starts tearing down its own data
+     * structures. If the engine is still used by other engine channels,
+     * the pipeline is restarted here.
+     *
      * @param pChannel - engine channel which wants to disconnect from it's
      *                   engine instance
      * @param pDevice  - audio output device \a pChannel was connected to
@@ -126,8 +148,81 @@ namespace LinuxSampler {
             engines[pChannel->GetEngineFormat()].erase(pDevice);
             delete pEngine;
             dmsg(4,("Destroying Engine.\n"));
+        } else {
+            pEngine->SetPipelined(EngineFactory::Pipelined(pChannel->EngineName()));
+            dmsg(4,("This Engine has now %d EngineChannels.\n",pEngine->engineChannels.size()));
         }
-        else dmsg(4,("This Engine has now %d EngineChannels.\n",pEngine->engineChannels.size()));
+    }
+
+    /**
+     * Let this engine proceed to render the given amount of sample points.
+     * The engine will iterate through all engine channels and render audio
+     * for each engine channel independently (see RenderFragment()).
+     *
+     * If the engine is pipelined, the audio fragment has usually already
+     * been rendered by the pipeline thread during the previous audio
+     * fragment cycle, in which case it is just mixed to the audio output
+     * device's channels here, and the pipeline thread is started to render
+     * the next audio fragment in the background. The engine stays in its
+     * critical region (with respect to Disable()) until the pipeline thread
+     * finished, so foreign threads may safely modify the engine as usual
+     * once they disabled it.
+     *
+     *  @param Samples - number of sample points to be rendered
+     *  @returns       0 on success
+     */
+    int AbstractEngine::RenderAudio(uint Samples) {
+        dmsg(8,("RenderAudio(Samples=%d)\n", Samples));
+
+        // finish the audio fragment rendered in the background
+        bool bRendered = false;
+        if (PipelineBusy) {
+            PipelineBusy = false;
+            const uint renderedSamples = pPipelineThread->Wait();
+            if (renderedSamples == Samples) {
+                FlushPrivateOutputChannels(Samples);
+                bRendered = true;
+            } else { // audio fragment size changed, so drop it
+                for (uint i = 0; i < PrivateOutputChannels.size(); ++i)
+                    PrivateOutputChannels[i]->Clear(renderedSamples);
+            }
+            EngineDisabled.RttDone();
+        }
+
+        // return if engine disabled
+        if (EngineDisabled.Pop()) {
+            dmsg(5,("AbstractEngine: engine disabled (val=%d)\n",EngineDisabled.GetUnsafe()));
+            EngineDisabled.RttDone();
+            return 0;
+        }
+
+        if (!pPipelineThread) {
+            RenderFragment(Samples);
+            // if we rendered to private output channels, we stay in our
+            // critical region until they were mixed by MixPrivateOutputChannels()
+            if (!PrivateOutputChannels.empty()) PrivateOutputPending = true;
+            else EngineDisabled.RttDone();
+            return 0;
+        }
+
+        // the pipeline has been (re)started, so render this audio fragment
+        // the old way
+        if (!bRendered) {
+            RenderFragment(Samples);
+            FlushPrivateOutputChannels(Samples);
+        }
+
+        // send effects are processed by the audio thread right after the
+        // engines, so their input channels can't be written in the
+        // background; pause the pipeline while such FX sends exist
+        if (RoutesToSendEffects()) {
+            EngineDisabled.RttDone();
+            return 0;
+        }
+
+        pPipelineThread->Start(Samples);
+        PipelineBusy = true;
+        return 0;
     }
 
     void AbstractEngine::Enable() {
@@ -222,6 +317,157 @@ namespace LinuxSampler {
         pGlobalEvents->clear();
     }
 
+    /**
+     * Returns the audio channel with index @a ChannelIndex the engine shall
+     * render into, that is either the audio output device's channel or the
+     * engine's private copy of it, in case the device renders its engines
+     * in parallel or the engine is pipelined. Returns NULL if index out of
+     * bounds.
+     */
+    AudioChannel* AbstractEngine::OutputChannel(uint ChannelIndex) {
+        if (PrivateOutputChannels.empty())
+            return pAudioOutputDevice->Channel(ChannelIndex);
+        return (ChannelIndex < PrivateOutputChannels.size()) ? PrivateOutputChannels[ChannelIndex] : NULL;
+    }
+
+    /**
+     * (Re)creates the engine's private copies of the audio output device's
+     * channels if the device renders its engines in parallel or if the
+     * engine is pipelined, and updates
+     * the engine channels which render directly into those channels. Must
+     * be called after the engine was (re)connected to an audio output
+     * device.
+     */
+    void AbstractEngine::CreatePrivateOutputChannels() {
+        DeletePrivateOutputChannels();
+        if (pAudioOutputDevice->RendersEnginesInParallel() || Pipelined()) {
+            for (uint i = 0; i < pAudioOutputDevice->ChannelCount(); ++i)
+                PrivateOutputChannels.push_back(new AudioChannel(i, MaxSamplesPerCycle));
+        }
+        for (int i = 0; i < engineChannels.size(); ++i) {
+            AbstractEngineChannel* pChannel = static_cast<AbstractEngineChannel*>(engineChannels[i]);
+            if (!pChannel->fxSends.empty()) continue; // uses local buffers
+            pChannel->pChannelLeft  = OutputChannel(pChannel->AudioDeviceChannelLeft);
+            pChannel->pChannelRight = OutputChannel(pChannel->AudioDeviceChannelRight);
+        }
+    }
+
+    void AbstractEngine::DeletePrivateOutputChannels() {
+        for (int i = 0; i < PrivateOutputChannels.size(); ++i)
+            delete PrivateOutputChannels[i];
+        PrivateOutputChannels.clear();
+    }
+
+    void AbstractEngine::MixPrivateOutputChannels(uint Samples) {
+        if (!PrivateOutputPending) return; // disabled, pipelined or not rendered in parallel
+        PrivateOutputPending = false;
+        FlushPrivateOutputChannels(Samples);
+        EngineDisabled.RttDone(); // leave critical region entered in RenderAudio()
+    }
+
+    /**
+     * Mixes the engine's private output channels to the audio output
+     * device's channels and clears them for the next audio fragment cycle.
+     */
+    void AbstractEngine::FlushPrivateOutputChannels(uint Samples) {
+        for (uint i = 0; i < PrivateOutputChannels.size(); ++i) {
+            AudioChannel* pDst = pAudioOutputDevice->Channel(i);
+            if (pDst) PrivateOutputChannels[i]->MixTo(pDst, Samples);
+            PrivateOutputChannels[i]->Clear(Samples); // for the next audio fragment cycle
+        }
+    }
+
+    /**
+     * Returns true if any FX send of this engine is routed to a send effect
+     * chain of the audio output device.
+     */
+    bool AbstractEngine::RoutesToSendEffects() {
+        for (int i = 0; i < engineChannels.size(); ++i) {
+            AbstractEngineChannel* pChannel = static_cast<AbstractEngineChannel*>(engineChannels[i]);
+            for (int k = 0; k < pChannel->fxSends.size(); ++k)
+                if (pChannel->fxSends[k]->DestinationEffectChain() >= 0) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Enables or disables pipelined rendering of this engine, see
+     * Engine::SetPipelined() for details.
+     *
+     * The pipeline is paused (that is the engine is rendered the usual way)
+     * as long as any of the engine's FX sends is routed to a send effect.
+     */
+    void AbstractEngine::SetPipelined(bool bPipelined) {
+        if (bPipelined == Pipelined()) return;
+        dmsg(2,("AbstractEngine: %s pipelined rendering\n", bPipelined ? "enabling" : "disabling"));
+        DisableAndLock();
+        if (bPipelined) {
+            pPipelineThread = new PipelineThread(this);
+            pPipelineThread->StartThread();
+        } else {
+            // usually RenderAudio() already waited for the last fragment
+            // before it noticed that the engine was disabled
+            pPipelineThread->Wait();
+            PipelineBusy = false;
+            pPipelineThread->StopThread();
+            delete pPipelineThread;
+            pPipelineThread = NULL;
+        }
+        if (pAudioOutputDevice) CreatePrivateOutputChannels();
+        Enable();
+    }
+
+    bool AbstractEngine::Pipelined() {
+        return pPipelineThread;
+    }
+
+    void AbstractEngine::SetSubfragmentSize(int Samples) throw (Exception) {
+        if (Samples < 1 || Samples > MAX_SUBFRAGMENT_SIZE)
+            throw Exception("Subfragment size must be between 1 and " + ToString(MAX_SUBFRAGMENT_SIZE));
+        dmsg(2,("AbstractEngine: subfragment size %d\n", Samples));
+        // only read by the real-time thread when a voice is triggered
+        iSubfragmentSize = Samples;
+    }
+
+    int AbstractEngine::SubfragmentSize() {
+        return iSubfragmentSize;
+    }
+
+    AbstractEngine::PipelineThread::PipelineThread(AbstractEngine* pEngine)
+        : Thread(true, true, 1, -1), pEngine(pEngine), Samples(0)
+    {
+    }
+
+    /**
+     * Called by the audio thread to let the pipeline thread render the next
+     * audio fragment with @a Samples sample points.
+     */
+    void AbstractEngine::PipelineThread::Start(uint Samples) {
+        this->Samples = Samples;
+        Busy.Set(true);
+    }
+
+    /**
+     * Called by the audio thread to wait until the audio fragment requested
+     * with Start() is completely rendered. Returns the fragment's size.
+     */
+    uint AbstractEngine::PipelineThread::Wait() {
+        Busy.WaitAndUnlockIf(true);
+        return Samples;
+    }
+
+    int AbstractEngine::PipelineThread::Main() {
+        while (true) {
+            Busy.WaitAndUnlockIf(false);
+            pEngine->RenderFragment(Samples);
+            Busy.Set(false);
+            #if CONFIG_PTHREAD_TESTCANCEL
+            TestCancel();
+            #endif
+        }
+        return 0;
+    }
+
     /**
      * Will be called in case the respective engine channel sports FX send
      * channels. In this particular case, engine channel local buffers are
@@ -243,8 +489,8 @@ namespace LinuxSampler {
         };
         // route dry signal
         {
-            AudioChannel* pDstL = pAudioOutputDevice->Channel(pChannel->AudioDeviceChannelLeft);
-            AudioChannel* pDstR = pAudioOutputDevice->Channel(pChannel->AudioDeviceChannelRight);
+            AudioChannel* pDstL = OutputChannel(pChannel->AudioDeviceChannelLeft);
+            AudioChannel* pDstR = OutputChannel(pChannel->AudioDeviceChannelRight);
             ppSource[0]->MixTo(pDstL, Samples);
             ppSource[1]->MixTo(pDstR, Samples);
         }
@@ -276,8 +522,8 @@ namespace LinuxSampler {
         };
         // route dry signal
         {
-            AudioChannel* pDstL = pAudioOutputDevice->Channel(pChannel->AudioDeviceChannelLeft);
-            AudioChannel* pDstR = pAudioOutputDevice->Channel(pChannel->AudioDeviceChannelRight);
+            AudioChannel* pDstL = OutputChannel(pChannel->AudioDeviceChannelLeft);
+            AudioChannel* pDstR = OutputChannel(pChannel->AudioDeviceChannelRight);
             ppSource[0]->MixTo(pDstL, Samples);
             ppSource[1]->MixTo(pDstR, Samples);
         }
@@ -337,12 +583,17 @@ namespace LinuxSampler {
                 }
                 pDstChan = pEffect->InputChannel(iDstChan);
             } else { // FX send routed directly to an audio output channel
-                pDstChan = pAudioOutputDevice->Channel(iDstChan);
+                pDstChan = OutputChannel(iDstChan);
             }
             if (!pDstChan) {
                 dmsg(1,("Engine::RouteAudio() Error: invalid FX send (%s) destination channel (%d->%d)", ((iChan) ? "R" : "L"), iChan, iDstChan));
                 return false; // error
             }
+            // the send effects' input channels are shared by all engines of
+            // the audio device, which might be rendered in parallel
+            LockGuard lock =
+                (pFxSend->DestinationEffectChain() >= 0 && !PrivateOutputChannels.empty()) ?
+                    LockGuard(pAudioOutputDevice->SendEffectChainsInputMutex()) : LockGuard();
             ppSource[iChan]->MixTo(pDstChan, Samples, FxSendLevel);
         }
         return true; // success
@@ -394,6 +645,42 @@ namespace LinuxSampler {
         return ActiveVoiceCountMax;
     }
 
+    uint AbstractEngine::CulledVoiceCount() {
+        return atomic_read(&CulledVoices);
+    }
+
+    /**
+     * Should be called at the end of each audio fragment cycle. Measures how
+     * much of the time available for this cycle was needed to render it,
+     * and decides whether the voices should be rendered with reduced quality
+     * in the next cycles to avoid audio dropouts. The load peaks are
+     * followed immediately, whereas a falling load is smoothed, to avoid
+     * toggling between full and reduced quality on each cycle.
+     */
+    void AbstractEngine::UpdateRenderLoad() {
+        if (CONFIG_REDUCED_QUALITY_LOAD <= 0) return; // disabled
+        const float load = pEventGenerator->fragmentLoad();
+        RenderLoad = (load > RenderLoad) ? load : RenderLoad * 0.95f + load * 0.05f;
+        if (!ReducedQuality && RenderLoad > float(CONFIG_REDUCED_QUALITY_LOAD)) {
+            ReducedQuality = true;
+            dmsg(4,("Engine: render load %.2f, reducing voice quality\n", RenderLoad));
+        } else if (ReducedQuality && RenderLoad < float(CONFIG_REDUCED_QUALITY_LOAD) * 0.75f) {
+            ReducedQuality = false;
+            dmsg(4,("Engine: render load %.2f, restoring voice quality\n", RenderLoad));
+        }
+    }
+
+    /**
+     * Updates the smoothed render load of the given engine channel (see
+     * EngineChannel::GetRenderLoad()) with the real time spent for rendering
+     * its voices in the current audio fragment cycle.
+     */
+    void AbstractEngine::UpdateRenderLoad(AbstractEngineChannel* pChannel, RTMath::time_stamp_t Duration) {
+        const float load = pEventGenerator->fragmentRatio(Duration);
+        const float prev = pChannel->GetRenderLoad();
+        pChannel->SetRenderLoad((load > prev) ? load : prev * 0.95f + load * 0.05f);
+    }
+
     /**
      *  Stores the latest pitchbend event as current pitchbend scalar value.
      *
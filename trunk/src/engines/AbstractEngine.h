@@ -29,6 +29,8 @@
 #include "../common/ArrayList.h"
 #include "../common/atomic.h"
 #include "../common/ConditionServer.h"
+#include "../common/Condition.h"
+#include "../common/Thread.h"
 #include "../common/Pool.h"
 #include "../common/RingBuffer.h"
 #include "../common/ChangeFlagRelaxed.h"
@@ -38,6 +40,7 @@
 #include "common/Note.h"
 #include "common/SignalUnitRack.h"
 #include "common/InstrumentScriptVM.h"
+#include "common/VoiceState.h"
 
 namespace LinuxSampler {
 
@@ -55,6 +58,7 @@ namespace LinuxSampler {
             virtual ~AbstractEngine();
 
             // implementation of abstract methods derived from class 'LinuxSampler::Engine'
+            virtual int    RenderAudio(uint Samples) OVERRIDE;
             virtual void   SendSysex(void* pData, uint Size, MidiInputPort* pSender) OVERRIDE;
             virtual void   Reset() OVERRIDE;
             virtual void   Enable() OVERRIDE;
@@ -65,6 +69,12 @@ namespace LinuxSampler {
             virtual void   AdjustScaleTuning(const int8_t ScaleTunes[12]) OVERRIDE;
             virtual void   GetScaleTuning(int8_t* pScaleTunes) OVERRIDE;
             virtual void   ResetScaleTuning() OVERRIDE;
+            virtual void   MixPrivateOutputChannels(uint Samples) OVERRIDE;
+            virtual void   SetPipelined(bool bPipelined) OVERRIDE;
+            virtual bool   Pipelined() OVERRIDE;
+            virtual void   SetSubfragmentSize(int Samples) throw (Exception) OVERRIDE;
+            virtual int    SubfragmentSize() OVERRIDE;
+            virtual uint   CulledVoiceCount() OVERRIDE;
 
             virtual Format GetEngineFormat() = 0;
             virtual void   Connect(AudioOutputDevice* pAudioOut) = 0;
@@ -108,6 +118,9 @@ namespace LinuxSampler {
             //TODO: should be protected
             AudioChannel* pDedicatedVoiceChannelLeft;  ///< encapsulates a special audio rendering buffer (left) for rendering and routing audio on a per voice basis (this is a very special case and only used for voices which lie on a note which was set with individual, dedicated FX send level)
             AudioChannel* pDedicatedVoiceChannelRight; ///< encapsulates a special audio rendering buffer (right) for rendering and routing audio on a per voice basis (this is a very special case and only used for voices which lie on a note which was set with individual, dedicated FX send level)
+            std::vector<AudioChannel*> PrivateOutputChannels; ///< Private copies of the audio output device's channels this engine renders into, if the device renders its engines in parallel or if the engine is pipelined (empty otherwise).
+
+            AudioChannel* OutputChannel(uint ChannelIndex);
 
             friend class AbstractVoice;
             friend class AbstractEngineChannel;
@@ -131,7 +144,19 @@ namespace LinuxSampler {
             atomic_t                   ActiveVoiceCount;      ///< number of currently active voices
             int                        VoiceSpawnsLeft;       ///< We only allow CONFIG_MAX_VOICES voices to be spawned per audio fragment, we use this variable to ensure this limit.
             InstrumentScriptVM*        pScriptVM; ///< Real-time instrument script virtual machine runner for this engine.
-
+            float                      RenderLoad;            ///< Smoothed ratio of the time needed to render an audio fragment to the real time duration of the fragment (see UpdateRenderLoad()).
+            bool                       ReducedQuality;        ///< If true, voices in their release stage and very quiet voices are rendered with linear interpolation and without filter to save CPU time.
+            VoiceState                 VoiceStates;           ///< Hot synthesis state of all voices, indexed by AbstractVoice::Slot.
+            int                        iSubfragmentSize;      ///< Control block size for newly triggered voices (see SetSubfragmentSize()).
+            float                      SilenceThreshold;      ///< Linear output level below which voices are considered inaudible (0 if culling is disabled), updated on each audio fragment from GLOBAL_SILENCE_THRESHOLD.
+            atomic_t                   CulledVoices;          ///< Total number of voices faded out early because they were inaudible.
+
+            void UpdateRenderLoad();
+            void UpdateRenderLoad(AbstractEngineChannel* pChannel, RTMath::time_stamp_t Duration);
+            void CreatePrivateOutputChannels();
+            void DeletePrivateOutputChannels();
+            void FlushPrivateOutputChannels(uint Samples);
+            bool RoutesToSendEffects();
             void RouteAudio(EngineChannel* pEngineChannel, uint Samples);
             void RouteDedicatedVoiceChannels(EngineChannel* pEngineChannel, optional<float> FxSendLevels[2], uint Samples);
             void ClearEventLists();
@@ -146,6 +171,7 @@ namespace LinuxSampler {
 
             uint8_t GSCheckSum(const RingBuffer<uint8_t,false>::NonVolatileReader AddrReader, uint DataSize);
 
+            virtual int  RenderFragment(uint Samples) = 0;
             virtual void ResetInternal() = 0;
             virtual void KillAllVoices(EngineChannel* pEngineChannel, Pool<Event>::Iterator& itKillEvent) = 0;
             virtual void ProcessNoteOn(EngineChannel* pEngineChannel, Pool<Event>::Iterator& itNoteOnEvent) = 0;
@@ -159,7 +185,27 @@ namespace LinuxSampler {
             virtual void CreateInstrumentScriptVM();
 
         private:
+            /**
+             * Renders the engine's next audio fragment in the background
+             * while the audio thread is busy with the current one, if the
+             * engine is pipelined (see SetPipelined()).
+             */
+            class PipelineThread : public Thread {
+                public:
+                    PipelineThread(AbstractEngine* pEngine);
+                    void Start(uint Samples);
+                    uint Wait();
+                    int Main() OVERRIDE;
+                private:
+                    AbstractEngine* pEngine;
+                    Condition       Busy;    ///< True while an audio fragment is rendered.
+                    uint            Samples; ///< Size of the audio fragment to be rendered.
+            };
+
             static std::map<Format, std::map<AudioOutputDevice*,AbstractEngine*> > engines;
+            PipelineThread* pPipelineThread;      ///< Only exists if the engine is pipelined.
+            bool            PipelineBusy;         ///< True while the pipeline thread renders the next audio fragment (only accessed by the audio thread, or by SetPipelined() while the engine is disabled).
+            bool            PrivateOutputPending; ///< True if the private output channels have to be mixed by MixPrivateOutputChannels() (only accessed by the audio thread).
             uint32_t RandomSeed; ///< State of the random number generator used by the random dimension.
 
             static float* InitVolumeCurve();
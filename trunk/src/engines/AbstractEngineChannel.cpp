@@ -48,6 +48,7 @@ namespace LinuxSampler {
         PortamentoMode = false;
         PortamentoTime = CONFIG_PORTAMENTO_TIME_DEFAULT;
         pScript = NULL;
+        VoicesInUse = 0;
     }
 
     AbstractEngineChannel::~AbstractEngineChannel() {
@@ -207,7 +208,7 @@ namespace LinuxSampler {
     void AbstractEngineChannel::SetOutputChannel(uint EngineAudioChannel, uint AudioDeviceChannel) {
         if (!pEngine || !pEngine->pAudioOutputDevice) throw AudioOutputException("No audio output device connected yet.");
 
-        AudioChannel* pChannel = pEngine->pAudioOutputDevice->Channel(AudioDeviceChannel);
+        AudioChannel* pChannel = pEngine->OutputChannel(AudioDeviceChannel);
         if (!pChannel) throw AudioOutputException("Invalid audio output device channel " + ToString(AudioDeviceChannel));
         switch (EngineAudioChannel) {
             case 0: // left output channel
@@ -1072,8 +1073,8 @@ namespace LinuxSampler {
                     if (pChannelRight) delete pChannelRight;
                     // fallback to render directly into AudioOutputDevice's buffers
                     if (pEngine && pEngine->pAudioOutputDevice) {
-                        pChannelLeft  = pEngine->pAudioOutputDevice->Channel(AudioDeviceChannelLeft);
-                        pChannelRight = pEngine->pAudioOutputDevice->Channel(AudioDeviceChannelRight);
+                        pChannelLeft  = pEngine->OutputChannel(AudioDeviceChannelLeft);
+                        pChannelRight = pEngine->OutputChannel(AudioDeviceChannelRight);
                     } else { // we update the pointers later
                         pChannelLeft  = NULL;
                         pChannelRight = NULL;
@@ -1093,14 +1094,14 @@ namespace LinuxSampler {
                 delete pChannelLeft;
                 if (pEngine && pEngine->pAudioOutputDevice) {
                     // fallback to render directly to the AudioOutputDevice's buffer
-                    pChannelLeft = pEngine->pAudioOutputDevice->Channel(AudioDeviceChannelLeft);
+                    pChannelLeft = pEngine->OutputChannel(AudioDeviceChannelLeft);
                 } else pChannelLeft = NULL;
             }
             if (pChannelRight) {
                 delete pChannelRight;
                 if (pEngine && pEngine->pAudioOutputDevice) {
                     // fallback to render directly to the AudioOutputDevice's buffer
-                    pChannelRight = pEngine->pAudioOutputDevice->Channel(AudioDeviceChannelRight);
+                    pChannelRight = pEngine->OutputChannel(AudioDeviceChannelRight);
                 } else pChannelRight = NULL;
             }
         }
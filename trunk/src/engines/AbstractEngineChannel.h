@@ -171,6 +171,7 @@ namespace LinuxSampler {
             int                       iEngineIndexSelf;         ///< Reflects the index of this EngineChannel in the Engine's ArrayList.
             bool                      bStatusChanged;           ///< true in case an engine parameter has changed (e.g. new instrument, another volumet)
             uint32_t                  RoundRobinIndex;          ///< counter for round robin sample selection, incremented for each note on
+            int                       VoicesInUse;              ///< Amount of voices of this channel during event processing of the current audio fragment (active voices plus launched ones, minus the ones killed for voice stealing). Used for admission control of new voices.
             InstrumentScript*         pScript;                  ///< Points to the real-time instrument script(s) to be executed, NULL if current instrument does not have an instrument script. Even though the underlying VM representation of the script is shared among multiple sampler channels, the InstrumentScript object here is not shared though, it exists for each sampler channel separately.
 
             SynchronizedConfig< ArrayList<VirtualMidiDevice*> > virtualMidiDevices;
@@ -27,6 +27,9 @@
 #include "../common/global.h"
 #include "InstrumentManager.h"
 
+/// Upper limit for Engine::SetSubfragmentSize() (in sample points).
+#define MAX_SUBFRAGMENT_SIZE 4096
+
 namespace LinuxSampler {
 
     // just symbol prototyping
@@ -108,6 +111,69 @@ namespace LinuxSampler {
              */
             virtual void ResetScaleTuning() = 0;
 
+            /**
+             * Only used if the audio output device renders its engines in
+             * parallel (see AudioOutputDevice::RendersEnginesInParallel()).
+             * In that case the engine renders into private copies of the
+             * device's audio channels, and this method is called after all
+             * engines of the device finished RenderAudio() to mix the
+             * engine's private channels to the device's channels.
+             *
+             * @param Samples - number of sample points to be mixed
+             */
+            virtual void MixPrivateOutputChannels(uint Samples) = 0;
+
+            /**
+             * Enables or disables pipelined rendering of this engine. A
+             * pipelined engine processes the events (including instrument
+             * scripts) and renders the voices of the next audio fragment on
+             * a separate thread, while the audio thread is busy with the
+             * rest of the current audio fragment cycle. This allows the
+             * engine to use a whole audio fragment period for its work, at
+             * the cost of one audio fragment of additional latency.
+             *
+             * @param bPipelined - true: enable pipelined rendering
+             */
+            virtual void SetPipelined(bool bPipelined) = 0;
+
+            /**
+             * Returns whether pipelined rendering is enabled for this engine.
+             *
+             * @see SetPipelined()
+             */
+            virtual bool Pipelined() = 0;
+
+            /**
+             * Sets the size of the control blocks (subfragments) of this
+             * engine, that is after how many sample points the envelope
+             * generators, LFOs and other modulation sources of the voices are
+             * evaluated again. Larger control blocks save CPU time at the
+             * cost of modulation resolution; pitch and filter cutoff are
+             * interpolated across control blocks larger than the default
+             * size to avoid zipper noise. Only voices triggered after this
+             * call are affected.
+             *
+             * @param Samples - control block size (1 .. MAX_SUBFRAGMENT_SIZE)
+             * @throws Exception - if @a Samples is out of range
+             */
+            virtual void SetSubfragmentSize(int Samples) throw (Exception) = 0;
+
+            /**
+             * Returns the current size of the control blocks (subfragments)
+             * of this engine in sample points.
+             *
+             * @see SetSubfragmentSize()
+             */
+            virtual int SubfragmentSize() = 0;
+
+            /**
+             * Returns the total amount of voices this engine faded out
+             * early since it was created, because their output level stayed
+             * below the sampler's silence threshold for a while (see
+             * GLOBAL_SILENCE_THRESHOLD and CONFIG_SILENCE_HOLD_TIME).
+             */
+            virtual uint CulledVoiceCount() = 0;
+
         protected:
             virtual ~Engine() {}; // MUST only be destroyed by EngineFactory
             void Unregister();    // Remove self from EngineFactory.
@@ -32,11 +32,18 @@
 #include "common/MidiKeyboardManager.h"
 #include "InstrumentManager.h"
 #include "../common/global_private.h"
+#include "../common/RTWorkerPool.h"
 
 // a bit headroom over CONFIG_MAX_VOICES to avoid minor complications i.e. under voice stealing conditions
 #define MAX_NOTES_HEADROOM  3
 #define GLOBAL_MAX_NOTES    (GLOBAL_MAX_VOICES * MAX_NOTES_HEADROOM)
 
+// min. amount of voices rendered together by one voice render thread
+#define VOICE_BATCH_SIZE          8
+// amount of voice batches per voice render thread, more batches than threads
+// balance the load better, since not all voices are equally expensive
+#define VOICE_BATCHES_PER_THREAD  4
+
 namespace LinuxSampler {
 
     class AbstractEngineChannel;
@@ -60,19 +67,25 @@ namespace LinuxSampler {
             
             EngineBase() : noteIDPool(GLOBAL_MAX_NOTES), SuspendedRegions(128) {
                 pDiskThread          = NULL;
+                pRenderWorkers       = NULL;
+                voiceBatchRenderer.pEngine = this;
                 pNotePool            = new Pool< Note<V> >(GLOBAL_MAX_NOTES);
                 pNotePool->setPoolElementIDsReservedBits(INSTR_SCRIPT_EVENT_ID_RESERVED_BITS);
                 pVoicePool           = new Pool<V>(GLOBAL_MAX_VOICES);
                 pRegionPool[0]       = new Pool<R*>(GLOBAL_MAX_VOICES);
                 pRegionPool[1]       = new Pool<R*>(GLOBAL_MAX_VOICES);
                 pVoiceStealingQueue  = new RTList<Event>(pEventPool);
+                bRelaunchingStolenVoices = false;
                 iMaxDiskStreams      = GLOBAL_MAX_STREAMS;
 
                 // init all Voice objects in voice pool
+                VoiceStates.Resize(GLOBAL_MAX_VOICES);
+                int iSlot = 0;
                 for (VoiceIterator iterVoice = pVoicePool->allocAppend();
                      iterVoice; iterVoice = pVoicePool->allocAppend())
                 {
                     iterVoice->SetEngine(this);
+                    iterVoice->Slot = iSlot++;
                 }
                 pVoicePool->clear();
 
@@ -112,31 +125,28 @@ namespace LinuxSampler {
                 if (pRegionPool[0]) delete pRegionPool[0];
                 if (pRegionPool[1]) delete pRegionPool[1];
                 ResetSuspendedRegions();
+
+                DeleteVoiceBatches();
             }
 
             // implementation of abstract methods derived from class 'LinuxSampler::Engine'
 
             /**
-             * Let this engine proceed to render the given amount of sample points.
-             * The engine will iterate through all engine channels and render audio
-             * for each engine channel independently. The calculated audio data of
-             * all voices of each engine channel will be placed into the audio sum
-             * buffers of the respective audio output device, connected to the
-             * respective engine channel.
+             * Render the given amount of sample points. The engine will
+             * iterate through all engine channels and render audio for each
+             * engine channel independently. The calculated audio data of
+             * all voices of each engine channel will be placed into the audio
+             * sum buffers of the respective audio output device (or the
+             * engine's private copies of them), connected to the respective
+             * engine channel.
+             *
+             * Called by RenderAudio() (or by the pipeline thread if the
+             * engine is pipelined) while the engine is enabled.
              *
              *  @param Samples - number of sample points to be rendered
              *  @returns       0 on success
              */
-            virtual int RenderAudio(uint Samples) OVERRIDE {
-                dmsg(8,("RenderAudio(Samples=%d)\n", Samples));
-
-                // return if engine disabled
-                if (EngineDisabled.Pop()) {
-                    dmsg(5,("EngineBase: engine disabled (val=%d)\n",EngineDisabled.GetUnsafe()));
-                    EngineDisabled.RttDone();
-                    return 0;
-                }
-
+            virtual int RenderFragment(uint Samples) OVERRIDE {
                 // process requests for suspending / resuming regions (i.e. to avoid
                 // crashes while these regions are modified by an instrument editor)
                 ProcessSuspensionsChanges();
@@ -172,19 +182,34 @@ namespace LinuxSampler {
                 // all active voices.
                 ProcessScaleTuningChange();
 
-                // reset internal voice counter (just for statistic of active voices)
-                ActiveVoiceCountTemp = 0;
+                // level below which voices are faded out early (a threshold
+                // of -200 dBFS or lower disables this)
+                SilenceThreshold = (GLOBAL_SILENCE_THRESHOLD > -200.0) ?
+                    RTMath::DecibelToLinRatio(GLOBAL_SILENCE_THRESHOLD) : 0.0f;
 
                 HandleInstrumentChanges();
 
+                // recount the voices of all engine channels for admission
+                // control of new voices
+                for (int i = 0; i < engineChannels.size(); i++) {
+                    AbstractEngineChannel* pChannel = static_cast<AbstractEngineChannel*>(engineChannels[i]);
+                    pChannel->VoicesInUse = pChannel->GetVoiceCount();
+                }
+
                 // handle events on all engine channels
                 for (int i = 0; i < engineChannels.size(); i++) {
                     ProcessEvents(engineChannels[i], Samples);
                 }
 
                 // render all 'normal', active voices on all engine channels
-                for (int i = 0; i < engineChannels.size(); i++) {
-                    RenderActiveVoices(engineChannels[i], Samples);
+                // (the voice render threads can't be used by the pipeline
+                // thread, as they are busy with the audio thread's jobs)
+                if (pRenderWorkers && !Pipelined()) {
+                    RenderActiveVoicesInParallel(Samples);
+                } else {
+                    for (int i = 0; i < engineChannels.size(); i++) {
+                        RenderActiveVoices(engineChannels[i], Samples);
+                    }
                 }
 
                 // now that all ordinary voices on ALL engine channels are rendered, render new stolen voices
@@ -226,8 +251,9 @@ namespace LinuxSampler {
                 // reset voice stealing for the next audio fragment
                 pVoiceStealingQueue->clear();
 
-                // just some statistics about this engine instance
-                SetVoiceCount(ActiveVoiceCountTemp);
+                // just some statistics about this engine instance (the voice
+                // pool keeps track of its free voices)
+                SetVoiceCount(pVoicePool->poolSize() - pVoicePool->countFreeElements());
                 if (VoiceCount() > ActiveVoiceCountMax) ActiveVoiceCountMax = VoiceCount();
 
                 // in case regions were previously suspended and we killed voices
@@ -246,7 +272,10 @@ namespace LinuxSampler {
                 }
                 FrameTime += Samples;
 
-                EngineDisabled.RttDone();
+                // decide whether voices have to be rendered with reduced
+                // quality in the next cycles to avoid audio dropouts
+                UpdateRenderLoad();
+
                 return 0;
             }
 
@@ -274,6 +303,7 @@ namespace LinuxSampler {
                 for (int iChannel = 0; iChannel < engineChannels.size(); iChannel++) {
                     EngineChannelBase<V, R, I>* pChannel = static_cast<EngineChannelBase<V, R, I>*>(engineChannels[iChannel]);
                     pChannel->ResetRegionsInUse(pRegionPool);
+                    pChannel->ClearStealOrder(); // its voices are reallocated below
                 }
 
                 // FIXME: Shouldn't all those pool elements be freed before resizing the pools?
@@ -285,11 +315,14 @@ namespace LinuxSampler {
                     throw Exception("FATAL: Could not resize voice pool!");
                 }
 
+                VoiceStates.Resize(iVoices);
+                int iSlot = 0;
                 for (VoiceIterator iterVoice = pVoicePool->allocAppend();
                      iterVoice; iterVoice = pVoicePool->allocAppend())
                 {
                     iterVoice->SetEngine(this);
                     iterVoice->pDiskThread = this->pDiskThread;
+                    iterVoice->Slot = iSlot++;
                 }
                 pVoicePool->clear();
 
@@ -300,6 +333,8 @@ namespace LinuxSampler {
                 }
                 pNotePool->clear();
 
+                if (pRenderWorkers) CreateVoiceBatches();
+
                 PostSetMaxVoices(iVoices);
                 ResumeAll();
             }
@@ -371,6 +406,8 @@ namespace LinuxSampler {
                     pVoicePool->clear();
                     for (VoiceIterator iterVoice = pVoicePool->allocAppend(); iterVoice == pVoicePool->last(); iterVoice = pVoicePool->allocAppend()) {
                         iterVoice->CalculateFadeOutCoeff(minReleaseTime, SampleRate);
+                        // coefficient is valid for the default control block size
+                        iterVoice->SubfragmentSize = CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
                     }
                     pVoicePool->clear();
                 }
@@ -425,6 +462,16 @@ namespace LinuxSampler {
                 if (pDedicatedVoiceChannelRight) delete pDedicatedVoiceChannelRight;
                 pDedicatedVoiceChannelLeft  = new AudioChannel(0, MaxSamplesPerCycle);
                 pDedicatedVoiceChannelRight = new AudioChannel(1, MaxSamplesPerCycle);
+
+                // (re)create private output channels in case the audio device
+                // renders its engines in parallel
+                CreatePrivateOutputChannels();
+
+                // (re)create private voice render buffers in case the audio
+                // device provides voice render threads
+                pRenderWorkers = pAudioOutputDevice->RenderWorkers();
+                if (pRenderWorkers) CreateVoiceBatches();
+                else DeleteVoiceBatches();
             }
         
             // Implementattion for abstract method derived from Engine.
@@ -663,7 +710,6 @@ namespace LinuxSampler {
             int       MinFadeOutSamples;     ///< The number of samples needed to make an instant fade out (e.g. for voice stealing) without leading to clicks.
             D*        pDiskThread;
 
-            int                          ActiveVoiceCountTemp;  ///< number of currently active voices (for internal usage, will be used for incrementation)
             VoiceIterator                itLastStolenVoice;     ///< Only for voice stealing: points to the last voice which was theft in current audio fragment, NULL otherwise.
             NoteIterator                 itLastStolenNote;      ///< Only for voice stealing: points to the last note from which was theft in current audio fragment, NULL otherwise.
             RTList<uint>::Iterator       iuiLastStolenKey;      ///< Only for voice stealing: key number of last key on which the last voice was theft in current audio fragment, NULL otherwise.
@@ -672,9 +718,40 @@ namespace LinuxSampler {
             NoteIterator                 itLastStolenNoteGlobally; ///< Same as itLastStolenNote, but engine globally
             RTList<uint>::Iterator       iuiLastStolenKeyGlobally;  ///< Same as iuiLastStolenKey, but engine globally
             RTList<Event>*               pVoiceStealingQueue;   ///< All voice-launching events which had to be postponed due to free voice shortage.
+            bool                         bRelaunchingStolenVoices; ///< True while RenderStolenVoices() launches the postponed voices, which were already counted in VoicesInUse when their voice was stolen.
             Mutex                        ResetInternalMutex;    ///< Mutex to protect the ResetInternal function for concurrent usage (e.g. by the lscp and instrument loader threads).
             int iMaxDiskStreams;
 
+            /**
+             * Consecutive voices of one engine channel, which are rendered
+             * together by one voice render thread into the batch's private
+             * audio buffers.
+             */
+            struct VoiceBatch {
+                EngineChannelBase<V, R, I>* pChannel;
+                V**                         ppVoices;
+                int                         iVoices;
+                AudioChannel*               pChannelLeft;
+                AudioChannel*               pChannelRight;
+                RTMath::time_stamp_t        Duration; ///< Real time spent for rendering the batch.
+            };
+
+            /// Renders one voice batch per job.
+            class VoiceBatchRenderer : public RTWorkerPool::Job {
+                public:
+                    EngineBase* pEngine;
+                    uint        Samples;
+
+                    virtual void Process(int iJob) OVERRIDE {
+                        pEngine->RenderVoiceBatch(pEngine->voiceBatches[iJob], Samples);
+                    }
+            };
+
+            RTWorkerPool*           pRenderWorkers;     ///< Voice render threads of the audio output device (NULL if voices are rendered by the audio thread alone).
+            std::vector<VoiceBatch> voiceBatches;       ///< Pre-allocated voice batches (only if pRenderWorkers is set).
+            std::vector<V*>         batchVoices;        ///< Voices of all voice batches of the current audio fragment (one entry for each voice of the voice pool).
+            VoiceBatchRenderer      voiceBatchRenderer;
+
             NoteBase* NoteByID(note_id_t id) OVERRIDE {
                 NoteIterator itNote = GetNotePool()->fromID(id);
                 if (!itNote) return NULL;
@@ -1155,9 +1232,12 @@ namespace LinuxSampler {
              *
              *  @param pEngineChannel - engine channel on which this event occurred on
              *  @param itNoteOnEvent - key, velocity and time stamp of the event
+             *  @param bForeignVoices - whether voices of other engine channels
+             *                          may be stolen as well (only those
+             *                          exceeding the channels' reserved voices)
              *  @returns 0 on success, a value < 0 if no active voice could be picked for voice stealing
              */
-            int StealVoice(EngineChannel* pEngineChannel, Pool<Event>::Iterator& itNoteOnEvent) {
+            int StealVoice(EngineChannel* pEngineChannel, Pool<Event>::Iterator& itNoteOnEvent, bool bForeignVoices = true) {
                 dmsg(3,("StealVoice()\n"));
                 if (VoiceSpawnsLeft <= 0) {
                     dmsg(1,("Max. voice thefts per audio fragment reached (you may raise CONFIG_MAX_VOICES).\n"));
@@ -1173,9 +1253,12 @@ namespace LinuxSampler {
 
                 if (!pEngineChn->StealVoice(itNoteOnEvent, &itLastStolenVoice, &itLastStolenNote, &iuiLastStolenKey)) {
                     --VoiceSpawnsLeft;
+                    pEngineChn->VoicesInUse--;
                     return 0;
                 }
 
+                if (!bForeignVoices) return -1;
+
                 // if we couldn't steal a voice from the same engine channel then
                 // steal oldest voice on the oldest key from any other engine channel
                 // (the smaller engine channel number, the higher priority)
@@ -1183,9 +1266,16 @@ namespace LinuxSampler {
                 int                          iChannelIndex;
                 VoiceIterator                itSelectedVoice;
 
-                #if CONFIG_DEVMODE
                 EngineChannel* pBegin = NULL; // to detect endless loop
-                #endif
+
+                // voices reserved for the engine channel we stole from
+                // before must not be stolen, so don't proceed there
+                if (pLastStolenChannel && !HasSpareVoices(pLastStolenChannel)) {
+                    this->itLastStolenVoiceGlobally = VoiceIterator();
+                    this->itLastStolenNoteGlobally  = NoteIterator();
+                    this->iuiLastStolenKeyGlobally  = RTList<uint>::Iterator();
+                    pLastStolenChannel = NULL;
+                }
 
                 // select engine channel
                 if (pLastStolenChannel) {
@@ -1228,14 +1318,14 @@ namespace LinuxSampler {
                     }
                 }
 
-                #if CONFIG_DEVMODE
                 pBegin = pSelectedChannel; // to detect endless loop
-                #endif // CONFIG_DEVMODE
 
                 while (true) { // iterate through engine channels                        
                     // get (next) oldest key
                     RTList<uint>::Iterator iuiSelectedKey = (this->iuiLastStolenKeyGlobally) ? ++this->iuiLastStolenKeyGlobally : pSelectedChannel->pActiveKeys->first();
                     this->iuiLastStolenKeyGlobally = RTList<uint>::Iterator(); // to prevent endless loop (see line above)
+                    // skip engine channels which only use their reserved voices
+                    if (!HasSpareVoices(pSelectedChannel)) iuiSelectedKey = RTList<uint>::Iterator();
                     while (iuiSelectedKey) {
                         MidiKey* pSelectedKey = &pSelectedChannel->pMIDIKeyInfo[*iuiSelectedKey];
 
@@ -1262,14 +1352,12 @@ namespace LinuxSampler {
                     iChannelIndex    = (iChannelIndex + 1) % engineChannels.size();
                     pSelectedChannel = static_cast<EngineChannelBase<V, R, I>*>(engineChannels[iChannelIndex]);
 
-                    #if CONFIG_DEVMODE
+                    // all engine channels visited, which happens if the
+                    // other engine channels only use their reserved voices
                     if (pSelectedChannel == pBegin) {
-                        dmsg(1,("FATAL ERROR: voice stealing endless loop!\n"));
-                        dmsg(1,("VoiceSpawnsLeft=%d.\n", VoiceSpawnsLeft));
-                        dmsg(1,("Exiting.\n"));
-                        exit(-1);
+                        dmsg(2,("No stealable voice on any engine channel (VoiceSpawnsLeft=%d).\n", VoiceSpawnsLeft));
+                        return -1;
                     }
-                    #endif // CONFIG_DEVMODE
                 }
 
                 // jump point if a 'stealable' voice was found
@@ -1284,6 +1372,7 @@ namespace LinuxSampler {
 
                 // now kill the selected voice
                 itSelectedVoice->Kill(itNoteOnEvent);
+                itSelectedVoice->pEngineChannel->VoicesInUse--;
 
                 --VoiceSpawnsLeft;
 
@@ -1380,9 +1469,141 @@ namespace LinuxSampler {
 
                 EngineChannelBase<V, R, I>* pChannel =
                     static_cast<EngineChannelBase<V, R, I>*>(pEngineChannel);
+                const RTMath::time_stamp_t tBegin = RTMath::CreateTimeStamp();
                 pChannel->RenderActiveVoices(Samples);
+                UpdateRenderLoad(pChannel, RTMath::CreateTimeStamp() - tBegin);
+            }
+
+            /**
+             * Render all 'normal' voices on all engine channels, like
+             * RenderActiveVoices() does, but split into batches of voices,
+             * which are rendered in parallel by the voice render threads of
+             * the audio output device (and by the calling audio thread).
+             * Each batch is rendered into private audio buffers, which are
+             * finally mixed to the engine channels' audio channels in a
+             * fixed order, so the result does not depend on which thread
+             * rendered which batch.
+             *
+             * Voices of engine channels with FX sends might be routed
+             * through the engine's dedicated voice channels, so those
+             * engine channels are still rendered by the audio thread.
+             *
+             * @param Samples - number of sample points to be rendered in
+             *                  this audio fragment cycle
+             */
+            void RenderActiveVoicesInParallel(uint Samples) {
+                const int maxBatches = int(voiceBatches.size());
+                const int channels   = engineChannels.size();
+
+                // use larger batches if there are too many voices for the
+                // available batches (based on the voice count of the
+                // previous fragment)
+                int batchSize = VOICE_BATCH_SIZE;
+                if (maxBatches > channels) {
+                    const int n = (VoiceCount() + maxBatches - channels - 1) / (maxBatches - channels);
+                    if (n > batchSize) batchSize = n;
+                }
+
+                int iBatches = 0;
+                int iVoices  = 0;
+                for (int i = 0; i < channels; i++) {
+                    #if !CONFIG_PROCESS_MUTED_CHANNELS
+                    if (engineChannels[i]->GetMute()) continue; // skip if sampler channel is muted
+                    #endif
+
+                    EngineChannelBase<V, R, I>* pChannel =
+                        static_cast<EngineChannelBase<V, R, I>*>(engineChannels[i]);
+                    if (!pChannel->fxSends.empty() || iBatches == maxBatches) {
+                        RenderActiveVoices(pChannel, Samples);
+                        continue;
+                    }
+
+                    const int n = pChannel->CollectActiveVoices(&batchVoices[iVoices], int(batchVoices.size()) - iVoices);
+                    if (!n) {
+                        RenderActiveVoices(pChannel, Samples); // just updates the voice counts
+                        continue;
+                    }
+                    for (int k = 0; k < n; k += batchSize) {
+                        if (iBatches == maxBatches) {
+                            // out of batches, add the rest to the (same
+                            // channel's) last batch
+                            voiceBatches[iBatches - 1].iVoices += n - k;
+                            break;
+                        }
+                        VoiceBatch& batch = voiceBatches[iBatches++];
+                        batch.pChannel = pChannel;
+                        batch.ppVoices = &batchVoices[iVoices + k];
+                        batch.iVoices  = RTMath::Min(batchSize, n - k);
+                    }
+                    iVoices += n;
+                }
+
+                voiceBatchRenderer.Samples = Samples;
+                pRenderWorkers->Run(&voiceBatchRenderer, iBatches);
+
+                // mix the batches to their engine channels, the batches of
+                // one engine channel are consecutive
+                RTMath::time_stamp_t duration = 0;
+                for (int i = 0; i < iBatches; i++) {
+                    VoiceBatch& batch = voiceBatches[i];
+                    batch.pChannelLeft->MixTo(batch.pChannel->pChannelLeft, Samples);
+                    batch.pChannelRight->MixTo(batch.pChannel->pChannelRight, Samples);
+                    duration += batch.Duration;
+                    if (i + 1 == iBatches || voiceBatches[i + 1].pChannel != batch.pChannel) {
+                        UpdateRenderLoad(batch.pChannel, duration);
+                        duration = 0;
+                        batch.pChannel->PostRenderActiveVoices();
+                    }
+                }
+            }
+
+            /**
+             * Renders the voices of the given voice batch into the batch's
+             * private audio buffers. Called by arbitrary voice render
+             * threads.
+             */
+            void RenderVoiceBatch(VoiceBatch& batch, uint Samples) {
+                const RTMath::time_stamp_t tBegin = RTMath::CreateTimeStamp();
+                batch.pChannelLeft->Clear(Samples);
+                batch.pChannelRight->Clear(Samples);
+                for (int i = 0; i < batch.iVoices; i++) {
+                    V* pVoice = batch.ppVoices[i];
+                    pVoice->pTargetChannelLeft  = batch.pChannelLeft;
+                    pVoice->pTargetChannelRight = batch.pChannelRight;
+                    pVoice->Render(Samples);
+                    pVoice->pTargetChannelLeft  = NULL;
+                    pVoice->pTargetChannelRight = NULL;
+                }
+                batch.Duration = RTMath::CreateTimeStamp() - tBegin;
+            }
 
-                ActiveVoiceCountTemp += pEngineChannel->GetVoiceCount();
+            /**
+             * (Re)allocates the voice batches and their private audio
+             * buffers for the current voice pool size, audio fragment size
+             * and amount of voice render threads.
+             */
+            void CreateVoiceBatches() {
+                DeleteVoiceBatches();
+                const int batches = VOICE_BATCHES_PER_THREAD * (pRenderWorkers->ThreadCount() + 1);
+                voiceBatches.resize(batches);
+                for (int i = 0; i < batches; i++) {
+                    voiceBatches[i].pChannel      = NULL;
+                    voiceBatches[i].ppVoices      = NULL;
+                    voiceBatches[i].iVoices       = 0;
+                    voiceBatches[i].Duration      = 0;
+                    voiceBatches[i].pChannelLeft  = new AudioChannel(0, MaxSamplesPerCycle);
+                    voiceBatches[i].pChannelRight = new AudioChannel(1, MaxSamplesPerCycle);
+                }
+                batchVoices.resize(pVoicePool->poolSize());
+            }
+
+            void DeleteVoiceBatches() {
+                for (int i = 0; i < voiceBatches.size(); i++) {
+                    delete voiceBatches[i].pChannelLeft;
+                    delete voiceBatches[i].pChannelRight;
+                }
+                voiceBatches.clear();
+                batchVoices.clear();
             }
 
             /**
@@ -1401,6 +1622,7 @@ namespace LinuxSampler {
             void RenderStolenVoices(uint Samples) {
                 RTList<Event>::Iterator itVoiceStealEvent = pVoiceStealingQueue->first();
                 RTList<Event>::Iterator end               = pVoiceStealingQueue->end();
+                bRelaunchingStolenVoices = true;
                 for (; itVoiceStealEvent != end; ++itVoiceStealEvent) {
                     EngineChannelBase<V, R, I>* pEngineChannel =
                         static_cast<EngineChannelBase<V, R, I>*>(itVoiceStealEvent->pEngineChannel);;
@@ -1426,7 +1648,6 @@ namespace LinuxSampler {
                         itNewVoice->Render(Samples);
                         if (itNewVoice->IsActive()) { // still active
                             *(pEngineChannel->pRegionsInUse->allocAppend()) = itNewVoice->GetRegion();
-                            ActiveVoiceCountTemp++;
                             pEngineChannel->SetVoiceCount(pEngineChannel->GetVoiceCount() + 1);
 
                             if (itNewVoice->PlaybackState == Voice::playback_state_disk) {
@@ -1445,6 +1666,7 @@ namespace LinuxSampler {
                     pKey->VoiceTheftsQueued--;
                     if (!pKey->Active && !pKey->VoiceTheftsQueued) pKey->pEvents->clear();
                 }
+                bRelaunchingStolenVoices = false;
             }
 
             /**
@@ -2232,6 +2454,50 @@ namespace LinuxSampler {
 
             virtual int GetMinFadeOutSamples() OVERRIDE { return MinFadeOutSamples; }
 
+            /**
+             * Admission control: returns whether the given engine channel
+             * may launch a voice in addition to the voices it already uses,
+             * that is whether it neither reached its voice quota, nor
+             * exceeded its CPU budget while using more voices than reserved
+             * for it. Otherwise it may only replace its own voices.
+             */
+            bool MayAddVoice(EngineChannelBase<V, R, I>* pChannel) {
+                const int quota = pChannel->GetVoiceQuota();
+                if (quota > 0 && pChannel->VoicesInUse >= quota) return false;
+                const float budget = pChannel->GetCpuBudget();
+                if (budget > 0.0f && pChannel->GetRenderLoad() > budget &&
+                    pChannel->VoicesInUse >= pChannel->GetReservedVoices()) return false;
+                return true;
+            }
+
+            /**
+             * Admission control: returns whether the given engine channel
+             * may take a free voice of the voice pool, that is whether the
+             * voices still left free afterwards are sufficient for the
+             * reserved voices the other engine channels did not claim yet.
+             * Must be called after the new voice was allocated.
+             */
+            bool MayTakeFreeVoice(EngineChannelBase<V, R, I>* pChannel) {
+                if (pChannel->VoicesInUse < pChannel->GetReservedVoices()) return true;
+                int deficit = 0;
+                for (int i = 0; i < engineChannels.size(); i++) {
+                    AbstractEngineChannel* pOther = static_cast<AbstractEngineChannel*>(engineChannels[i]);
+                    if (pOther == pChannel) continue;
+                    const int n = pOther->GetReservedVoices() - pOther->VoicesInUse;
+                    if (n > 0) deficit += n;
+                }
+                return !deficit || pVoicePool->poolHasFreeElements(deficit);
+            }
+
+            /**
+             * Returns whether other engine channels may steal voices from
+             * the given engine channel, that is whether it uses more voices
+             * than reserved for it.
+             */
+            static bool HasSpareVoices(AbstractEngineChannel* pChannel) {
+                return pChannel->VoicesInUse > pChannel->GetReservedVoices();
+            }
+
             int InitNewVoice (
                 EngineChannelBase<V, R, I>*  pChannel,
                 R*                           pRegion,
@@ -2245,6 +2511,29 @@ namespace LinuxSampler {
             ) {
                 int key = itNoteOnEvent->Param.Note.Key;
                 typename MidiKeyboardManager<V>::MidiKey* pKey = &pChannel->pMIDIKeyInfo[key];
+
+                // admission control (voices relaunched after voice stealing
+                // were admitted when their note-on event arrived)
+                bool bForeignVoices = true;
+                if (VoiceStealing) {
+                    if (!MayAddVoice(pChannel)) {
+                        // voice quota or CPU budget of the engine channel
+                        // exhausted, so only replace one of its own voices
+                        bForeignVoices = false;
+                        if (itNewVoice) {
+                            GetVoicePool()->free(itNewVoice);
+                            itNewVoice = typename Pool<V>::Iterator();
+                        }
+                    } else if (itNewVoice && !MayTakeFreeVoice(pChannel)) {
+                        // the remaining free voices are reserved for other
+                        // engine channels
+                        GetVoicePool()->free(itNewVoice);
+                        itNewVoice = typename Pool<V>::Iterator();
+                    }
+                }
+
+                bool bNewVoiceInUse = false; // whether to count the voice in VoicesInUse
+                int result = -1;
                 if (itNewVoice) {
                     // launch the new voice
                     if (itNewVoice->Trigger(pChannel, itNoteOnEvent, pChannel->Pitch, pRegion, VoiceType, iKeyGroup) < 0) {
@@ -2253,6 +2542,8 @@ namespace LinuxSampler {
                     }
                     else { // on success
                         --VoiceSpawnsLeft;
+                        // relaunched voices were counted when they were stolen
+                        bNewVoiceInUse = !bRelaunchingStolenVoices;
 
                         // should actually be superfluous now, since this is
                         // already done in LaunchNewNote()
@@ -2260,13 +2551,12 @@ namespace LinuxSampler {
 
                         if (itNewVoice->Type & Voice::type_release_trigger_required)
                             pKey->ReleaseTrigger |= itNewVoice->GetReleaseTriggerFlags(); // mark key for the need of release triggered voice(s)
-                        return 0; // success
+                        result = 0; // success
                     }
                 }
                 else if (VoiceStealing) {
                     // try to steal one voice
-                    int result = StealVoice(pChannel, itNoteOnEvent);
-                    if (!result) { // voice stolen successfully
+                    if (!StealVoice(pChannel, itNoteOnEvent, bForeignVoices)) { // voice stolen successfully
                         // put note-on event into voice-stealing queue, so it will be reprocessed after killed voice died
                         RTList<Event>::Iterator itStealEvent = pVoiceStealingQueue->allocAppend();
                         if (itStealEvent) {
@@ -2274,12 +2564,16 @@ namespace LinuxSampler {
                             itStealEvent->Param.Note.Layer = iLayer;
                             itStealEvent->Param.Note.ReleaseTrigger = ReleaseTriggerVoice;
                             pKey->VoiceTheftsQueued++;
+                            // count the postponed voice already, so admission
+                            // control sees it for the rest of this fragment
+                            bNewVoiceInUse = true;
                         }
                         else dmsg(1,("Voice stealing queue full!\n"));
                     }
                 }
 
-                return -1;
+                if (bNewVoiceInUse) pChannel->VoicesInUse++;
+                return result;
             }
             
             /**
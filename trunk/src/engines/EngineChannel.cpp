@@ -29,6 +29,7 @@
 #include "../common/global_private.h"
 #include "../drivers/midi/MidiInstrumentMapper.h"
 #include "../common/atomic.h"
+#include "common/Resampler.h"
 
 #define NO_MIDI_INSTRUMENT_MAP		-1
 #define DEFAULT_MIDI_INSTRUMENT_MAP	-2
@@ -51,6 +52,12 @@ namespace LinuxSampler {
         bool    bMidiRpnReceived;
         bool    bMidiNrpnReceived;
         int     iMidiInstrumentMap;
+        interpolation_t interpolation;
+        voice_steal_algo_t voiceStealAlgo;
+        int voiceQuota;
+        int reservedVoices;
+        float cpuBudget;
+        float renderLoad;
         atomic_t voiceCount;
         atomic_t diskStreamCount;
         SamplerChannel* pSamplerChannel;
@@ -67,6 +74,12 @@ namespace LinuxSampler {
         p->bMidiBankMsbReceived =
         p->bMidiBankLsbReceived = false;
         p->iMidiInstrumentMap = NO_MIDI_INSTRUMENT_MAP;
+        p->interpolation = DEFAULT_INTERPOLATION;
+        p->voiceStealAlgo = CONFIG_VOICE_STEAL_ALGO;
+        p->voiceQuota = 0;
+        p->reservedVoices = 0;
+        p->cpuBudget = 0.0f;
+        p->renderLoad = 0.0f;
         SetVoiceCount(0);
         SetDiskStreamCount(0);
         p->pSamplerChannel = NULL;
@@ -118,6 +131,62 @@ namespace LinuxSampler {
         return p->bSolo;
     }
 
+    void EngineChannel::SetInterpolation(interpolation_t algorithm) {
+        if (p->interpolation == algorithm) return;
+        p->interpolation = algorithm;
+        StatusChanged(true);
+    }
+
+    interpolation_t EngineChannel::GetInterpolation() {
+        return p->interpolation;
+    }
+
+    void EngineChannel::SetVoiceStealAlgorithm(voice_steal_algo_t algorithm) {
+        if (p->voiceStealAlgo == algorithm) return;
+        p->voiceStealAlgo = algorithm;
+        StatusChanged(true);
+    }
+
+    voice_steal_algo_t EngineChannel::GetVoiceStealAlgorithm() {
+        return p->voiceStealAlgo;
+    }
+
+    void EngineChannel::SetVoiceQuota(int Voices) throw (Exception) {
+        if (p->voiceQuota == Voices) return;
+        if (Voices < 0)
+            throw Exception("Invalid voice quota: " + ToString(Voices));
+        p->voiceQuota = Voices;
+        StatusChanged(true);
+    }
+
+    int EngineChannel::GetVoiceQuota() {
+        return p->voiceQuota;
+    }
+
+    void EngineChannel::SetReservedVoices(int Voices) throw (Exception) {
+        if (p->reservedVoices == Voices) return;
+        if (Voices < 0)
+            throw Exception("Invalid amount of reserved voices: " + ToString(Voices));
+        p->reservedVoices = Voices;
+        StatusChanged(true);
+    }
+
+    int EngineChannel::GetReservedVoices() {
+        return p->reservedVoices;
+    }
+
+    void EngineChannel::SetCpuBudget(float Budget) throw (Exception) {
+        if (p->cpuBudget == Budget) return;
+        if (Budget < 0.0f)
+            throw Exception("Invalid CPU budget: " + ToString(Budget));
+        p->cpuBudget = Budget;
+        StatusChanged(true);
+    }
+
+    float EngineChannel::GetCpuBudget() {
+        return p->cpuBudget;
+    }
+
     /*
        We use a workaround for MIDI devices (i.e. old keyboards) which either
        only send bank select MSB or only bank select LSB messages. Bank
@@ -274,6 +343,14 @@ namespace LinuxSampler {
         atomic_set(&p->voiceCount, Voices);
     }
 
+    float EngineChannel::GetRenderLoad() {
+        return p->renderLoad;
+    }
+
+    void EngineChannel::SetRenderLoad(float Load) {
+        p->renderLoad = Load;
+    }
+
     uint EngineChannel::GetDiskStreamCount() {
         return atomic_read(&p->diskStreamCount);
     }
@@ -39,6 +39,33 @@ namespace LinuxSampler {
     class MidiInputPort;
     class FxSend;
 
+    /**
+     * Interpolation algorithms which may be used by the sampler engines for
+     * resampling (pitching) the audio signal of their voices. They differ in
+     * audio quality and CPU load.
+     */
+    enum interpolation_t {
+        interpolation_linear, ///< 2-point linear interpolation (fastest, but audible aliasing when pitching).
+        interpolation_cubic,  ///< 4-point, 3rd order Hermite interpolation (good compromise between quality and CPU load).
+        interpolation_sinc    ///< Polyphase windowed sinc interpolation (best quality, highest CPU load).
+    };
+
+    /** @brief Voice Stealing Algorithms
+     *
+     * Enumeration of all possible voice stealing algorithms, that is how
+     * the sampler engines select the voice to be killed if a new voice has
+     * to be launched on a sampler channel while all voices are in use. If a
+     * channel has no stealable voice left, a voice of another channel of
+     * the same engine is stolen.
+     */
+    enum voice_steal_algo_t {
+        voice_steal_algo_none,              ///< Voice stealing disabled.
+        voice_steal_algo_oldestvoiceonkey,  ///< Try to kill the oldest voice from same key where the new voice should be spawned.
+        voice_steal_algo_oldestkey,         ///< Try to kill the oldest voice from the oldest active key.
+        voice_steal_algo_quietest,          ///< Kill the voice with the lowest current output level (compared in steps of 6 dB).
+        voice_steal_algo_oldestreleased     ///< Kill the voice which entered its release stage first, if there is no released voice proceed like voice_steal_algo_oldestvoiceonkey.
+    };
+
 
     /** @brief Channel Interface for LinuxSampler Sampler Engines
      *
@@ -160,6 +187,92 @@ namespace LinuxSampler {
              */
             bool GetSolo();
 
+            /**
+             * Sets the interpolation algorithm to be used for resampling
+             * (pitching) the audio signal of voices on this channel. The
+             * new algorithm will be used by voices triggered after this
+             * call, voices already playing keep their algorithm.
+             *
+             * @param algorithm - interpolation algorithm to be used
+             */
+            void SetInterpolation(interpolation_t algorithm);
+
+            /**
+             * Returns the interpolation algorithm currently used for
+             * resampling (pitching) the audio signal of voices on this
+             * channel.
+             */
+            interpolation_t GetInterpolation();
+
+            /**
+             * Sets the algorithm used to select the voice to be stolen if
+             * a new voice has to be launched on this channel while all
+             * voices of the engine are in use. The default algorithm is
+             * defined at compile time by CONFIG_VOICE_STEAL_ALGO.
+             *
+             * @param algorithm - voice stealing algorithm to be used
+             */
+            void SetVoiceStealAlgorithm(voice_steal_algo_t algorithm);
+
+            /**
+             * Returns the voice stealing algorithm currently used on this
+             * channel.
+             */
+            voice_steal_algo_t GetVoiceStealAlgorithm();
+
+            /**
+             * Limits the amount of voices this channel may use at the same
+             * time. If the limit is reached, new voices of this channel
+             * replace (steal) older voices of this channel instead of
+             * taking free voices of the engine.
+             *
+             * @param Voices - max. amount of voices (0: unlimited)
+             * @throws Exception - if @a Voices is negative
+             */
+            void SetVoiceQuota(int Voices) throw (Exception);
+
+            /**
+             * Returns the max. amount of voices this channel may use at the
+             * same time, 0 if unlimited.
+             */
+            int GetVoiceQuota();
+
+            /**
+             * Reserves the given amount of voices of the engine for this
+             * channel. Other channels on the same engine neither steal
+             * voices from this channel as long as it does not use more than
+             * its reserved voices, nor do they take the last free voices
+             * of the engine which this channel still has to claim.
+             *
+             * @param Voices - amount of reserved voices (0: none)
+             * @throws Exception - if @a Voices is negative
+             */
+            void SetReservedVoices(int Voices) throw (Exception);
+
+            /**
+             * Returns the amount of voices reserved for this channel.
+             */
+            int GetReservedVoices();
+
+            /**
+             * Limits the CPU time this channel may spend for rendering its
+             * voices. If the channel's render load (see GetRenderLoad())
+             * exceeds the budget, new voices of this channel replace
+             * (steal) older voices of this channel instead of taking free
+             * voices of the engine, unless the channel uses less voices
+             * than reserved for it.
+             *
+             * @param Budget - max. render load as ratio of the audio
+             *                 fragment period (0: unlimited)
+             * @throws Exception - if @a Budget is negative
+             */
+            void SetCpuBudget(float Budget) throw (Exception);
+
+            /**
+             * Returns the CPU budget of this channel, 0 if unlimited.
+             */
+            float GetCpuBudget();
+
             /**
              * Returns current MIDI program (change) number of this
              * EngineChannel.
@@ -349,6 +462,17 @@ namespace LinuxSampler {
              */
             void SetVoiceCount(uint Voices);
 
+            /**
+             * Gets the (smoothed) time recently spent for rendering the
+             * voices of this channel, as ratio of the audio fragment period.
+             */
+            float GetRenderLoad();
+
+            /**
+             * Sets the current render load of this channel.
+             */
+            void SetRenderLoad(float Load);
+
             /**
              * Gets the current number of active disk streams.
              */
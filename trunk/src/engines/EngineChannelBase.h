@@ -191,8 +191,8 @@ namespace LinuxSampler {
                 AudioDeviceChannelLeft  = 0;
                 AudioDeviceChannelRight = 1;
                 if (fxSends.empty()) { // render directly into the AudioDevice's output buffers
-                    pChannelLeft  = pAudioOut->Channel(AudioDeviceChannelLeft);
-                    pChannelRight = pAudioOut->Channel(AudioDeviceChannelRight);
+                    pChannelLeft  = pEngine->OutputChannel(AudioDeviceChannelLeft);
+                    pChannelRight = pEngine->OutputChannel(AudioDeviceChannelRight);
                 } else { // use local buffers for rendering and copy later
                     // ensure the local buffers have the correct size
                     if (pChannelLeft)  delete pChannelLeft;
@@ -207,6 +207,11 @@ namespace LinuxSampler {
             virtual void DisconnectAudioOutputDevice() OVERRIDE {
                 if (pEngine) { // if clause to prevent disconnect loops
 
+                    // the pipeline thread might still render this engine
+                    // channel, so drain and stop it before tearing anything
+                    // down (FreeEngine() restarts it if the engine survives)
+                    pEngine->SetPipelined(false);
+
                     ResetInternal(false/*don't reset engine*/); // 'false' is error prone here, but the danger of recursion with 'true' would be worse, there could be a better solution though
 
                     DeleteRegionsInUse();
@@ -320,7 +325,35 @@ namespace LinuxSampler {
             }
 
             void RenderActiveVoices(uint Samples) {
-                RenderVoicesHandler handler(this, Samples);
+                RenderVoicesHandler handler(this, Samples, true);
+                this->ProcessActiveVoices(&handler);
+
+                SetVoiceCount(handler.VoiceCount);
+                SetDiskStreamCount(handler.StreamCount);
+            }
+
+            /**
+             * Stores pointers to all active voices of this engine channel
+             * to @a ppVoices, in the same order RenderActiveVoices() would
+             * render them.
+             *
+             * @param ppVoices - destination array
+             * @param iMax     - size of @a ppVoices
+             * @returns amount of voices stored to @a ppVoices
+             */
+            int CollectActiveVoices(V** ppVoices, int iMax) {
+                CollectVoicesHandler handler(ppVoices, iMax);
+                this->ProcessActiveVoices(&handler);
+                return handler.VoiceCount;
+            }
+
+            /**
+             * Does everything RenderActiveVoices() does, except of actually
+             * rendering the voices. To be called after the voices collected
+             * by CollectActiveVoices() were rendered by voice render threads.
+             */
+            void PostRenderActiveVoices() {
+                RenderVoicesHandler handler(this, 0, false);
                 this->ProcessActiveVoices(&handler);
 
                 SetVoiceCount(handler.VoiceCount);
@@ -481,18 +514,20 @@ namespace LinuxSampler {
                     uint VoiceCount;
                     uint StreamCount;
                     EngineChannelBase<V, R, I>* pChannel;
+                    bool bRender; ///< false if the voices were already rendered by voice render threads
 
-                    RenderVoicesHandler(EngineChannelBase<V, R, I>* channel, uint samples) :
-                        Samples(samples), VoiceCount(0), StreamCount(0), pChannel(channel) { }
+                    RenderVoicesHandler(EngineChannelBase<V, R, I>* channel, uint samples, bool render) :
+                        Samples(samples), VoiceCount(0), StreamCount(0), pChannel(channel), bRender(render) { }
 
                     virtual void Process(RTListVoiceIterator& itVoice) {
                         // now render current voice
-                        itVoice->Render(Samples);
+                        if (bRender) itVoice->Render(Samples);
                         if (itVoice->IsActive()) { // still active
                             if (!itVoice->Orphan) {
                                 *(pChannel->pRegionsInUse->allocAppend()) = itVoice->GetRegion();
                             }
                             VoiceCount++;
+                            pChannel->UpdateStealOrder(&*itVoice);
 
                             if (itVoice->PlaybackState == Voice::playback_state_disk) {
                                 if ((itVoice->DiskStreamRef).State != Stream::state_unused) StreamCount++;
@@ -504,6 +539,20 @@ namespace LinuxSampler {
                     }
             };
 
+            class CollectVoicesHandler : public MidiKeyboardManager<V>::VoiceHandlerBase {
+                public:
+                    V** ppVoices;
+                    int iMax;
+                    int VoiceCount;
+
+                    CollectVoicesHandler(V** voices, int max) :
+                        ppVoices(voices), iMax(max), VoiceCount(0) { }
+
+                    virtual void Process(RTListVoiceIterator& itVoice) {
+                        if (VoiceCount < iMax) ppVoices[VoiceCount++] = &*itVoice;
+                    }
+            };
+
             typedef typename SynchronizedConfig<InstrumentChangeCmd<R, I> >::Reader SyncConfInstrChangeCmdReader;
 
             SynchronizedConfig<InstrumentChangeCmd<R, I> > InstrumentChangeCommand;
@@ -20,6 +20,7 @@
 
 #include "EngineFactory.h"
 
+#include <map>
 #include <strings.h>
 
 #include "gig/Engine.h"
@@ -30,13 +31,34 @@
 
 #include "sfz/Engine.h"
 
-#include "../common/global.h"
+#include "../common/global_private.h"
 
 namespace LinuxSampler {
 
     // all currently existing engine instances
     static std::set<LinuxSampler::Engine*> engines;
 
+    // engine types (as returned by Engine::EngineName()) which shall be pipelined
+    static std::set<String> pipelinedEngineTypes;
+
+    // subfragment sizes of those engine types which don't use the default size
+    static std::map<String,int> engineTypeSubfragmentSizes;
+
+    // returns the engine type name as returned by Engine::EngineName()
+    static String engineTypeName(String EngineType) throw (Exception) {
+        if (!strcasecmp(EngineType.c_str(),"GigEngine") || !strcasecmp(EngineType.c_str(),"gig"))
+            return "GIG";
+        else if (!strcasecmp(EngineType.c_str(),"sf2")) {
+        #if HAVE_SF2
+            return "SF2";
+        #else
+            throw Exception("LinuxSampler is not compiled with SF2 support");
+        #endif
+        } else if (!strcasecmp(EngineType.c_str(),"sfz"))
+            return "SFZ";
+        throw Exception("Unknown engine type");
+    }
+
     std::vector<String> EngineFactory::AvailableEngineTypes() {
         std::vector<String> result;
         result.push_back("GIG");
@@ -92,4 +114,49 @@ namespace LinuxSampler {
         return engines;
     }
 
+    /**
+     * Enables or disables pipelined rendering (see Engine::SetPipelined())
+     * for all current and future engine instances of the given engine type.
+     */
+    void EngineFactory::SetPipelined(String EngineType, bool bPipelined) throw (Exception) {
+        const String type = engineTypeName(EngineType);
+        if (bPipelined) pipelinedEngineTypes.insert(type);
+        else pipelinedEngineTypes.erase(type);
+        std::set<LinuxSampler::Engine*>::iterator iter = engines.begin();
+        for (; iter != engines.end(); ++iter)
+            if ((*iter)->EngineName() == type) (*iter)->SetPipelined(bPipelined);
+    }
+
+    /**
+     * Returns whether engine instances of the given engine type are
+     * pipelined.
+     */
+    bool EngineFactory::Pipelined(String EngineType) throw (Exception) {
+        return pipelinedEngineTypes.count(engineTypeName(EngineType));
+    }
+
+    /**
+     * Sets the subfragment size (see Engine::SetSubfragmentSize()) for all
+     * current and future engine instances of the given engine type.
+     */
+    void EngineFactory::SetSubfragmentSize(String EngineType, int Samples) throw (Exception) {
+        const String type = engineTypeName(EngineType);
+        if (Samples < 1 || Samples > MAX_SUBFRAGMENT_SIZE)
+            throw Exception("Subfragment size must be between 1 and " + ToString(MAX_SUBFRAGMENT_SIZE));
+        engineTypeSubfragmentSizes[type] = Samples;
+        std::set<LinuxSampler::Engine*>::iterator iter = engines.begin();
+        for (; iter != engines.end(); ++iter)
+            if ((*iter)->EngineName() == type) (*iter)->SetSubfragmentSize(Samples);
+    }
+
+    /**
+     * Returns the subfragment size of engine instances of the given engine
+     * type.
+     */
+    int EngineFactory::SubfragmentSize(String EngineType) throw (Exception) {
+        std::map<String,int>::iterator iter =
+            engineTypeSubfragmentSizes.find(engineTypeName(EngineType));
+        return (iter != engineTypeSubfragmentSizes.end()) ? iter->second : CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+    }
+
 } // namespace LinuxSampler
@@ -37,6 +37,10 @@ namespace LinuxSampler {
             static Engine* Create(String EngineType) throw (Exception);
             static void Destroy(Engine* pEngine);
             static const std::set<Engine*>& EngineInstances();
+            static void SetPipelined(String EngineType, bool bPipelined) throw (Exception);
+            static bool Pipelined(String EngineType) throw (Exception);
+            static void SetSubfragmentSize(String EngineType, int Samples) throw (Exception);
+            static int SubfragmentSize(String EngineType) throw (Exception);
         protected:
             static void Erase(Engine* pEngine);
             friend class Engine;
@@ -30,6 +30,7 @@
 #include "../drivers/audio/AudioOutputDeviceFactory.h"
 #include "AbstractEngine.h"
 #include "AbstractEngineChannel.h"
+#include "common/Resampler.h"
 
 // We need to know the maximum number of sample points which are going to
 // be processed for each render cycle of the audio output driver, to know
@@ -204,13 +205,16 @@ namespace LinuxSampler {
                 }
                 if (!pSample->GetTotalFrameCount()) return; // skip zero size samples
 
-                if (pSample->GetTotalFrameCount() <= CONFIG_PRELOAD_SAMPLES) {
+                const uint preloadSamples = GetPreloadSamples(pSample, maxSamplesPerCycle);
+                if (pSample->GetTotalFrameCount() <= CONFIG_PRELOAD_SAMPLES ||
+                    pSample->GetTotalFrameCount() <= preloadSamples)
+                {
                     // Sample is too short for disk streaming, so we load the whole
                     // sample into RAM and place 'pAudioIO->FragmentSize << CONFIG_MAX_PITCH'
                     // number of '0' samples (silence samples) behind the official buffer
                     // border, to allow the interpolator do it's work even at the end of
                     // the sample.
-                    const uint neededSilenceSamples = uint((maxSamplesPerCycle << CONFIG_MAX_PITCH) + 3);
+                    const uint neededSilenceSamples = uint((maxSamplesPerCycle << CONFIG_MAX_PITCH) + MAX_INTERPOLATION_READ_AHEAD);
                     const uint currentlyCachedSilenceSamples = uint(pSample->GetCache().NullExtensionSize / pSample->GetFrameSize());
                     if (currentlyCachedSilenceSamples < neededSilenceSamples) {
                         dmsg(3,("Caching whole sample (sample name: \"%s\", sample size: %ld)\n", pSample->GetName().c_str(), pSample->GetTotalFrameCount()));
@@ -218,13 +222,22 @@ namespace LinuxSampler {
                         dmsg(4,("Cached %lu Bytes, %lu silence bytes.\n", buf.Size, buf.NullExtensionSize));
                     }
                 }
-                else { // we only cache CONFIG_PRELOAD_SAMPLES and stream the other sample points from disk
-                    if (!pSample->GetCache().Size) pSample->LoadSampleData(CONFIG_PRELOAD_SAMPLES);
+                else { // we only cache preloadSamples and stream the other sample points from disk
+                    if (!pSample->GetCache().Size) pSample->LoadSampleData(preloadSamples);
                 }
 
                 if (!pSample->GetCache().Size) std::cerr << "Unable to cache sample - maybe memory full!" << std::endl << std::flush;
             }
 
+            /**
+             * Returns the amount of sample points to be cached in RAM at the
+             * beginning of the given disk streamed sample (see
+             * CacheInitialSamples() and DiskLatency::PreloadSamples()).
+             */
+            virtual uint GetPreloadSamples(S* pSample, uint maxSamplesPerCycle) {
+                return CONFIG_PRELOAD_SAMPLES;
+            }
+
             // implementation of derived abstract methods from 'InstrumentManager'
             std::vector<instrument_id_t> Instruments() OVERRIDE {
                 return ResourceManager<InstrumentManager::instrument_id_t, I>::Entries();
@@ -24,19 +24,45 @@
  ***************************************************************************/
 
 #include "AbstractVoice.h"
+#include "../../common/Features.h"
+
+// volume level (linear, after envelopes and LFOs, before panning) below which
+// a voice is considered to be inaudible, and thus may be rendered with reduced
+// quality when the engine is under high CPU load (-40 dB)
+#define REDUCED_QUALITY_VOLUME  0.01f
+
+// maximum number of subfragments for which the envelope generators and LFOs
+// are rendered at once (see AbstractVoice::Synthesize())
+#define CONTROL_BLOCK_SIZE      16
 
 namespace LinuxSampler {
 
+    /**
+     * Returns the number of subfragments, starting with the current one at
+     * sample point \a i, which are rendered before the subfragment which
+     * processes the event at sample point \a Pos (which has to be after the
+     * end of the current subfragment).
+     */
+    static inline uint SubfragmentsBefore(uint Pos, uint i, uint SubfragmentSize) {
+        return (Pos - i - 1) / SubfragmentSize;
+    }
+
     AbstractVoice::AbstractVoice(SignalUnitRack* pRack): pSignalUnitRack(pRack) {
         pEngineChannel = NULL;
+        Slot = 0;
+        SubfragmentSize = CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
         pLFO1 = new LFOUnsigned(1.0f);  // amplitude LFO (0..1 range)
         pLFO2 = new LFOUnsigned(1.0f);  // filter LFO (0..1 range)
         pLFO3 = new LFOSigned(1200.0f); // pitch LFO (-1200..+1200 range)
         PlaybackState = playback_state_end;
         SynthesisMode = 0; // set all mode bits to 0 first
-        // select synthesis implementation (asm core is not supported ATM)
-        #if 0 // CONFIG_ASM && ARCH_X86
-        SYNTHESIS_MODE_SET_IMPLEMENTATION(SynthesisMode, Features::supportsMMX() && Features::supportsSSE());
+        // select synthesis implementation (SIMD or pure scalar C++ core)
+        #if HAVE_GCC_VECTOR_EXTENSIONS
+        # if CONFIG_ASM && ARCH_X86
+        SYNTHESIS_MODE_SET_IMPLEMENTATION(SynthesisMode, Features::supportsSSE2());
+        # else
+        SYNTHESIS_MODE_SET_IMPLEMENTATION(SynthesisMode, true);
+        # endif
         #else
         SYNTHESIS_MODE_SET_IMPLEMENTATION(SynthesisMode, false);
         #endif
@@ -47,6 +73,18 @@ namespace LinuxSampler {
         
         pEq          = NULL;
         bEqSupport   = false;
+
+        pUnrolledLoop = NULL;
+        bReleased     = false;
+        ReleaseTime   = 0;
+        SilentSamples = 0;
+        bFadingOut    = false;
+        pStealPrev    = NULL;
+        pStealNext    = NULL;
+        StealBucket   = -1;
+
+        pTargetChannelLeft  = NULL;
+        pTargetChannelRight = NULL;
     }
 
     AbstractVoice::~AbstractVoice() {
@@ -118,6 +156,23 @@ namespace LinuxSampler {
         itKillEvent     = Pool<Event>::Iterator();
         MidiKeyBase* pKeyInfo = GetMidiKeyInfo(MIDIKey());
 
+        // adopt the engine's current control block size for the whole life
+        // time of this voice; the fade out coefficient is defined in steps
+        // per control block, so it has to be recalculated on changes to
+        // keep the minimum fade out time
+        if (SubfragmentSize != GetEngine()->SubfragmentSize()) {
+            SubfragmentSize = GetEngine()->SubfragmentSize();
+            CalculateFadeOutCoeff(
+                float(GetEngine()->GetMinFadeOutSamples()) / float(GetEngine()->SampleRate) *
+                CONFIG_DEFAULT_SUBFRAGMENT_SIZE / SubfragmentSize,
+                GetEngine()->SampleRate
+            );
+        }
+
+        // no pitch and cutoff to interpolate from in the first control block
+        GetEngine()->VoiceStates.Pitch[Slot]  = 0;
+        GetEngine()->VoiceStates.Cutoff[Slot] = 0;
+
         pGroupEvents = iKeyGroup ? pEngineChannel->ActiveKeyGroups[iKeyGroup] : 0;
 
         SmplInfo   = GetSampleInfo();
@@ -135,8 +190,20 @@ namespace LinuxSampler {
 
         // select channel mode (mono or stereo)
         SYNTHESIS_MODE_SET_CHANNELS(SynthesisMode, SmplInfo.ChannelCount == 2);
-        // select bit depth (16 or 24)
+        // select bit depth (16, packed 24 or 32, see CONFIG_32BIT_SAMPLES)
         SYNTHESIS_MODE_SET_BITDEPTH24(SynthesisMode, SmplInfo.BitDepth == 24);
+        SYNTHESIS_MODE_SET_BITDEPTH32(SynthesisMode, SmplInfo.BitDepth == 32);
+        // select interpolation algorithm (used for the whole life time of this voice)
+        Interpolation = finalSynthesisParameters.Interpolation = pEngineChannel->GetInterpolation();
+        bReleased = Type & Voice::type_release_trigger;
+        ReleaseTime = GetEngine()->FrameTime;
+        SilentSamples = 0;
+        bFadingOut = false;
+        // not in the victim order yet (its engine channel might have
+        // dropped the order without unlinking the voice, see
+        // MidiKeyboardManager::StealOrder::Reset())
+        pStealPrev = pStealNext = NULL;
+        StealBucket = -1;
 
         // get starting crossfade volume level
         float crossfadeVolume = CalculateCrossfadeVolume(MIDIVelocity());
@@ -145,7 +212,7 @@ namespace LinuxSampler {
         VolumeRight = volume * pKeyInfo->PanRight;
 
         // this rate is used for rather mellow volume fades
-        const float subfragmentRate = GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+        const float subfragmentRate = GetSubfragmentRate();
         // this rate is used for very fast volume fades
         const float quickRampRate = RTMath::Min(subfragmentRate, GetEngine()->SampleRate * 0.001f /* approx. 13ms */);
         CrossfadeSmoother.trigger(crossfadeVolume, subfragmentRate);
@@ -192,6 +259,16 @@ namespace LinuxSampler {
             loop.uiSize        = SmplInfo.LoopLength;
         }
 
+        // play endless loops of completely cached samples from the unrolled
+        // loop (if any), so the loop has to be wrapped less often
+        pUnrolledLoop = (RAMLoop && !DiskVoice && !loop.uiTotalCycles) ? GetUnrolledLoop() : NULL;
+        if (pUnrolledLoop && pUnrolledLoop->GetLoopStart() == loop.uiStart) {
+            loop.uiEnd  = pUnrolledLoop->GetLoopEnd();
+            loop.uiSize = pUnrolledLoop->GetLoopSize();
+        } else {
+            pUnrolledLoop = NULL;
+        }
+
         Pitch = CalculatePitchInfo(PitchBend);
         NotePitch.setCurveOnly(pNote ? pNote->Override.PitchCurve : DEFAULT_FADE_CURVE);
         NotePitch.setCurrentValue(pNote ? pNote->Override.Pitch : 1.0f);
@@ -241,8 +318,8 @@ namespace LinuxSampler {
         // setup initial volume in synthesis parameters
     #ifdef CONFIG_PROCESS_MUTED_CHANNELS
         if (pEngineChannel->GetMute()) {
-            finalSynthesisParameters.fFinalVolumeLeft  = 0;
-            finalSynthesisParameters.fFinalVolumeRight = 0;
+            GetEngine()->VoiceStates.VolumeLeft[Slot]  = 0;
+            GetEngine()->VoiceStates.VolumeRight[Slot] = 0;
         }
         else
     #else
@@ -255,8 +332,8 @@ namespace LinuxSampler {
             }
             finalVolume *= NoteVolume.currentValue();
 
-            finalSynthesisParameters.fFinalVolumeLeft  = finalVolume * VolumeLeft  * PanLeftSmoother.render()  * NotePan[0].currentValue();
-            finalSynthesisParameters.fFinalVolumeRight = finalVolume * VolumeRight * PanRightSmoother.render() * NotePan[1].currentValue();
+            GetEngine()->VoiceStates.VolumeLeft[Slot]  = finalVolume * VolumeLeft  * PanLeftSmoother.render()  * NotePan[0].currentValue();
+            GetEngine()->VoiceStates.VolumeRight[Slot] = finalVolume * VolumeRight * PanRightSmoother.render() * NotePan[1].currentValue();
         }
     #endif
 #endif
@@ -290,7 +367,7 @@ namespace LinuxSampler {
                 float eg3time = (bPortamento)
                             ? pEngineChannel->PortamentoTime
                             : RgnInfo.EG3Attack;
-                EG3.trigger(eg3depth, eg3time, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                EG3.trigger(eg3depth, eg3time, GetSubfragmentRate());
                 dmsg(5,("PortamentoPos=%f, depth=%f, time=%f\n", pEngineChannel->PortamentoPos, eg3depth, eg3time));
             }
 
@@ -371,7 +448,7 @@ namespace LinuxSampler {
                 pos = overridePos;
         }
 
-        finalSynthesisParameters.dPos = pos;
+        SynthesisPos() = pos - INTERPOLATION_PRE_ROLL; // see Resampler
         Pos = pos;
     }
 
@@ -403,6 +480,9 @@ namespace LinuxSampler {
         AbstractEngineChannel* pChannel = pEngineChannel;
         MidiKeyBase* pMidiKeyInfo = GetMidiKeyInfo(MIDIKey());
 
+        AudioChannel* pOutLeft  = (pTargetChannelLeft)  ? pTargetChannelLeft  : pChannel->pChannelLeft;
+        AudioChannel* pOutRight = (pTargetChannelRight) ? pTargetChannelRight : pChannel->pChannelRight;
+
         const bool bVoiceRequiresDedicatedRouting =
             pEngineChannel->GetFxSendCount() > 0 &&
             (pMidiKeyInfo->ReverbSend || pMidiKeyInfo->ChorusSend);
@@ -420,11 +500,19 @@ namespace LinuxSampler {
             finalSynthesisParameters.pOutLeft  = &GetEngine()->pDedicatedVoiceChannelLeft->Buffer()[Skip];
             finalSynthesisParameters.pOutRight = &GetEngine()->pDedicatedVoiceChannelRight->Buffer()[Skip];
         } else {
-            finalSynthesisParameters.pOutLeft  = &pChannel->pChannelLeft->Buffer()[Skip];
-            finalSynthesisParameters.pOutRight = &pChannel->pChannelRight->Buffer()[Skip];
+            finalSynthesisParameters.pOutLeft  = &pOutLeft->Buffer()[Skip];
+            finalSynthesisParameters.pOutRight = &pOutRight->Buffer()[Skip];
         }
         finalSynthesisParameters.pSrc = pSrc;
 
+        // load the hot synthesis state which was carried over from the
+        // previous fragment
+        VoiceState& state = GetEngine()->VoiceStates;
+        finalSynthesisParameters.dPos              = state.Pos[Slot];
+        finalSynthesisParameters.fFinalPitch       = state.Pitch[Slot];
+        finalSynthesisParameters.fFinalVolumeLeft  = state.VolumeLeft[Slot];
+        finalSynthesisParameters.fFinalVolumeRight = state.VolumeRight[Slot];
+
         RTList<Event>::Iterator itCCEvent = pChannel->pEvents->first();
         RTList<Event>::Iterator itNoteEvent;
         GetFirstEventOnKey(HostKey(), itNoteEvent);
@@ -457,19 +545,37 @@ namespace LinuxSampler {
                 // End the EG1 here, at pos 0, with a shorter max fade
                 // out time.
                 if (pSignalUnitRack == NULL) {
-                    pEG1->enterFadeOutStage(Samples / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                    pEG1->enterFadeOutStage(Samples / SubfragmentSize);
                 } else {
-                    pSignalUnitRack->EnterFadeOutStage(Samples / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                    pSignalUnitRack->EnterFadeOutStage(Samples / SubfragmentSize);
                 }
+                bFadingOut = true;
                 itKillEvent = Pool<Event>::Iterator();
             } else {
                 killPos = RTMath::Min(itKillEvent->FragmentPos(), maxFadeOutPos);
             }
         }
 
+        // the envelope generators and LFOs are rendered for a run of
+        // subfragments at once, up to the next subfragment which processes
+        // events (which might alter them); the envelope block is also
+        // dropped whenever an envelope changes its stage meanwhile
+        float fEG1Block[CONTROL_BLOCK_SIZE];
+        float fEG2Block[CONTROL_BLOCK_SIZE];
+        float fEG3Block[CONTROL_BLOCK_SIZE];
+        float fLFO1Block[CONTROL_BLOCK_SIZE];
+        float fLFO2Block[CONTROL_BLOCK_SIZE];
+        float fLFO3Block[CONTROL_BLOCK_SIZE];
+        uint iEGBlockPos  = 0, iEGBlockSize  = 0;
+        uint iLFOBlockPos = 0, iLFOBlockSize = 0;
+
         uint i = Skip;
         while (i < Samples) {
-            int iSubFragmentEnd = RTMath::Min(i + CONFIG_DEFAULT_SUBFRAGMENT_SIZE, Samples);
+            int iSubFragmentEnd = RTMath::Min(i + SubfragmentSize, Samples);
+            const float fPrevPitch  = finalSynthesisParameters.fFinalPitch;
+            const float fPrevCutoff = state.Cutoff[Slot];
+            const float fPrevLevel  = RTMath::Max(fabsf(finalSynthesisParameters.fFinalVolumeLeft),
+                                                  fabsf(finalSynthesisParameters.fFinalVolumeRight));
 
             // initialize all final synthesis parameters
             fFinalCutoff    = VCFCutoffCtrl.fvalue;
@@ -501,48 +607,55 @@ namespace LinuxSampler {
                     (SYNTHESIS_MODE_GET_FILTER(SynthesisMode) &&
                     pEG2->getSegmentType() == EG::segment_end)) {
                     pEG1->enterFadeOutStage();
+                    bFadingOut = true;
                     itKillEvent = Pool<Event>::Iterator();
+                    iEGBlockSize = 0;
                 }
 
-                // process envelope generators
-                switch (pEG1->getSegmentType()) {
-                    case EG::segment_lin:
-                        fFinalVolume *= pEG1->processLin();
-                        break;
-                    case EG::segment_exp:
-                        fFinalVolume *= pEG1->processExp();
-                        break;
-                    case EG::segment_end:
-                        fFinalVolume *= pEG1->getLevel();
-                        break; // noop
-                    case EG::segment_pow:
-                        fFinalVolume *= pEG1->processPow();
-                        break;
+                // render the next run of envelope and LFO levels if needed
+                if (iEGBlockPos >= iEGBlockSize || iLFOBlockPos >= iLFOBlockSize) {
+                    uint n = RTMath::Min(uint(CONTROL_BLOCK_SIZE), (Samples - i + SubfragmentSize - 1) / SubfragmentSize);
+                    if (itCCEvent)    n = RTMath::Min(n, SubfragmentsBefore(itCCEvent->FragmentPos(), i, SubfragmentSize));
+                    if (itNoteEvent)  n = RTMath::Min(n, SubfragmentsBefore(itNoteEvent->FragmentPos(), i, SubfragmentSize));
+                    if (itGroupEvent) n = RTMath::Min(n, SubfragmentsBefore(itGroupEvent->FragmentPos(), i, SubfragmentSize));
+                    if (itKillEvent)  n = RTMath::Min(n, SubfragmentsBefore(killPos, i, SubfragmentSize));
+                    if (iEGBlockPos >= iEGBlockSize) {
+                        pEG1->render(fEG1Block, n);
+                        pEG2->render(fEG2Block, n);
+                        if (EG3.active()) EG3.render(fEG3Block, n);
+                        iEGBlockPos  = 0;
+                        iEGBlockSize = n;
+                    }
+                    if (iLFOBlockPos >= iLFOBlockSize) {
+                        if (bLFO1Enabled) pLFO1->render(fLFO1Block, n);
+                        if (bLFO2Enabled) pLFO2->render(fLFO2Block, n);
+                        if (bLFO3Enabled) pLFO3->render(fLFO3Block, n);
+                        iLFOBlockPos  = 0;
+                        iLFOBlockSize = n;
+                    }
                 }
-                switch (pEG2->getSegmentType()) {
-                    case EG::segment_lin:
-                        fFinalCutoff *= pEG2->processLin();
-                        break;
-                    case EG::segment_exp:
-                        fFinalCutoff *= pEG2->processExp();
-                        break;
-                    case EG::segment_end:
-                        fFinalCutoff *= pEG2->getLevel();
-                        break; // noop
-                    case EG::segment_pow:
-                        fFinalCutoff *= pEG2->processPow();
-                        break;
+
+                // process envelope generators
+                fFinalVolume *= fEG1Block[iEGBlockPos];
+                pEG1->advance(fEG1Block[iEGBlockPos]);
+                fFinalCutoff *= fEG2Block[iEGBlockPos];
+                pEG2->advance(fEG2Block[iEGBlockPos]);
+                if (EG3.active()) {
+                    finalSynthesisParameters.fFinalPitch *= fEG3Block[iEGBlockPos];
+                    EG3.advance(fEG3Block[iEGBlockPos]);
                 }
-                if (EG3.active()) finalSynthesisParameters.fFinalPitch *= EG3.render();
+                ++iEGBlockPos;
 
                 // process low frequency oscillators
-                if (bLFO1Enabled) fFinalVolume *= (1.0f - pLFO1->render());
-                if (bLFO2Enabled) fFinalCutoff *= (1.0f - pLFO2->render());
-                if (bLFO3Enabled) finalSynthesisParameters.fFinalPitch *= RTMath::CentsToFreqRatio(pLFO3->render());
+                if (bLFO1Enabled) fFinalVolume *= (1.0f - fLFO1Block[iLFOBlockPos]);
+                if (bLFO2Enabled) fFinalCutoff *= (1.0f - fLFO2Block[iLFOBlockPos]);
+                if (bLFO3Enabled) finalSynthesisParameters.fFinalPitch *= RTMath::CentsToFreqRatio(fLFO3Block[iLFOBlockPos]);
+                ++iLFOBlockPos;
             } else {
                 // if the voice was killed in this subfragment, enter fade out stage
                 if (itKillEvent && killPos <= iSubFragmentEnd) {
                     pSignalUnitRack->EnterFadeOutStage();
+                    bFadingOut = true;
                     itKillEvent = Pool<Event>::Iterator();
                 }
                 
@@ -569,18 +682,41 @@ namespace LinuxSampler {
             // limit the pitch so we don't read outside the buffer
             finalSynthesisParameters.fFinalPitch = RTMath::Min(finalSynthesisParameters.fFinalPitch, float(1 << CONFIG_MAX_PITCH));
 
+            // under high CPU load, render voices in their release stage and
+            // inaudible voices with linear interpolation and without filter
+            int FinalSynthesisMode = SynthesisMode;
+            {
+                const bool bReducedQuality =
+                    GetEngine()->ReducedQuality &&
+                    (bReleased || fFinalVolume < REDUCED_QUALITY_VOLUME);
+                finalSynthesisParameters.Interpolation =
+                    (bReducedQuality) ? interpolation_linear : Interpolation;
+                if (bReducedQuality) SYNTHESIS_MODE_SET_FILTER(FinalSynthesisMode, false);
+            }
+
             // if filter enabled then update filter coefficients
-            if (SYNTHESIS_MODE_GET_FILTER(SynthesisMode)) {
+            if (SYNTHESIS_MODE_GET_FILTER(FinalSynthesisMode)) {
                 finalSynthesisParameters.filterLeft.SetParameters(fFinalCutoff, fFinalResonance, GetEngine()->SampleRate);
                 finalSynthesisParameters.filterRight.SetParameters(fFinalCutoff, fFinalResonance, GetEngine()->SampleRate);
             }
 
+            // if the control block is larger than the default subfragment
+            // size, pitch and filter cutoff are interpolated linearly from
+            // their values of the previous control block in steps of the
+            // default subfragment size (volume is always interpolated per
+            // sample point), to avoid zipper noise
+            const float fPitch      = finalSynthesisParameters.fFinalPitch;
+            const bool bInterpolate = SubfragmentSize > CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+            const float fPitchFrom  = (bInterpolate && fPrevPitch > 0.0f) ? fPrevPitch : fPitch;
+            const float fCutoffFrom = (bInterpolate && fPrevCutoff > 0.0f) ? fPrevCutoff : fFinalCutoff;
+
             // do we need resampling?
             const float __PLUS_ONE_CENT  = 1.000577789506554859250142541782224725466f;
             const float __MINUS_ONE_CENT = 0.9994225441413807496009516495583113737666f;
-            const bool bResamplingRequired = !(finalSynthesisParameters.fFinalPitch <= __PLUS_ONE_CENT &&
-                                               finalSynthesisParameters.fFinalPitch >= __MINUS_ONE_CENT);
+            const bool bResamplingRequired = !(fPitch     <= __PLUS_ONE_CENT && fPitch     >= __MINUS_ONE_CENT &&
+                                               fPitchFrom <= __PLUS_ONE_CENT && fPitchFrom >= __MINUS_ONE_CENT);
             SYNTHESIS_MODE_SET_INTERPOLATE(SynthesisMode, bResamplingRequired);
+            SYNTHESIS_MODE_SET_INTERPOLATE(FinalSynthesisMode, bResamplingRequired);
 
             // prepare final synthesis parameters structure
             finalSynthesisParameters.uiToGo            = iSubFragmentEnd - i;
@@ -597,8 +733,87 @@ namespace LinuxSampler {
             finalSynthesisParameters.fFinalVolumeRight =
                 fFinalVolume * VolumeRight * PanRightSmoother.render() * NotePan[1].render();
 #endif
+
+            // select the mixer kernel for this subfragment, so that constant
+            // volume and hard panned voices get their specialized loops
+            {
+#ifdef CONFIG_INTERPOLATE_VOLUME
+                const float fDeltaL = finalSynthesisParameters.fFinalVolumeDeltaLeft;
+                const float fDeltaR = finalSynthesisParameters.fFinalVolumeDeltaRight;
+#else
+                const float fDeltaL = 0.0f;
+                const float fDeltaR = 0.0f;
+#endif
+                int MixerMode = 0;
+                MIXER_MODE_SET_RAMP(MixerMode, fDeltaL != 0.0f || fDeltaR != 0.0f);
+                MIXER_MODE_SET_LEFT(MixerMode, finalSynthesisParameters.fFinalVolumeLeft != 0.0f || fDeltaL != 0.0f);
+                MIXER_MODE_SET_RIGHT(MixerMode, finalSynthesisParameters.fFinalVolumeRight != 0.0f || fDeltaR != 0.0f);
+                MIXER_MODE_SET_IMPLEMENTATION(MixerMode, SYNTHESIS_MODE_GET_IMPLEMENTATION(SynthesisMode));
+                finalSynthesisParameters.pMixFunction = Mixer::GetMixFunction(MixerMode);
+            }
+
+            // let the synthesizer measure the peak of the rendered signal
+            // as long as this voice might still be culled (see below)
+            finalSynthesisParameters.fPeak =
+                (!bFadingOut && GetEngine()->SilenceThreshold > 0.0f) ? 0.0f : -1.0f;
+
             // render audio for one subfragment
-            if (!delay) RunSynthesisFunction(SynthesisMode, &finalSynthesisParameters, &loop);
+            if (delay) {
+                // nothing to render yet
+            } else if (fPitchFrom == fPitch &&
+                       (fCutoffFrom == fFinalCutoff || !SYNTHESIS_MODE_GET_FILTER(FinalSynthesisMode)))
+            {
+                RunSynthesisFunction(FinalSynthesisMode, &finalSynthesisParameters, &loop);
+            } else {
+                const uint uiToGo = finalSynthesisParameters.uiToGo;
+                for (uint j = 0; j < uiToGo; j += CONFIG_DEFAULT_SUBFRAGMENT_SIZE) {
+                    const uint n = RTMath::Min(uint(CONFIG_DEFAULT_SUBFRAGMENT_SIZE), uiToGo - j);
+                    const float t = float(j + n) / float(uiToGo);
+                    finalSynthesisParameters.fFinalPitch = fPitchFrom + (fPitch - fPitchFrom) * t;
+                    if (SYNTHESIS_MODE_GET_FILTER(FinalSynthesisMode)) {
+                        const float fCutoff = fCutoffFrom + (fFinalCutoff - fCutoffFrom) * t;
+                        finalSynthesisParameters.filterLeft.SetParameters(fCutoff, fFinalResonance, GetEngine()->SampleRate);
+                        finalSynthesisParameters.filterRight.SetParameters(fCutoff, fFinalResonance, GetEngine()->SampleRate);
+                    }
+                    finalSynthesisParameters.uiToGo = n;
+                    RunSynthesisFunction(FinalSynthesisMode, &finalSynthesisParameters, &loop);
+                }
+                finalSynthesisParameters.fFinalPitch = fPitch;
+            }
+            state.Cutoff[Slot] = fFinalCutoff;
+
+            // fade out the voice early if its output level stayed below the
+            // silence threshold for a while without rising, e.g. long release
+            // tails of held piano notes or sustained notes whose sample
+            // content decayed to silence. The level is the peak of the
+            // rendered signal times the voice's gain; the gain alone is a
+            // shortcut when even a full scale sample would be inaudible (the
+            // final gain also converts the integer sample range to
+            // -1.0..1.0, see CalculateVolume(), so multiplying it by that
+            // range yields the level of a full scale sample)
+            if (!delay && !bFadingOut && GetEngine()->SilenceThreshold > 0.0f) {
+                const float fFullScale = (SmplInfo.BitDepth == 16) ? 32768.0f : 32768.0f * 65536.0f;
+                const float fGain = RTMath::Max(fabsf(finalSynthesisParameters.fFinalVolumeLeft),
+                                                fabsf(finalSynthesisParameters.fFinalVolumeRight));
+                const bool bSilent =
+                    fGain * fFullScale < GetEngine()->SilenceThreshold ||
+                    finalSynthesisParameters.fPeak * fPrevLevel < GetEngine()->SilenceThreshold;
+                if (bSilent && fGain <= fPrevLevel) {
+                    SilentSamples += iSubFragmentEnd - i;
+                    if (SilentSamples >= uint(CONFIG_SILENCE_HOLD_TIME * GetEngine()->SampleRate)) {
+                        if (pSignalUnitRack == NULL) {
+                            pEG1->enterFadeOutStage();
+                            iEGBlockSize = 0;
+                        } else {
+                            pSignalUnitRack->EnterFadeOutStage();
+                        }
+                        bFadingOut = true;
+                        atomic_inc(&GetEngine()->CulledVoices);
+                    }
+                } else {
+                    SilentSamples = 0;
+                }
+            }
 
             if (pSignalUnitRack == NULL) {
                 // stop the rendering if volume EG is finished
@@ -608,7 +823,7 @@ namespace LinuxSampler {
                 if (!pSignalUnitRack->GetEndpointUnit()->Active()) break;
             }
 
-            const double newPos = Pos + (iSubFragmentEnd - i) * finalSynthesisParameters.fFinalPitch;
+            const double newPos = Pos + (iSubFragmentEnd - i) * 0.5 * (fPitchFrom + fPitch);
 
             if (pSignalUnitRack == NULL) {
                 // increment envelopes' positions
@@ -616,22 +831,32 @@ namespace LinuxSampler {
 
                     // if sample has a loop and loop start has been reached in this subfragment, send a special event to EG1 to let it finish the attack hold stage
                     if (SmplInfo.HasLoops && Pos <= SmplInfo.LoopStart && SmplInfo.LoopStart < newPos) {
-                        pEG1->update(EG::event_hold_end, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        pEG1->update(EG::event_hold_end, GetSubfragmentRate());
+                        iEGBlockSize = 0;
                     }
 
                     pEG1->increment(1);
-                    if (!pEG1->toStageEndLeft()) pEG1->update(EG::event_stage_end, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                    if (!pEG1->toStageEndLeft()) {
+                        pEG1->update(EG::event_stage_end, GetSubfragmentRate());
+                        iEGBlockSize = 0;
+                    }
                 }
                 if (pEG2->active()) {
                     pEG2->increment(1);
-                    if (!pEG2->toStageEndLeft()) pEG2->update(EG::event_stage_end, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                    if (!pEG2->toStageEndLeft()) {
+                        pEG2->update(EG::event_stage_end, GetSubfragmentRate());
+                        iEGBlockSize = 0;
+                    }
                 }
                 EG3.increment(1);
-                if (!EG3.toEndLeft()) EG3.update(); // neutralize envelope coefficient if end reached
+                if (!EG3.toEndLeft()) {
+                    if (EG3.active()) iEGBlockSize = 0;
+                    EG3.update(); // neutralize envelope coefficient if end reached
+                }
             } else {
                     // if sample has a loop and loop start has been reached in this subfragment, send a special event to EG1 to let it finish the attack hold stage
                     /*if (SmplInfo.HasLoops && Pos <= SmplInfo.LoopStart && SmplInfo.LoopStart < newPos) {
-                        pEG1->update(EG::event_hold_end, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        pEG1->update(EG::event_hold_end, GetSubfragmentRate());
                     }*/
                 // TODO: ^^^
                 
@@ -641,6 +866,11 @@ namespace LinuxSampler {
             Pos = newPos;
             i = iSubFragmentEnd;
         }
+
+        state.Pos[Slot]         = finalSynthesisParameters.dPos;
+        state.Pitch[Slot]       = finalSynthesisParameters.fFinalPitch;
+        state.VolumeLeft[Slot]  = finalSynthesisParameters.fFinalVolumeLeft;
+        state.VolumeRight[Slot] = finalSynthesisParameters.fFinalVolumeRight;
         
         if (delay) return;
 
@@ -657,8 +887,8 @@ namespace LinuxSampler {
             GetEngine()->RouteDedicatedVoiceChannels(pEngineChannel, effectSendLevels, Samples);
         } else if (bEq) {
             pEq->RenderAudio(Samples);
-            pEq->GetOutChannelLeft()->MixTo(pChannel->pChannelLeft, Samples);
-            pEq->GetOutChannelRight()->MixTo(pChannel->pChannelRight, Samples);
+            pEq->GetOutChannelLeft()->MixTo(pOutLeft, Samples);
+            pEq->GetOutChannelRight()->MixTo(pOutRight, Samples);
         }
     }
 
@@ -742,9 +972,10 @@ namespace LinuxSampler {
                 if (itEvent->Type == Event::type_release_key) {
                     EnterReleaseStage();
                 } else if (itEvent->Type == Event::type_cancel_release_key) {
+                    bReleased = false;
                     if (pSignalUnitRack == NULL) {
-                        pEG1->update(EG::event_cancel_release, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
-                        pEG2->update(EG::event_cancel_release, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        pEG1->update(EG::event_cancel_release, GetSubfragmentRate());
+                        pEG2->update(EG::event_cancel_release, GetSubfragmentRate());
                     } else {
                         pSignalUnitRack->CancelRelease();
                     }
@@ -768,31 +999,31 @@ namespace LinuxSampler {
             {
                 switch (itEvent->Param.NoteSynthParam.Type) {
                     case Event::synth_param_volume:
-                        NoteVolume.fadeTo(itEvent->Param.NoteSynthParam.AbsValue, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        NoteVolume.fadeTo(itEvent->Param.NoteSynthParam.AbsValue, GetSubfragmentRate());
                         break;
                     case Event::synth_param_volume_time:
                         NoteVolume.setDefaultDuration(itEvent->Param.NoteSynthParam.AbsValue);
                         break;
                     case Event::synth_param_volume_curve:
-                        NoteVolume.setCurve((fade_curve_t)itEvent->Param.NoteSynthParam.AbsValue, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        NoteVolume.setCurve((fade_curve_t)itEvent->Param.NoteSynthParam.AbsValue, GetSubfragmentRate());
                         break;
                     case Event::synth_param_pitch:
-                        NotePitch.fadeTo(itEvent->Param.NoteSynthParam.AbsValue, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        NotePitch.fadeTo(itEvent->Param.NoteSynthParam.AbsValue, GetSubfragmentRate());
                         break;
                     case Event::synth_param_pitch_time:
                         NotePitch.setDefaultDuration(itEvent->Param.NoteSynthParam.AbsValue);
                         break;
                     case Event::synth_param_pitch_curve:
-                        NotePitch.setCurve((fade_curve_t)itEvent->Param.NoteSynthParam.AbsValue, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        NotePitch.setCurve((fade_curve_t)itEvent->Param.NoteSynthParam.AbsValue, GetSubfragmentRate());
                         break;
                     case Event::synth_param_pan:
                         NotePan[0].fadeTo(
                             AbstractEngine::PanCurveValueNorm(itEvent->Param.NoteSynthParam.AbsValue, 0 /*left*/),
-                            GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE
+                            GetSubfragmentRate()
                         );
                         NotePan[1].fadeTo(
                             AbstractEngine::PanCurveValueNorm(itEvent->Param.NoteSynthParam.AbsValue, 1 /*right*/),
-                            GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE
+                            GetSubfragmentRate()
                         );
                         break;
                     case Event::synth_param_pan_time:
@@ -800,8 +1031,8 @@ namespace LinuxSampler {
                         NotePan[1].setDefaultDuration(itEvent->Param.NoteSynthParam.AbsValue);
                         break;
                     case Event::synth_param_pan_curve:
-                        NotePan[0].setCurve((fade_curve_t)itEvent->Param.NoteSynthParam.AbsValue, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
-                        NotePan[1].setCurve((fade_curve_t)itEvent->Param.NoteSynthParam.AbsValue, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        NotePan[0].setCurve((fade_curve_t)itEvent->Param.NoteSynthParam.AbsValue, GetSubfragmentRate());
+                        NotePan[1].setCurve((fade_curve_t)itEvent->Param.NoteSynthParam.AbsValue, GetSubfragmentRate());
                         break;
                     case Event::synth_param_cutoff:
                         NoteCutoff = itEvent->Param.NoteSynthParam.AbsValue;
@@ -813,19 +1044,19 @@ namespace LinuxSampler {
                         pLFO1->setScriptDepthFactor(itEvent->Param.NoteSynthParam.AbsValue);
                         break;
                     case Event::synth_param_amp_lfo_freq:
-                        pLFO1->setScriptFrequencyFactor(itEvent->Param.NoteSynthParam.AbsValue, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        pLFO1->setScriptFrequencyFactor(itEvent->Param.NoteSynthParam.AbsValue, GetSubfragmentRate());
                         break;
                     case Event::synth_param_cutoff_lfo_depth:
                         pLFO2->setScriptDepthFactor(itEvent->Param.NoteSynthParam.AbsValue);
                         break;
                     case Event::synth_param_cutoff_lfo_freq:
-                        pLFO2->setScriptFrequencyFactor(itEvent->Param.NoteSynthParam.AbsValue, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        pLFO2->setScriptFrequencyFactor(itEvent->Param.NoteSynthParam.AbsValue, GetSubfragmentRate());
                         break;
                     case Event::synth_param_pitch_lfo_depth:
                         pLFO3->setScriptDepthFactor(itEvent->Param.NoteSynthParam.AbsValue);
                         break;
                     case Event::synth_param_pitch_lfo_freq:
-                        pLFO3->setScriptFrequencyFactor(itEvent->Param.NoteSynthParam.AbsValue, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                        pLFO3->setScriptFrequencyFactor(itEvent->Param.NoteSynthParam.AbsValue, GetSubfragmentRate());
                         break;
 
                     case Event::synth_param_attack:
@@ -928,7 +1159,8 @@ namespace LinuxSampler {
     double AbstractVoice::CalculateVolume(double velocityAttenuation) {
         // For 16 bit samples, we downscale by 32768 to convert from
         // int16 value range to DSP value range (which is
-        // -1.0..1.0). For 24 bit, we downscale from int32.
+        // -1.0..1.0). For 24 bit (and samples expanded to 32 bit), we
+        // downscale from int32.
         float volume = velocityAttenuation / (SmplInfo.BitDepth == 16 ? 32768.0f : 32768.0f * 65536.0f);
 
         volume *= GetSampleAttenuation() * pEngineChannel->GlobalVolume * GLOBAL_VOLUME;
@@ -949,9 +1181,11 @@ namespace LinuxSampler {
     }
 
     void AbstractVoice::EnterReleaseStage() {
+        if (!bReleased) ReleaseTime = GetEngine()->FrameTime;
+        bReleased = true;
         if (pSignalUnitRack == NULL) {
-            pEG1->update(EG::event_release, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
-            pEG2->update(EG::event_release, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+            pEG1->update(EG::event_release, GetSubfragmentRate());
+            pEG2->update(EG::event_release, GetSubfragmentRate());
         } else {
             pSignalUnitRack->EnterReleaseStage();
         }
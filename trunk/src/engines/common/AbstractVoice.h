@@ -39,6 +39,7 @@
 #include "../gig/Synthesizer.h"
 #include "../gig/Profiler.h"
 #include "SignalUnitRack.h"
+#include "UnrolledLoop.h"
 
 // include the appropriate (unsigned) triangle LFO implementation
 #if CONFIG_UNSIGNED_TRIANG_ALGO == INT_MATH_SOLUTION
@@ -85,6 +86,11 @@ namespace LinuxSampler {
             type_t       Type;         ///< Voice Type (bit field, a voice may have several types)
             NoteBase*    pNote;        ///< Note this voice belongs to and was caused by.
             int          MIDIPan;      ///< the current MIDI pan value plus the value from RegionInfo
+            int          Slot;         ///< Index of this voice's hot synthesis state in its engine's VoiceStates arrays.
+            sched_time_t ReleaseTime;  ///< Scheduler time of the audio fragment in which this voice entered its release stage (only valid if IsReleased() is true).
+            AbstractVoice* pStealPrev; ///< Previous voice in the same bucket of its engine channel's victim order for voice stealing (see MidiKeyboardManager::StealOrder).
+            AbstractVoice* pStealNext; ///< Next voice in the same bucket of its engine channel's victim order for voice stealing.
+            int          StealBucket;  ///< Bucket of its engine channel's victim order this voice is in, -1 if none.
 
             SignalUnitRack* const pSignalUnitRack;
 
@@ -93,6 +99,16 @@ namespace LinuxSampler {
 
             inline bool IsActive() { return PlaybackState; }
             inline bool IsStealable() { return !itKillEvent && PlaybackState >= playback_state_ram; }
+            inline bool IsReleased() const { return bReleased; }
+            inline bool IsFadingOut() const { return bFadingOut; }
+
+            /// Output level of this voice as of the end of its last rendered audio fragment (louder channel), in relation to full scale for a full scale sample.
+            inline float GetOutputLevel() {
+                const VoiceState& state = GetEngine()->VoiceStates;
+                // the final gain also converts the integer sample range to -1.0..1.0 (see CalculateVolume())
+                return RTMath::Max(fabsf(state.VolumeLeft[Slot]), fabsf(state.VolumeRight[Slot])) *
+                       ((SmplInfo.BitDepth == 16) ? 32768.0f : 32768.0f * 65536.0f);
+            }
 
             virtual void Reset();
 
@@ -112,6 +128,9 @@ namespace LinuxSampler {
             virtual release_trigger_t GetReleaseTriggerFlags() = 0;
 
             uint GetSampleRate() { return GetEngine()->SampleRate; }
+
+            /// Rate (in Hz) at which the modulation sources of this voice are evaluated (see SubfragmentSize).
+            uint GetSubfragmentRate() { return GetSampleRate() / SubfragmentSize; }
             
             uint8_t GetControllerValue(uint8_t Controller) {
                 return (Controller > 128) ? 0 : pEngineChannel->ControllerTable[Controller];
@@ -137,6 +156,8 @@ namespace LinuxSampler {
             bool                Orphan;             ///< true if this voice is playing a sample from an instrument that is unloaded. When the voice dies, the sample (and dimension region) will be handed back to the instrument resource manager.
             playback_state_t    PlaybackState;      ///< When a sample will be triggered, it will be first played from RAM cache and after a couple of sample points it will switch to disk streaming and at the end of a disk stream we have to add null samples, so the interpolator can do it's work correctly
             Stream::reference_t DiskStreamRef;      ///< Reference / link to the disk stream
+            AudioChannel*       pTargetChannelLeft; ///< If not NULL, audio channel the voice is mixed to instead of its engine channel's left channel (i.e. private buffer of a voice render thread).
+            AudioChannel*       pTargetChannelRight;///< If not NULL, audio channel the voice is mixed to instead of its engine channel's right channel (i.e. private buffer of a voice render thread).
 
             template<class TV, class TRR, class TR, class TD, class TIM, class TI> friend class EngineBase;
 
@@ -182,10 +203,16 @@ namespace LinuxSampler {
             Pool<Event>::Iterator       itTriggerEvent;      ///< First event on the key's list the voice should process (only needed for the first audio fragment in which voice was triggered, after that it will be set to NULL).
             Pool<Event>::Iterator       itKillEvent;         ///< Event which caused this voice to be killed
             int                         SynthesisMode;
+            uint                        SubfragmentSize;     ///< Amount of sample points per control block of this voice, i.e. after how many sample points its envelopes, LFOs and other modulation sources are evaluated again (adopted from the engine when the voice is triggered).
+            interpolation_t             Interpolation;       ///< Interpolation algorithm selected for this voice when it was triggered (the voice might temporarily fall back to linear interpolation, see AbstractEngine::ReducedQuality).
+            bool                        bReleased;           ///< True if this voice entered its release stage (used to decide whether its quality may be reduced under high CPU load).
+            uint                        SilentSamples;       ///< Amount of sample points for which the output level of this voice stayed below the engine's silence threshold without rising (see AbstractEngine::SilenceThreshold).
+            bool                        bFadingOut;          ///< True once this voice entered its fade out stage (killed or culled), so it is neither culled nor counted as culled again.
             float                       fFinalCutoff;
             float                       fFinalResonance;
             gig::SynthesisParam         finalSynthesisParameters;
             gig::Loop                   loop;
+            const UnrolledLoop*         pUnrolledLoop;       ///< If not NULL, the endless RAM loop of this voice is played from this unrolled copy of the loop instead of the sample's RAM cache
             RTList<Event>*              pGroupEvents;        ///< Events directed to an exclusive group
             
             EqSupport* pEq;         ///< Used for per voice equalization
@@ -200,6 +227,9 @@ namespace LinuxSampler {
             }
 
             virtual AbstractEngine* GetEngine() = 0;
+
+            /// Current playback position of this voice in its sample source buffer, kept in the engine's VoiceStates between the fragments.
+            inline double& SynthesisPos() { return GetEngine()->VoiceStates.Pos[Slot]; }
             virtual SampleInfo      GetSampleInfo() = 0;
             virtual RegionInfo      GetRegionInfo() = 0;
             virtual InstrumentInfo  GetInstrumentInfo() = 0;
@@ -221,6 +251,20 @@ namespace LinuxSampler {
              * Gets the sample cache size in bytes.
              */
             virtual unsigned long GetSampleCacheSize() = 0;
+
+            /**
+             * Calculates the coefficient of the fade out stage of the volume
+             * envelope(s), such that the fade out from full volume takes
+             * @a FadeOutTime seconds with the default control block size.
+             */
+            virtual void CalculateFadeOutCoeff(float FadeOutTime, float SampleRate) = 0;
+
+            /**
+             * Returns an unrolled copy of the sample's loop to be used for
+             * playing an endless loop from RAM, or NULL if there is none.
+             * The default implementation always returns NULL.
+             */
+            virtual const UnrolledLoop* GetUnrolledLoop() { return NULL; }
             
             /**
              * Because in most cases we cache part of the sample in RAM, if the
@@ -229,7 +273,9 @@ namespace LinuxSampler {
              * beginning of the sample but a part that starts from the sample offset point.
              * In that case the current sample position should start from zero (Pos).
              * When the offset fits into RAM buffer or the whole sample is cached
-             * in RAM, Pos should contain the actual offset.
+             * in RAM, Pos should contain the actual offset. The synthesis
+             * position (SynthesisPos()) always starts INTERPOLATION_PRE_ROLL
+             * sample points before Pos.
              * We don't trim the sample because it might have a defined
              * loop start point before the start point of the playback.
              */
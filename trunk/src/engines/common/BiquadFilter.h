@@ -30,6 +30,7 @@
 #include <math.h>
 
 #include "../../common/global_private.h"
+#include "../../common/Features.h"
 
 /// ln(2) / 2
 #define LN_2_2			0.34657359f
@@ -85,11 +86,13 @@ namespace LinuxSampler {
              * Prevent \a f from going into denormal mode which would slow down
              * subsequent floating point calculations, we achieve that by setting
              * \a f to zero when it falls under the denormal threshold value.
+             * Not necessary if the FPU flushes denormal numbers to zero.
              */
             inline void KillDenormal(bq_t& f) {
-                // TODO: this is a generic solution for 32bit floats, should be replaced by CPU specific asm code
+                #if !HAVE_FPU_FTZ_MODE
                 f += 1e-18f;
                 f -= 1e-18f;
+                #endif
             }
         public:
             BiquadFilter() {
@@ -0,0 +1,137 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#include "DiskLatency.h"
+
+#include <math.h>
+#include <string.h>
+#include <sstream>
+#if !defined(WIN32)
+# include <sys/types.h>
+# include <sys/stat.h>
+#endif
+
+// upper bound of the first histogram bucket (in microseconds), each further
+// bucket's upper bound is a quarter octave higher, so the last one ends at
+// about 5.5 seconds
+#define FIRST_BUCKET_LATENCY 100.0
+
+// when a device got that many measurements, all its buckets are halved, so
+// that the statistics follow changes of the device's behavior
+#define MAX_MEASUREMENTS 100000
+
+namespace LinuxSampler {
+
+    Mutex                               DiskLatency::mutex;
+    std::map<String,String>             DiskLatency::devicesOfFiles;
+    std::map<String,DiskLatency::device_t> DiskLatency::devices;
+
+    static int bucketOf(RTMath::usecs_t Latency) {
+        if (Latency <= FIRST_BUCKET_LATENCY) return 0;
+        const int i = int(ceil(4.0 * log2(double(Latency) / FIRST_BUCKET_LATENCY)));
+        return (i < DISK_LATENCY_BUCKETS) ? i : DISK_LATENCY_BUCKETS - 1;
+    }
+
+    static RTMath::usecs_t upperBoundOf(int Bucket) {
+        return RTMath::usecs_t(FIRST_BUCKET_LATENCY * pow(2.0, Bucket / 4.0));
+    }
+
+    String DiskLatency::DeviceOf(const String& File) {
+        std::map<String,String>::const_iterator it = devicesOfFiles.find(File);
+        if (it != devicesOfFiles.end()) return it->second;
+        String device;
+        #if defined(WIN32)
+        // the drive letter or the UNC server share prefix of the path
+        const size_t n = File.find_first_of("\\/", (File.size() > 1 && File[1] == ':') ? 0 : 2);
+        device = File.substr(0, n);
+        #else
+        struct stat st;
+        if (stat(File.c_str(), &st) == 0) {
+            std::stringstream ss;
+            ss << (unsigned long long) st.st_dev;
+            device = ss.str();
+        }
+        #endif
+        devicesOfFiles[File] = device;
+        return device;
+    }
+
+    void DiskLatency::AddStreamStartLatency(const String& File, RTMath::usecs_t Latency) {
+        LockGuard lock(mutex);
+        std::map<String,device_t>::iterator it = devices.find(DeviceOf(File));
+        if (it == devices.end()) {
+            device_t device;
+            memset(&device, 0, sizeof(device));
+            it = devices.insert(std::make_pair(DeviceOf(File), device)).first;
+        }
+        device_t& device = it->second;
+        device.Histogram[bucketOf(Latency)]++;
+        if (++device.Count >= MAX_MEASUREMENTS) {
+            device.Count = 0;
+            for (int i = 0; i < DISK_LATENCY_BUCKETS; i++) {
+                device.Histogram[i] /= 2;
+                device.Count += device.Histogram[i];
+            }
+        }
+    }
+
+    RTMath::usecs_t DiskLatency::StreamStartLatency(const String& File) {
+        LockGuard lock(mutex);
+        std::map<String,device_t>::const_iterator it = devices.find(DeviceOf(File));
+        if (it == devices.end()) return 0;
+        const device_t& device = it->second;
+        if (device.Count < DISK_LATENCY_MIN_MEASUREMENTS) return 0;
+        // smallest bucket which covers 99.9% of the measurements
+        const uint limit = device.Count - device.Count / 1000;
+        uint sum = 0;
+        for (int i = 0; i < DISK_LATENCY_BUCKETS; i++) {
+            sum += device.Histogram[i];
+            if (sum >= limit) return upperBoundOf(i);
+        }
+        return upperBoundOf(DISK_LATENCY_BUCKETS - 1);
+    }
+
+    uint DiskLatency::PreloadSamples(const String& File, uint SampleRate, uint MaxSamplesPerCycle) {
+        #if CONFIG_ADAPTIVE_PRELOAD
+        const RTMath::usecs_t latency = StreamStartLatency(File);
+        if (!latency) return CONFIG_PRELOAD_SAMPLES;
+        // cover twice the observed latency, plus what a voice reserves for
+        // its last audio fragment before it switches to disk streaming; a
+        // voice transposed up consumes up to 2^CONFIG_MAX_PITCH times as
+        // many sample points per second, so both terms are scaled by that
+        uint samples = uint(2.0 * double(latency) / 1000000.0 * SampleRate * double(1 << CONFIG_MAX_PITCH)) +
+                       (MaxSamplesPerCycle << CONFIG_MAX_PITCH);
+        if (samples < CONFIG_PRELOAD_SAMPLES / 8) samples = CONFIG_PRELOAD_SAMPLES / 8;
+        if (samples > CONFIG_PRELOAD_SAMPLES * 8) samples = CONFIG_PRELOAD_SAMPLES * 8;
+        return samples;
+        #else
+        return CONFIG_PRELOAD_SAMPLES;
+        #endif
+    }
+
+    void DiskLatency::ForgetFile(const String& File) {
+        LockGuard lock(mutex);
+        devicesOfFiles.erase(File);
+    }
+
+} // namespace LinuxSampler
@@ -0,0 +1,109 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_DISKLATENCY_H__
+#define __LS_DISKLATENCY_H__
+
+#include <map>
+
+#include "../../common/global_private.h"
+#include "../../common/Mutex.h"
+#include "../../common/RTMath.h"
+
+/// Amount of buckets of the stream start latency histogram of each storage device.
+#define DISK_LATENCY_BUCKETS 64
+
+/// Minimum amount of stream starts measured on a device before its preload size is adapted.
+#define DISK_LATENCY_MIN_MEASUREMENTS 1000
+
+namespace LinuxSampler {
+
+    /** @brief Stream start latency statistics
+     *
+     * Collects how long it took on each storage device from ordering a
+     * disk stream until the disk thread read the stream's first data. If
+     * the sampler was compiled with CONFIG_ADAPTIVE_PRELOAD, the sizes of
+     * the RAM preloads of samples are derived from these measurements
+     * (see PreloadSamples()), instead of always caching
+     * CONFIG_PRELOAD_SAMPLES sample points.
+     *
+     * The measurements are kept for the lifetime of the process, so they
+     * affect all instruments loaded after enough stream starts were seen
+     * on the respective device.
+     */
+    class DiskLatency {
+        public:
+            /**
+             * Records the stream start latency of a stream reading from the
+             * given file. Called by the disk thread, not real-time safe.
+             *
+             * @param File    - sample file the stream reads from
+             * @param Latency - time from stream order to first data (in
+             *                  microseconds)
+             */
+            static void AddStreamStartLatency(const String& File, RTMath::usecs_t Latency);
+
+            /**
+             * Returns the 99.9th percentile of the stream start latencies
+             * measured on the storage device of the given file (in
+             * microseconds), or 0 if there were not enough measurements yet.
+             */
+            static RTMath::usecs_t StreamStartLatency(const String& File);
+
+            /**
+             * Returns the amount of sample points to be cached in RAM at
+             * the beginning of a disk streamed sample stored in the given
+             * file. Without CONFIG_ADAPTIVE_PRELOAD, or if there were not
+             * enough measurements on the file's device yet, this is
+             * CONFIG_PRELOAD_SAMPLES.
+             *
+             * @param File               - sample file
+             * @param SampleRate         - sample rate of the sample
+             * @param MaxSamplesPerCycle - max. audio fragment size of the engine
+             */
+            static uint PreloadSamples(const String& File, uint SampleRate, uint MaxSamplesPerCycle);
+
+            /**
+             * Drops the cached storage device of the given file. Must be
+             * called when the file is unloaded, so the cache doesn't grow
+             * with every sample file ever loaded. The latency statistics
+             * of the device are kept.
+             */
+            static void ForgetFile(const String& File);
+
+        private:
+            struct device_t {
+                uint Histogram[DISK_LATENCY_BUCKETS];
+                uint Count;
+            };
+
+            static String DeviceOf(const String& File);
+
+            static Mutex                          mutex;
+            static std::map<String,String>        devicesOfFiles; ///< Cache for DeviceOf() of all currently loaded files (see ForgetFile()).
+            static std::map<String,device_t>      devices;
+    };
+
+} // namespace LinuxSampler
+
+#endif // __LS_DISKLATENCY_H__
@@ -31,14 +31,12 @@ namespace LinuxSampler {
     // *
 
     /**
-     * This is the comparison function the qsort algo uses to determine if a value is
-     * bigger than another one or special in our case; if the writespace of a stream
-     * is bigger than another one.
+     * This is the comparison function used to sort the streams to be
+     * refilled; it returns true if stream @a a would run out of data before
+     * stream @a b.
      */
-    int CompareStreamWriteSpace(const void* A, const void* B) {
-        Stream* a = *(Stream**) A;
-        Stream* b = *(Stream**) B;
-        return b->GetWriteSpace() - a->GetWriteSpace();
+    bool CompareStreamDeadline(const stream_deadline_t& a, const stream_deadline_t& b) {
+        return a.Deadline < b.Deadline;
     }
 } // namespace LinuxSampler
 
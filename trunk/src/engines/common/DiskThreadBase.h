@@ -26,7 +26,9 @@
 #ifndef __LS_DISKTHREADBASE_H__
 #define __LS_DISKTHREADBASE_H__
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 #include "StreamBase.h"
 #include "../EngineChannel.h"
@@ -36,11 +38,27 @@
 
 #include "../../common/Thread.h"
 #include "../../common/RingBuffer.h"
+#include "../../common/MultiProducerRingBuffer.h"
 #include "../../common/atomic.h"
+#include "../../common/RTWorkerPool.h"
+#include "../../common/Semaphore.h"
+#include "../../common/lsatomic.h"
+#include "DiskLatency.h"
+
+/// Max. time (in microseconds) the disk thread sleeps if there is nothing to do.
+#define DISK_THREAD_IDLE_SLEEP 30000
+
+/// A voice wakes up the disk thread if its stream would run out of data within this time (in microseconds).
+#define DISK_THREAD_LOW_WATER_TIME (4 * DISK_THREAD_IDLE_SLEEP)
 
 namespace LinuxSampler {
 
-    int CompareStreamWriteSpace(const void* A, const void* B);
+    struct stream_deadline_t {
+        float   Deadline; ///< Time (in sample points) until the stream runs out of data (see Stream::GetTimeToUnderrun()).
+        Stream* pStream;
+    };
+
+    bool CompareStreamDeadline(const stream_deadline_t& a, const stream_deadline_t& b);
 
     /** @brief Disk Reader Thread
      *
@@ -62,6 +80,7 @@ namespace LinuxSampler {
                 R*                   pRegion;
                 unsigned long        SampleOffset;
                 bool                 DoLoop;
+                RTMath::usecs_t      OrderTime;
             };
             struct delete_command_t {
                 Stream*           pStream;
@@ -73,11 +92,22 @@ namespace LinuxSampler {
                 uint32_t Program;
                 EngineChannel* pEngineChannel;
             };
+            struct reader_t {                   ///< Streams to be refilled by one reader thread in the current cycle.
+                std::vector<Stream*> streams;
+                bool                 bIdle;     ///< Set to false if one of the streams got refilled considerably.
+            };
+            class RefillJob : public RTWorkerPool::Job {
+                public:
+                    RefillJob(DiskThreadBase* pThread) : pThread(pThread) {}
+                    void Process(int iJob) OVERRIDE { pThread->RefillReaderStreams(iJob); }
+                private:
+                    DiskThreadBase* pThread;
+            };
             // Attributes
             bool                           IsIdle;
             uint                           Streams;
             RingBuffer<create_command_t,false>* CreationQueue;                      ///< Contains commands to create streams
-            RingBuffer<delete_command_t,false>* DeletionQueue;                      ///< Contains commands to delete streams
+            MultiProducerRingBuffer<delete_command_t>* DeletionQueue;               ///< Contains commands to delete streams (written lock free by all voice render threads, since voices may end on several of them at the same time)
             RingBuffer<delete_command_t,false>* GhostQueue;                         ///< Contains handles to streams that are not used anymore and weren't deletable immediately
             RingBuffer<Stream::Handle,false>    DeletionNotificationQueue;          ///< In case the original sender requested a notification for its stream deletion order, this queue will receive the handle of the respective stream once actually be deleted by the disk thread.
             RingBuffer<R*,false>*               DeleteRegionQueue;          ///< Contains dimension regions that are not used anymore and should be handed back to the instrument resource manager
@@ -86,6 +116,12 @@ namespace LinuxSampler {
             Stream**                       pStreams; ///< Contains all disk streams (whether used or unused)
             Stream**                       pCreatedStreams; ///< This is where the voice (audio thread) picks up it's meanwhile hopefully created disk stream.
             static Stream*                 SLOT_RESERVED;                          ///< This value is used to mark an entry in pCreatedStreams[] as reserved.
+            RTWorkerPool*                  pReaderPool;                            ///< Additional reader threads which help refilling the streams, NULL if CONFIG_DISK_READER_THREADS is 0.
+            std::vector<reader_t>          readers;                                ///< Streams to be refilled in the current cycle, by reader thread (index 0 is the disk thread itself).
+            RefillJob                      refillJob;
+            std::vector<stream_deadline_t> deadlines;                              ///< Active streams with free buffer space of the current cycle, sorted by deadline (earliest first).
+            Semaphore                      WakeupSemaphore;                        ///< Posted by Wakeup() to end the disk thread's idle sleep early.
+            atomic<int>                    Sleeping;                               ///< 1 while the disk thread is about to sleep or sleeping.
 
             // Methods
 
@@ -104,6 +140,7 @@ namespace LinuxSampler {
                     return;
                 }
                 LaunchStream(newstream, Command.hStream, Command.pStreamRef, Command.pRegion, Command.SampleOffset, Command.DoLoop);
+                newstream->OrderTime = Command.OrderTime;
                 dmsg(4,("new Stream launched by disk thread (OrderID:%d,StreamHandle:%d)\n", Command.OrderID, Command.hStream));
                 if (pCreatedStreams[Command.OrderID] != SLOT_RESERVED) {
                     std::cerr << "DiskThread: Slot " << Command.OrderID << " already occupied! Please report this!\n" << std::flush;
@@ -145,29 +182,76 @@ namespace LinuxSampler {
             }
 
             void RefillStreams() {
-                // sort the streams by most empty stream
-                qsort(pStreams, Streams, sizeof(Stream*), CompareStreamWriteSpace);
-
-                // refill the most empty streams
-                for (uint i = 0; i < RefillStreamsPerRun; i++) {
-                    if (pStreams[i]->GetState() == Stream::state_active) {
-
-                        //float filledpercentage = (float) pStreams[i]->GetReadSpace() / 131072.0 * 100.0;
-                        //dmsg(("\nbuffer fill: %.1f%\n", filledpercentage));
+                // sort the active streams with free buffer space by the
+                // time they will run out of data (earliest deadline first);
+                // this is done from scratch on each cycle, since every
+                // deadline moves (at its own rate) while the audio thread
+                // consumes data
+                deadlines.clear();
+                for (uint i = 0; i < Streams; i++) {
+                    if (pStreams[i]->GetState() != Stream::state_active) continue;
+                    if (pStreams[i]->GetWriteSpaceToEnd() == 0) continue;
+                    stream_deadline_t entry;
+                    entry.Deadline = pStreams[i]->GetTimeToUnderrun();
+                    entry.pStream  = pStreams[i];
+                    deadlines.push_back(entry);
+                }
+                std::sort(deadlines.begin(), deadlines.end(), CompareStreamDeadline);
+
+                // distribute the streams with the earliest deadlines among
+                // the readers, each one refilling up to RefillStreamsPerRun
+                // streams
+                for (int r = 0; r < readers.size(); r++) readers[r].streams.clear();
+                const uint maxStreams = RefillStreamsPerRun * uint(readers.size());
+                for (uint i = 0, n = 0; n < maxStreams && i < deadlines.size(); i++) {
+                    Stream* pStream = deadlines[i].pStream;
+                    std::vector<Stream*>& streams = readers[ReaderOf(pStream)].streams;
+                    if (streams.size() >= RefillStreamsPerRun) continue;
+                    streams.push_back(pStream);
+                    n++;
+                }
 
-                        int writespace = pStreams[i]->GetWriteSpaceToEnd();
-                        if (writespace == 0) break;
+                // refill them (in parallel if there are reader threads)
+                if (pReaderPool) pReaderPool->Run(&refillJob, int(readers.size()));
+                else             RefillReaderStreams(0);
 
-                        int capped_writespace = writespace;
-                        // if there is too much buffer space available then cut the read/write
-                        // size to CONFIG_STREAM_MAX_REFILL_SIZE which is by default 65536 samples = 256KBytes
-                        if (writespace > CONFIG_STREAM_MAX_REFILL_SIZE) capped_writespace = CONFIG_STREAM_MAX_REFILL_SIZE;
+                for (int r = 0; r < readers.size(); r++)
+                    if (!readers[r].bIdle) this->IsIdle = false;
+            }
 
-                        // adjust the amount to read in order to ensure that the buffer wraps correctly
-                        int read_amount = pStreams[i]->AdjustWriteSpaceToAvoidBoundary(writespace, capped_writespace);
-                        // if we wasn't able to refill one of the stream buffers by more than
-                        // CONFIG_STREAM_MIN_REFILL_SIZE we'll send the disk thread to sleep later
-                        if (pStreams[i]->ReadAhead(read_amount) > CONFIG_STREAM_MIN_REFILL_SIZE) this->IsIdle = false;
+            void RefillReaderStreams(int iReader) {
+                reader_t& reader = readers[iReader];
+                reader.bIdle = true;
+                for (int i = 0; i < reader.streams.size(); i++) {
+                    Stream* pStream = reader.streams[i];
+
+                    //float filledpercentage = (float) pStream->GetReadSpace() / 131072.0 * 100.0;
+                    //dmsg(("\nbuffer fill: %.1f%\n", filledpercentage));
+
+                    int writespace = pStream->GetWriteSpaceToEnd();
+                    if (writespace == 0) continue;
+
+                    int capped_writespace = writespace;
+                    // if there is too much buffer space available then cut the read/write
+                    // size to CONFIG_STREAM_MAX_REFILL_SIZE which is by default 65536 samples = 256KBytes
+                    if (writespace > CONFIG_STREAM_MAX_REFILL_SIZE) capped_writespace = CONFIG_STREAM_MAX_REFILL_SIZE;
+
+                    // adjust the amount to read in order to ensure that the buffer wraps correctly
+                    int read_amount = pStream->AdjustWriteSpaceToAvoidBoundary(writespace, capped_writespace);
+                    // if we wasn't able to refill one of the stream buffers by more than
+                    // CONFIG_STREAM_MIN_REFILL_SIZE we'll send the disk thread to sleep later
+                    if (pStream->ReadAhead(read_amount) > CONFIG_STREAM_MIN_REFILL_SIZE) reader.bIdle = false;
+
+                    // first data of a newly launched stream, so we know how
+                    // long the voice had to wait for it since its order
+                    if (pStream->OrderTime) {
+                        const String file = pStream->GetSourceFile();
+                        if (!file.empty()) {
+                            DiskLatency::AddStreamStartLatency(
+                                file, RTMath::unsafeMicroSeconds(RTMath::real_clock) - pStream->OrderTime
+                            );
+                        }
+                        pStream->OrderTime = 0;
                     }
                 }
             }
@@ -199,10 +283,14 @@ namespace LinuxSampler {
                 Thread(true, false, 1, -2),
                 DeletionNotificationQueue(4*MaxStreams),
                 ProgramChangeQueue(512),
+                pReaderPool(NULL),
+                readers(1),
+                refillJob(this),
+                Sleeping(0),
                 pInstruments(pInstruments)
             {
                 CreationQueue       = new RingBuffer<create_command_t,false>(4*MaxStreams);
-                DeletionQueue       = new RingBuffer<delete_command_t,false>(4*MaxStreams);
+                DeletionQueue       = new MultiProducerRingBuffer<delete_command_t>(4*MaxStreams);
                 GhostQueue          = new RingBuffer<delete_command_t,false>(MaxStreams);
                 DeleteRegionQueue   = new RingBuffer<R*,false>(4*MaxStreams);
                 pStreams            = new Stream*[MaxStreams];
@@ -210,13 +298,25 @@ namespace LinuxSampler {
                 Streams             = MaxStreams;
                 RefillStreamsPerRun = CONFIG_REFILL_STREAMS_PER_RUN;
 
+                #if CONFIG_DISK_READER_THREADS > 0
+                pReaderPool = new RTWorkerPool(CONFIG_DISK_READER_THREADS, false);
+                readers.resize(pReaderPool->ThreadCount() + 1);
+                #endif
+                for (int r = 0; r < readers.size(); r++) {
+                    readers[r].streams.reserve(RefillStreamsPerRun);
+                    readers[r].bIdle = true;
+                }
+                deadlines.reserve(MaxStreams);
+
                 for (int i = 1; i <= MaxStreams; i++) {
                     pCreatedStreams[i] = NULL;
                 }
+                SetActiveStreamCount(0);
                 ActiveStreamCountMax = 0;
             }
 
             virtual ~DiskThreadBase() {
+                if (pReaderPool) delete pReaderPool;
                 for (int i = 0; i < Streams; i++) {
                     if (pStreams[i]) delete pStreams[i];
                 }
@@ -330,8 +430,16 @@ namespace LinuxSampler {
                 cmd.pRegion      = pRegion;
                 cmd.SampleOffset = SampleOffset;
                 cmd.DoLoop       = DoLoop;
+                #if CONFIG_ADAPTIVE_PRELOAD
+                // clock_gettime(CLOCK_MONOTONIC) and its counterparts on other
+                // systems neither block nor enter the kernel on common systems
+                cmd.OrderTime    = RTMath::unsafeMicroSeconds(RTMath::real_clock);
+                #else
+                cmd.OrderTime    = 0;
+                #endif
 
                 CreationQueue->push(&cmd);
+                Wakeup(); // the voice needs the stream's first data soon
                 return 0;
             }
 
@@ -349,18 +457,16 @@ namespace LinuxSampler {
              */
             int OrderDeletionOfStream(Stream::reference_t* pStreamRef, bool bRequestNotification = false) {
                 dmsg(4,("Disk Thread: stream deletion ordered\n"));
-                if (DeletionQueue->write_space() < 1) {
-                    dmsg(1,("DiskThread: Deletion queue full!\n"));
-                    return -1;
-                }
-
                 delete_command_t cmd;
                 cmd.pStream = pStreamRef->pStream;
                 cmd.hStream = pStreamRef->hStream;
                 cmd.OrderID = pStreamRef->OrderID;
                 cmd.bNotify = bRequestNotification;
 
-                DeletionQueue->push(&cmd);
+                if (!DeletionQueue->push(&cmd)) {
+                    dmsg(1,("DiskThread: Deletion queue full!\n"));
+                    return -1;
+                }
                 return 0;
             }
 
@@ -396,9 +502,23 @@ namespace LinuxSampler {
                     return -1;
                 }
                 ProgramChangeQueue.push(&cmd);
+                Wakeup();
                 return 0;
             }
 
+            /**
+             * Wakes up the disk thread if it is currently sleeping because
+             * there was nothing to do. This method is real-time safe, so it
+             * may be called by the audio thread, e.g. if a stream is about to
+             * run out of data (see DISK_THREAD_LOW_WATER_TIME).
+             */
+            void Wakeup() {
+                // only the caller which resets the flag posts, so concurrent
+                // callers (e.g. RT workers) never post more than once per sleep
+                if (Sleeping.load(memory_order_relaxed) && Sleeping.exchange(0))
+                    WakeupSemaphore.Post();
+            }
+
             /**
              * Returns the pointer to a disk stream if the ordered disk stream
              * represented by the \a StreamOrderID was already activated by the disk
@@ -449,6 +569,19 @@ namespace LinuxSampler {
         protected:
             IM* pInstruments;   ///< The instrument resource manager of the engine that is using this disk thread. Used by the dimension region deletion feature.
 
+            /// Returns the amount of threads refilling the streams in parallel (including the disk thread itself).
+            int ReaderCount() const { return int(readers.size()); }
+
+            /**
+             * Returns the index (0 .. ReaderCount() - 1) of the thread
+             * refilling the given stream. Streams with the same source are
+             * always refilled by the same thread.
+             */
+            int ReaderOf(Stream* pStream) {
+                if (readers.size() < 2) return 0;
+                return int((size_t(pStream->GetSource()) >> 4) % readers.size());
+            }
+
         // #########################################################################
         // # Disk Thread Only Section
         // #         (following code should only be executed by the disk thread)
@@ -491,9 +624,8 @@ namespace LinuxSampler {
                     }
 
                     // if there are deletion commands, delete those streams
-                    while (Stream::UnusedStreams < Stream::TotalStreams && DeletionQueue->read_space() > 0) {
-                        delete_command_t command;
-                        DeletionQueue->pop(&command);
+                    delete_command_t command;
+                    while (Stream::UnusedStreams < Stream::TotalStreams && DeletionQueue->pop(&command)) {
                         DeleteStream(command);
                     }
 
@@ -527,14 +659,20 @@ namespace LinuxSampler {
                     RefillStreams(); // refill the most empty streams
 
                     // if nothing was done during this iteration (eg no streambuffer
-                    // filled with data) then sleep for 30ms
-                    if (IsIdle) usleep(30000);
-
-                    int streamsInUsage = 0;
-                    for (int i = Streams - 1; i >= 0; i--) {
-                        if (pStreams[i]->GetState() != Stream::state_unused) streamsInUsage++;
+                    // filled with data) then sleep until the audio thread wakes us
+                    // up (new stream orders or streams running low), at most 30ms
+                    if (IsIdle) {
+                        Sleeping.store(1);
+                        // orders which arrived before Sleeping was set didn't wake us
+                        if (!CreationQueue->read_space() && !ProgramChangeQueue.read_space())
+                            WakeupSemaphore.TimedWait(DISK_THREAD_IDLE_SLEEP);
+                        // if we timed out while a Wakeup() was just resetting the
+                        // flag, its post remains and merely ends the next sleep early
+                        Sleeping.store(0);
                     }
-                    SetActiveStreamCount(streamsInUsage);
+
+                    // the streams keep ActiveStreamCount up to date themselves
+                    const int streamsInUsage = GetActiveStreamCount();
                     if (streamsInUsage > ActiveStreamCountMax) ActiveStreamCountMax = streamsInUsage;
                 }
 
@@ -546,6 +684,7 @@ namespace LinuxSampler {
             void CreateAllStreams(int MaxStreams, uint BufferWrapElements) {
                 for (int i = 0; i < MaxStreams; i++) {
                     pStreams[i] = CreateStream(CONFIG_STREAM_BUFFER_SIZE, BufferWrapElements);
+                    pStreams[i]->pActiveStreamCount = &ActiveStreamCount;
                 }
             }
 
@@ -123,12 +123,56 @@ namespace LinuxSampler {
          * @returns next envelope level
          */
         float processPow() {
-            // TODO: this could be optimised by a pow approximation
+            // powf() is kept on purpose: a frexpf()/ldexpf() based pow
+            // approximation measured slower than glibc's powf() here
             Level = Offset + Coeff * powf(X, Exp);
             X += XDelta;
             return Level;
         }
 
+        /**
+         * Renders the next \a n levels of the current envelope segment at
+         * once, without advancing the envelope. \a pOut[k] is the level
+         * which the (k+1)th subsequent processLin(), processExp() or
+         * processPow() call would return, or the current level if the
+         * envelope reached its final end state. The envelope has to be
+         * advanced by calling advance() with each level actually used, since
+         * events might alter the envelope before the whole block is used.
+         */
+        void render(float* pOut, uint n) const {
+            switch (Segment) {
+                case segment_lin:
+                    for (uint k = 0; k < n; ++k)
+                        pOut[k] = Level + Coeff * float(k + 1);
+                    break;
+                case segment_exp: {
+                    float level = Level;
+                    for (uint k = 0; k < n; ++k)
+                        pOut[k] = level = level * Coeff + Offset;
+                    break;
+                }
+                case segment_pow: {
+                    float x = X;
+                    for (uint k = 0; k < n; ++k, x += XDelta)
+                        pOut[k] = Offset + Coeff * powf(x, Exp);
+                    break;
+                }
+                case segment_end:
+                    for (uint k = 0; k < n; ++k)
+                        pOut[k] = Level;
+                    break;
+            }
+        }
+
+        /**
+         * Advances the envelope by one step to \a level, which has to be
+         * the respective level rendered by render().
+         */
+        void advance(float level) {
+            Level = level;
+            if (Segment == segment_pow) X += XDelta;
+        }
+
         /**
          * Returns current envelope level without modifying anything. This
          * might be needed once the envelope reached its final end state,
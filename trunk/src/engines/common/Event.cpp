@@ -62,6 +62,29 @@ namespace LinuxSampler {
         // store amount of samples to process for the next cycle
         uiSamplesProcessed = SamplesToProcess;
     }
+
+    /**
+     * Returns the real time elapsed since the beginning of the current audio
+     * fragment cycle in relation to the real time duration of the previous
+     * cycle. So a value of 1.0 means the current cycle already took as long
+     * as the audio device allows for one cycle.
+     */
+    float EventGenerator::fragmentLoad() const {
+        const time_stamp_t fragmentDuration = FragmentTime.end - FragmentTime.begin;
+        if (!fragmentDuration) return 0.0f;
+        return float(RTMath::CreateTimeStamp() - FragmentTime.end) / float(fragmentDuration);
+    }
+
+    /**
+     * Returns the given real time duration (i.e. the difference of two
+     * RTMath::CreateTimeStamp() values) in relation to the real time duration
+     * of the previous audio fragment cycle.
+     */
+    float EventGenerator::fragmentRatio(RTMath::time_stamp_t Duration) const {
+        const time_stamp_t fragmentDuration = FragmentTime.end - FragmentTime.begin;
+        if (!fragmentDuration) return 0.0f;
+        return float(Duration) / float(fragmentDuration);
+    }
     
     /**
      * Get the next scheduled MIDI event (the one with the lowest time value)
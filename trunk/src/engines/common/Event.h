@@ -84,6 +84,9 @@ namespace LinuxSampler {
                 return uiTotalSamplesProcessed + uiSamplesProcessed;
             }
 
+            float fragmentLoad() const;
+            float fragmentRatio(RTMath::time_stamp_t Duration) const;
+
         protected:
             typedef RTMath::time_stamp_t time_stamp_t;
             inline int32_t ToFragmentPos(time_stamp_t TimeStamp) {
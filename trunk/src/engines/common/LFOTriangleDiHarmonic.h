@@ -62,6 +62,14 @@ namespace LinuxSampler {
                     return (real1 + real2 * AMP2) * normalizer;
             }
 
+            /**
+             * Renders the next \a n sample points of the LFO wave at once,
+             * the same as calling render() \a n times.
+             */
+            inline void render(float* pOut, unsigned int n) {
+                for (unsigned int k = 0; k < n; ++k) pOut[k] = render();
+            }
+
             /**
              * Update LFO depth with a new external controller value.
              *
@@ -54,6 +54,21 @@ namespace LinuxSampler {
                 else /* signed range */
                     return this->normalizer * (float) (abs(this->iLevel)) + this->offset;
             }
+
+            /**
+             * Renders the next \a n sample points of the LFO wave at once,
+             * the same as calling render() \a n times.
+             */
+            inline void render(float* pOut, unsigned int n) {
+                const float norm = this->normalizer;
+                const float offs = (RANGE == range_unsigned) ? 0.0f : this->offset;
+                int level = this->iLevel;
+                for (unsigned int k = 0; k < n; ++k) {
+                    level += this->c;
+                    pOut[k] = norm * (float) (abs(level)) + offs;
+                }
+                this->iLevel = level;
+            }
     };
 
 } // namespace LinuxSampler
@@ -57,6 +57,23 @@ namespace LinuxSampler {
                     return normalizer * (float) (iSign * iLevel) + offset;
             }
 
+            /**
+             * Renders the next \a n sample points of the LFO wave at once,
+             * the same as calling render() \a n times.
+             */
+            inline void render(float* pOut, unsigned int n) {
+                const int signshifts = (sizeof(int) * 8) - 1;
+                const float norm = normalizer;
+                const float offs = (RANGE == range_unsigned) ? 0.0f : offset;
+                int level = iLevel;
+                for (unsigned int k = 0; k < n; ++k) {
+                    level += c;
+                    const int iSign = (level >> signshifts) | 1;
+                    pOut[k] = norm * (float) (iSign * level) + offs;
+                }
+                iLevel = level;
+            }
+
             /**
              * Update LFO depth with a new external controller value.
              *
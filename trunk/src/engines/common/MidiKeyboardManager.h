@@ -25,6 +25,7 @@
 #ifndef __LS_MIDIKEYBOARDMANAGER_H__
 #define __LS_MIDIKEYBOARDMANAGER_H__
 
+#include <math.h>
 #include "Event.h"
 #include "Stream.h"
 #include "../../EventListeners.h"
@@ -32,6 +33,9 @@
 #include "../../common/global_private.h"
 #include "Note.h"
 
+/// Amount of buckets of the victim order for voice stealing (one per 6 dB of output level for voice_steal_algo_quietest, see MidiKeyboardManager::StealOrder).
+#define VOICE_STEAL_BUCKETS 24
+
 namespace LinuxSampler {
 
     /**
@@ -149,16 +153,6 @@ namespace LinuxSampler {
     template <class V>
     class MidiKeyboardManager : public MidiKeyboardManagerBase {
         public:
-            /** @brief Voice Stealing Algorithms
-             *
-             * Enumeration of all possible voice stealing algorithms.
-             */
-            enum voice_steal_algo_t {
-                voice_steal_algo_none,              ///< Voice stealing disabled.
-                voice_steal_algo_oldestvoiceonkey,  ///< Try to kill the oldest voice from same key where the new voice should be spawned.
-                voice_steal_algo_oldestkey          ///< Try to kill the oldest voice from the oldest active key.
-            };
-
 
             /** @brief MIDI key runtime informations
              *
@@ -207,6 +201,40 @@ namespace LinuxSampler {
             typedef typename RTList<V>::Iterator RTListVoiceIterator;
             typedef typename Pool<V>::Iterator PoolVoiceIterator;
 
+            /** @brief Victim order for voice stealing
+             *
+             * Used by the voice stealing algorithms which have to compare
+             * all voices of an engine channel (voice_steal_algo_quietest and
+             * voice_steal_algo_oldestreleased). Instead of comparing the
+             * voices on a theft, the engine channel keeps its voices in
+             * buckets, which are updated whenever the voices were rendered
+             * (see UpdateStealOrder()):
+             *
+             * - quietest: one bucket per 6 dB of output level, the victim is
+             *   the first voice of the quietest non empty bucket
+             * - oldestreleased: a single bucket, which voices join as soon as
+             *   they entered their release stage, thus ordered by release time
+             *
+             * Each bucket is an intrusive list of voices (linked by
+             * AbstractVoice::pStealNext), so updating a voice and selecting
+             * a victim take constant time and never allocate memory.
+             */
+            class StealOrder {
+                public:
+                    V*                 First[VOICE_STEAL_BUCKETS];
+                    V*                 Last[VOICE_STEAL_BUCKETS];
+                    voice_steal_algo_t Algo; ///< Voice stealing algorithm the buckets are currently maintained for.
+
+                    StealOrder() { Reset(); }
+
+                    /// Empties all buckets without accessing the voices (which must be unlinked otherwise, see AbstractVoice::Trigger()).
+                    void Reset() {
+                        for (int i = 0; i < VOICE_STEAL_BUCKETS; i++)
+                            First[i] = Last[i] = NULL;
+                        Algo = voice_steal_algo_none;
+                    }
+            };
+
             /**
              * Override this class to iterate through all active keys/voices
              * using ProcessActiveVoices() method.
@@ -269,6 +297,8 @@ namespace LinuxSampler {
 
                 // free all active keys
                 pActiveKeys->clear();
+
+                ClearStealOrder();
             }
 
             void AllocateActiveNotesLists(Pool< Note<V> >* pNotePool, Pool<V>* pVoicePool) {
@@ -352,6 +382,8 @@ namespace LinuxSampler {
                         }
                     }
 
+                    if (itVoice->StealBucket >= 0) UnlinkFromStealOrder(&*itVoice);
+
                     // free the voice object
                     m_voicePool->free(itVoice);
                 }
@@ -419,9 +451,36 @@ namespace LinuxSampler {
                 RTList<uint>::Iterator*  LastStolenKey
             ) {
                 RTListVoiceIterator itSelectedVoice;
+                const voice_steal_algo_t algo = m_engineChannel->GetVoiceStealAlgorithm();
 
                 // Select one voice for voice stealing
-                switch (CONFIG_VOICE_STEAL_ALGO) {
+                switch (algo) {
+
+                    // pick the voice with the lowest output level, or the
+                    // voice which entered its release stage first, from the
+                    // victim order; if there is no released voice left, then
+                    // proceed with 'oldestvoiceonkey' algorithm
+                    case voice_steal_algo_quietest:
+                    case voice_steal_algo_oldestreleased: {
+                        if (stealOrder.Algo == algo) {
+                            for (int i = VOICE_STEAL_BUCKETS - 1; i >= 0; i--) {
+                                // victims leave the order, so do voices which
+                                // are not stealable (they are added again by
+                                // the next update if they still are active)
+                                while (V* pVoice = stealOrder.First[i]) {
+                                    UnlinkFromStealOrder(pVoice);
+                                    if (pVoice->IsStealable()) {
+                                        itSelectedVoice = m_voicePool->fromPtr(pVoice);
+                                        goto voiceFound; // selection succeeded
+                                    }
+                                }
+                            }
+                        }
+                        if (algo == voice_steal_algo_quietest) {
+                            itSelectedVoice = RTListVoiceIterator();
+                            break; // no stealable voice left on this channel
+                        }
+                    } // no break - intentional !
 
                     // try to pick the oldest voice on the key where the new
                     // voice should be spawned, if there is no voice on that
@@ -524,6 +583,56 @@ namespace LinuxSampler {
                 return 0;
             }
 
+            /**
+             * Moves the given voice of this engine channel to the bucket of
+             * the victim order which reflects its current state (see
+             * StealOrder). Must be called on the real-time thread for each
+             * active voice after it was rendered.
+             */
+            void UpdateStealOrder(V* pVoice) {
+                const voice_steal_algo_t algo = m_engineChannel->GetVoiceStealAlgorithm();
+                if (algo != stealOrder.Algo) ResetStealOrder(algo);
+                // voices which are already fading out will die anyway
+                if (pVoice->IsFadingOut()) {
+                    if (pVoice->StealBucket >= 0) UnlinkFromStealOrder(pVoice);
+                    return;
+                }
+                int bucket;
+                switch (algo) {
+                    case voice_steal_algo_quietest: {
+                        // 6 dB per bucket, the quietest ones in the last bucket
+                        const float fLevel = pVoice->GetOutputLevel();
+                        int exponent = -VOICE_STEAL_BUCKETS;
+                        if (fLevel > 0.0f) frexpf(fLevel, &exponent);
+                        bucket = RTMath::Max(0, RTMath::Min(-exponent, VOICE_STEAL_BUCKETS - 1));
+                        break;
+                    }
+                    case voice_steal_algo_oldestreleased:
+                        if (!pVoice->IsReleased()) return;
+                        bucket = 0;
+                        break;
+                    default:
+                        return;
+                }
+                if (pVoice->StealBucket == bucket) return;
+                if (pVoice->StealBucket >= 0) UnlinkFromStealOrder(pVoice);
+                // append to the bucket
+                pVoice->StealBucket = bucket;
+                pVoice->pStealPrev  = stealOrder.Last[bucket];
+                pVoice->pStealNext  = NULL;
+                if (stealOrder.Last[bucket]) stealOrder.Last[bucket]->pStealNext = pVoice;
+                else                         stealOrder.First[bucket] = pVoice;
+                stealOrder.Last[bucket] = pVoice;
+            }
+
+            /**
+             * Forgets the victim order for voice stealing without accessing
+             * its voices, e.g. because the voice pool is reallocated.
+             */
+            void ClearStealOrder() {
+                stealOrder.Reset();
+            }
+
             /**
              * Releases all voices. All voices will go into
              * the release stage and thus it might take some time (e.g. dependant to
@@ -783,6 +892,26 @@ namespace LinuxSampler {
             AbstractEngineChannel* m_engineChannel;
             Pool<V>* m_voicePool;
 
+            StealOrder stealOrder; ///< Victim order of this engine channel's voices (only for the voice stealing algorithms which need it).
+
+            void UnlinkFromStealOrder(V* pVoice) {
+                V* pPrev = static_cast<V*>(pVoice->pStealPrev);
+                V* pNext = static_cast<V*>(pVoice->pStealNext);
+                if (pPrev) pPrev->pStealNext = pNext;
+                else       stealOrder.First[pVoice->StealBucket] = pNext;
+                if (pNext) pNext->pStealPrev = pPrev;
+                else       stealOrder.Last[pVoice->StealBucket] = pPrev;
+                pVoice->pStealPrev  = pVoice->pStealNext = NULL;
+                pVoice->StealBucket = -1;
+            }
+
+            /// Empties the victim order and maintains it for the given algorithm from now on.
+            void ResetStealOrder(voice_steal_algo_t algo) {
+                for (int i = 0; i < VOICE_STEAL_BUCKETS; i++)
+                    while (stealOrder.First[i]) UnlinkFromStealOrder(stealOrder.First[i]);
+                stealOrder.Algo = algo;
+            }
+
             class Listeners : public MidiKeyboardListener, public ListenerList<MidiKeyboardListener*> {
             public:
                 REGISTER_FIRE_EVENT_METHOD_ARG2(PreProcessNoteOn, uint8_t, uint8_t)
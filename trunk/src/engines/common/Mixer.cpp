@@ -0,0 +1,62 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#include "Mixer.h"
+
+#if HAVE_GCC_VECTOR_EXTENSIONS
+# define MIXER_KERNEL_SIMD(RAMP,LEFT,RIGHT) &Mixer::MixSIMD<RAMP,LEFT,RIGHT>
+#else
+# define MIXER_KERNEL_SIMD(RAMP,LEFT,RIGHT) &Mixer::MixCPP<RAMP,LEFT,RIGHT>
+#endif
+
+namespace LinuxSampler {
+
+    // nothing to be mixed (voice is silent on both channels)
+    static void MixNone(const float* pSrcL, const float* pSrcR, float* pDstL, float* pDstR, uint uiSamples, float& fVolumeL, float& fVolumeR, const float fDeltaL, const float fDeltaR) {
+    }
+
+    // mixer kernels, indexed by mixer mode
+    static MixFunction_Fn* const mixFunctions[16] = {
+        &MixNone,                       // 0x00
+        &MixNone,                       // 0x01
+        &Mixer::MixCPP<false,true,false>, // 0x02
+        &Mixer::MixCPP<true,true,false>,  // 0x03
+        &Mixer::MixCPP<false,false,true>, // 0x04
+        &Mixer::MixCPP<true,false,true>,  // 0x05
+        &Mixer::MixCPP<false,true,true>,  // 0x06
+        &Mixer::MixCPP<true,true,true>,   // 0x07
+        &MixNone,                       // 0x08
+        &MixNone,                       // 0x09
+        MIXER_KERNEL_SIMD(false,true,false), // 0x0a
+        MIXER_KERNEL_SIMD(true,true,false),  // 0x0b
+        MIXER_KERNEL_SIMD(false,false,true), // 0x0c
+        MIXER_KERNEL_SIMD(true,false,true),  // 0x0d
+        MIXER_KERNEL_SIMD(false,true,true),  // 0x0e
+        MIXER_KERNEL_SIMD(true,true,true)    // 0x0f
+    };
+
+    MixFunction_Fn* Mixer::GetMixFunction(const int MixerMode) {
+        return mixFunctions[MixerMode & 0x0f];
+    }
+
+} // namespace LinuxSampler
@@ -0,0 +1,174 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_MIXER_H__
+#define __LS_MIXER_H__
+
+#include "../../common/global_private.h"
+
+/**
+ * Size (in sample points) of the scratch blocks a voice renders its audio
+ * signal to, before it is mixed to the output channels. Must be a multiple
+ * of 4.
+ */
+#define MIXER_BLOCK_SIZE 32
+
+#define MIXER_MODE_SET_RAMP(iMode,bVal)             { if (bVal) iMode |= 0x01; else iMode &= ~0x01; }   /* (un)set mode bit 0 */
+#define MIXER_MODE_SET_LEFT(iMode,bVal)             { if (bVal) iMode |= 0x02; else iMode &= ~0x02; }   /* (un)set mode bit 1 */
+#define MIXER_MODE_SET_RIGHT(iMode,bVal)            { if (bVal) iMode |= 0x04; else iMode &= ~0x04; }   /* (un)set mode bit 2 */
+#define MIXER_MODE_SET_IMPLEMENTATION(iMode,bVal)   { if (bVal) iMode |= 0x08; else iMode &= ~0x08; }   /* (un)set mode bit 3 */
+
+#define MIXER_MODE_GET_RAMP(iMode)                  (iMode & 0x01)
+#define MIXER_MODE_GET_LEFT(iMode)                  (iMode & 0x02)
+#define MIXER_MODE_GET_RIGHT(iMode)                 (iMode & 0x04)
+#define MIXER_MODE_GET_IMPLEMENTATION(iMode)        (iMode & 0x08)
+
+namespace LinuxSampler {
+
+    /**
+     * Scratch block a voice renders (a part of) its audio signal to, before
+     * it is mixed to the output channels. If GCC vector extensions are
+     * available, the block is 16 byte aligned.
+     */
+    union mixer_block_t {
+#if HAVE_GCC_VECTOR_EXTENSIONS
+        v4sf  v[MIXER_BLOCK_SIZE / 4];
+#endif
+        float f[MIXER_BLOCK_SIZE];
+    };
+
+    /**
+     * Mixer kernel, as returned by Mixer::GetMixFunction(). Applies the
+     * (linear ramp of the) volume on the given block of sample points and
+     * adds the result to the given output buffers. Starting from
+     * @a fVolumeL and @a fVolumeR, the volume is increased by @a fDeltaL
+     * and @a fDeltaR with each sample point. On return, @a fVolumeL and
+     * @a fVolumeR reflect the volume of the last sample point.
+     *
+     * For mono voices, @a pSrcL and @a pSrcR may point to the same buffer.
+     * The source buffers have to be 16 byte aligned (i.e. a mixer_block_t),
+     * the output buffers may be unaligned.
+     *
+     * @param pSrcL     - left channel signal of the voice
+     * @param pSrcR     - right channel signal of the voice
+     * @param pDstL     - left output buffer (signal is added to)
+     * @param pDstR     - right output buffer (signal is added to)
+     * @param uiSamples - amount of sample points to be mixed
+     */
+    typedef void MixFunction_Fn(const float* pSrcL, const float* pSrcR, float* pDstL, float* pDstR, uint uiSamples, float& fVolumeL, float& fVolumeR, const float fDeltaL, const float fDeltaR);
+
+    /** @brief Mixes voice output to the audio output channels
+     *
+     * Implements the final stage of the synthesis of a voice, which is
+     * shared by all engines: applying the voice's volume (ramp) on the
+     * rendered audio signal and adding it to the buffers of the left and
+     * right output channel.
+     *
+     * The actual mixer kernel is selected by the voice for each subfragment
+     * (see GetMixFunction()), depending on whether the volume changes at
+     * all within the subfragment and whether the voice is audible on both
+     * output channels (i.e. not hard panned), so those decisions are not
+     * made for each sample point.
+     */
+    class Mixer {
+    public:
+        /**
+         * Returns the mixer kernel for the given mixer mode, which is a
+         * combination of the MIXER_MODE_SET_* bits.
+         */
+        static MixFunction_Fn* GetMixFunction(const int MixerMode);
+
+        /**
+         * Scalar implementation of the mixer kernels.
+         *
+         * @param RAMP  - whether the volume changes within the block
+         * @param LEFT  - whether anything has to be mixed to the left output
+         * @param RIGHT - whether anything has to be mixed to the right output
+         */
+        template<bool RAMP, bool LEFT, bool RIGHT>
+        static void MixCPP(const float* pSrcL, const float* pSrcR, float* pDstL, float* pDstR, uint uiSamples, float& fVolumeL, float& fVolumeR, const float fDeltaL, const float fDeltaR) {
+            float volL = fVolumeL;
+            float volR = fVolumeR;
+            for (uint i = 0; i < uiSamples; ++i) {
+                if (RAMP) {
+                    volL += fDeltaL;
+                    volR += fDeltaR;
+                }
+                if (LEFT)  pDstL[i] += pSrcL[i] * volL;
+                if (RIGHT) pDstR[i] += pSrcR[i] * volR;
+            }
+            fVolumeL = volL;
+            fVolumeR = volR;
+        }
+
+#if HAVE_GCC_VECTOR_EXTENSIONS
+        /**
+         * Vector implementation of the mixer kernels. The remaining
+         * (uiSamples % 4) sample points are mixed by the scalar
+         * implementation.
+         */
+        template<bool RAMP, bool LEFT, bool RIGHT>
+        static void MixSIMD(const float* pSrcL, const float* pSrcR, float* pDstL, float* pDstR, uint uiSamples, float& fVolumeL, float& fVolumeR, const float fDeltaL, const float fDeltaR) {
+            const uint uiBlocks = uiSamples >> 2;
+            if (uiBlocks) {
+                const v4sf* srcL = (const v4sf*) pSrcL;
+                const v4sf* srcR = (const v4sf*) pSrcR;
+                v4sf_unaligned* dstL = (v4sf_unaligned*) pDstL;
+                v4sf_unaligned* dstR = (v4sf_unaligned*) pDstR;
+                v4sf_cells volL, volR;
+                if (RAMP) {
+                    const v4sf ramp  = { 1.0f, 2.0f, 3.0f, 4.0f };
+                    const v4sf stepL = { 4.0f * fDeltaL, 4.0f * fDeltaL, 4.0f * fDeltaL, 4.0f * fDeltaL };
+                    const v4sf stepR = { 4.0f * fDeltaR, 4.0f * fDeltaR, 4.0f * fDeltaR, 4.0f * fDeltaR };
+                    volL.v = (v4sf) { fVolumeL, fVolumeL, fVolumeL, fVolumeL } + ramp * (v4sf) { fDeltaL, fDeltaL, fDeltaL, fDeltaL };
+                    volR.v = (v4sf) { fVolumeR, fVolumeR, fVolumeR, fVolumeR } + ramp * (v4sf) { fDeltaR, fDeltaR, fDeltaR, fDeltaR };
+                    for (uint b = 0; b < uiBlocks; ++b) {
+                        if (LEFT)  dstL[b] += srcL[b] * volL.v;
+                        if (RIGHT) dstR[b] += srcR[b] * volR.v;
+                        volL.v += stepL;
+                        volR.v += stepR;
+                    }
+                    // volume of the last mixed sample point
+                    fVolumeL = volL.f[3] - 4.0f * fDeltaL;
+                    fVolumeR = volR.f[3] - 4.0f * fDeltaR;
+                } else {
+                    volL.v = (v4sf) { fVolumeL, fVolumeL, fVolumeL, fVolumeL };
+                    volR.v = (v4sf) { fVolumeR, fVolumeR, fVolumeR, fVolumeR };
+                    for (uint b = 0; b < uiBlocks; ++b) {
+                        if (LEFT)  dstL[b] += srcL[b] * volL.v;
+                        if (RIGHT) dstR[b] += srcR[b] * volR.v;
+                    }
+                }
+            }
+            const uint uiDone = uiBlocks << 2;
+            MixCPP<RAMP,LEFT,RIGHT>(
+                pSrcL + uiDone, pSrcR + uiDone, pDstL + uiDone, pDstR + uiDone,
+                uiSamples & 3, fVolumeL, fVolumeR, fDeltaL, fDeltaR
+            );
+        }
+#endif // HAVE_GCC_VECTOR_EXTENSIONS
+    };
+
+} // namespace LinuxSampler
+
+#endif // __LS_MIXER_H__
@@ -56,6 +56,21 @@ namespace LinuxSampler {
                     return uiLevel <= width ? normalizer : -normalizer;
             }
 
+            /**
+             * Renders the next \a n sample points of the LFO wave at once,
+             * the same as calling render() \a n times.
+             */
+            inline void render(float* pOut, unsigned int n) {
+                const float high = normalizer;
+                const float low  = (RANGE == range_unsigned) ? 0.0f : -normalizer;
+                unsigned int level = uiLevel;
+                for (unsigned int k = 0; k < n; ++k) {
+                    level += c;
+                    pOut[k] = level <= width ? high : low;
+                }
+                uiLevel = level;
+            }
+
             /**
              * Update LFO depth with a new external controller value.
              *
@@ -0,0 +1,87 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston,                *
+ *   MA  02110-1301  USA                                                   *
+ ***************************************************************************/
+
+#include "Resampler.h"
+
+/// Cutoff frequency of the windowed sinc filter, relative to the Nyquist frequency.
+#define SINC_INTERPOLATION_CUTOFF   0.9
+/// Kaiser window shape parameter (higher values: more stopband attenuation, but wider transition band).
+#define SINC_INTERPOLATION_BETA     8.0
+
+namespace LinuxSampler {
+
+#if HAVE_GCC_VECTOR_EXTENSIONS
+    // aligned, to allow the compiler to vectorize the filter tap loops
+    float SincTable::coefficients[SINC_INTERPOLATION_PHASES + 1][SINC_INTERPOLATION_TAPS] __attribute__ ((aligned(16)));
+#else
+    float SincTable::coefficients[SINC_INTERPOLATION_PHASES + 1][SINC_INTERPOLATION_TAPS];
+#endif
+
+    SincTable SincTable::instance;
+
+    /**
+     * Zeroth order modified Bessel function of the first kind (power series),
+     * needed for calculating the Kaiser window.
+     */
+    static double besselI0(double x) {
+        double sum  = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 50; ++k) {
+            const double t = x / (2.0 * k);
+            term *= t * t;
+            sum  += term;
+            if (term < sum * 1e-12) break;
+        }
+        return sum;
+    }
+
+    /**
+     * Calculates the polyphase filter coefficients. Tap i of phase p is the
+     * value of the windowed sinc function at the distance between the
+     * source sample point i and the interpolation point, which lies
+     * p / SINC_INTERPOLATION_PHASES sample points behind the source sample
+     * point INTERPOLATION_PRE_ROLL. Each row is normalized to
+     * unity gain, to avoid any amplitude modulation when the phase changes.
+     */
+    SincTable::SincTable() {
+        const double halfWidth = SINC_INTERPOLATION_TAPS / 2;
+        const double fc = SINC_INTERPOLATION_CUTOFF;
+        const double i0beta = besselI0(SINC_INTERPOLATION_BETA);
+        for (int p = 0; p <= SINC_INTERPOLATION_PHASES; ++p) {
+            const double fract = double(p) / SINC_INTERPOLATION_PHASES;
+            double sum = 0.0;
+            double row[SINC_INTERPOLATION_TAPS];
+            for (int i = 0; i < SINC_INTERPOLATION_TAPS; ++i) {
+                const double x = double(i) - INTERPOLATION_PRE_ROLL - fract;
+                const double sinc = (x == 0.0) ? 1.0 : sin(M_PI * fc * x) / (M_PI * fc * x);
+                const double u = x / halfWidth;
+                const double window = (u * u < 1.0) ? besselI0(SINC_INTERPOLATION_BETA * sqrt(1.0 - u * u)) / i0beta : 0.0;
+                row[i] = sinc * window;
+                sum += row[i];
+            }
+            for (int i = 0; i < SINC_INTERPOLATION_TAPS; ++i)
+                coefficients[p][i] = float(row[i] / sum);
+        }
+    }
+
+} // namespace LinuxSampler
@@ -21,19 +21,32 @@
  *   MA  02111-1307  USA                                                   *
  ***************************************************************************/
 
-// Note: the assembly code is currently disabled, as it doesn't fit into
-// the new synthesis core introduced by LS 0.4.0
-
 #ifndef __LS_RESAMPLER_H__
 #define __LS_RESAMPLER_H__
 
 #include "../../common/global_private.h"
+#include "../EngineChannel.h"
 
-// TODO: cubic interpolation is not yet supported by the MMX/SSE(1) version though
 #ifndef USE_LINEAR_INTERPOLATION
-# define USE_LINEAR_INTERPOLATION   1  ///< set to 0 if you prefer cubic interpolation (slower, better quality)
+# define USE_LINEAR_INTERPOLATION   1  ///< set to 0 if you prefer cubic interpolation as default interpolation algorithm (slower, better quality)
+#endif
+
+#if USE_LINEAR_INTERPOLATION
+# define DEFAULT_INTERPOLATION      interpolation_linear
+#else
+# define DEFAULT_INTERPOLATION      interpolation_cubic
 #endif
 
+#ifndef SINC_INTERPOLATION_TAPS
+# define SINC_INTERPOLATION_TAPS    16 ///< amount of source sample points (filter taps) the windowed sinc interpolation takes into account for each output sample point (must be a multiple of 4)
+#endif
+#define SINC_INTERPOLATION_PHASES   256 ///< amount of sub-sample phases precomputed by the polyphase windowed sinc table
+
+/// Maximum amount of sample points the interpolation algorithms read ahead of the current playback position.
+#define MAX_INTERPOLATION_READ_AHEAD (SINC_INTERPOLATION_TAPS - 1)
+/// Amount of sample points the playback position of the synthesis core lags behind the sample point actually heard (see Resampler).
+#define INTERPOLATION_PRE_ROLL      (SINC_INTERPOLATION_TAPS / 2 - 1)
+
 namespace LinuxSampler {
 
     /** @brief Stereo sample point
@@ -46,19 +59,64 @@ namespace LinuxSampler {
         float right;
     };
 
+    /** @brief Polyphase windowed sinc table
+     *
+     * Provides the precomputed (Kaiser windowed) sinc filter coefficients
+     * for the windowed sinc interpolation of the Resampler. For each of the
+     * SINC_INTERPOLATION_PHASES sub-sample phases (plus one additional
+     * phase for interpolating between the last phase and the next sample
+     * point) the table provides one row of SINC_INTERPOLATION_TAPS filter
+     * coefficients. The table is calculated once when the library is
+     * loaded.
+     */
+    class SincTable {
+        public:
+            /**
+             * Returns the filter coefficients for the given sub-sample
+             * @a phase (0 .. SINC_INTERPOLATION_PHASES).
+             */
+            inline static const float* Row(int phase) {
+                return coefficients[phase];
+            }
+
+        private:
+            SincTable();
+            static float coefficients[SINC_INTERPOLATION_PHASES + 1][SINC_INTERPOLATION_TAPS];
+            static SincTable instance;
+    };
+
     /** @brief Resampler Template
      *
-     * This template provides pure C++ and MMX/SSE assembly implementations
-     * for linear and cubic interpolation for pitching a mono or stereo
-     * input signal.
+     * This template provides pure C++ and SIMD (GCC vector extension)
+     * implementations for linear, cubic and windowed sinc interpolation for
+     * pitching a mono or stereo input signal. The interpolation algorithm
+     * is selected by the ALGO template parameter of the respective
+     * interpolation methods, so the caller has to dispatch between the
+     * algorithms outside of its sample point loop.
+     *
+     * The source sample points are either 16 bit integers, packed 24 bit
+     * integers (if @a BITDEPTH24 is true) or aligned 32 bit integers (if
+     * @a BITDEPTH32 is true, see CONFIG_32BIT_SAMPLES).
+     *
+     * All algorithms only read ahead of the playback position, so disk
+     * stream ring buffers never have to keep already consumed sample points.
+     * The windowed sinc filter however needs INTERPOLATION_PRE_ROLL source
+     * sample points before the interpolation point, so all algorithms (and
+     * the non-interpolating case as well) interpolate at the position
+     * (pos + INTERPOLATION_PRE_ROLL) instead. The caller therefore has to
+     * start playback INTERPOLATION_PRE_ROLL sample points before the actual
+     * start position and has to move loop points the same way, which keeps
+     * the output in time with the sample and allows switching between the
+     * algorithms while a voice is playing. Sample points before the sample
+     * start are silence and have to be provided by the caller.
      */
-    template<bool INTERPOLATE,bool BITDEPTH24>
+    template<bool INTERPOLATE,bool BITDEPTH24,bool BITDEPTH32>
     class Resampler {
         public:
             inline static float GetNextSampleMonoCPP(sample_t* __restrict pSrc, double* __restrict Pos, float& Pitch) {
                 if (INTERPOLATE) return Interpolate1StepMonoCPP(pSrc, Pos, Pitch);
                 else { // no pitch, so no interpolation necessary
-                    int pos_int = (int) *Pos;
+                    int pos_int = (int) *Pos + INTERPOLATION_PRE_ROLL;
                     *Pos += 1.0;
                     return pSrc [pos_int];
                 }
@@ -67,7 +125,7 @@ namespace LinuxSampler {
             inline static stereo_sample_t GetNextSampleStereoCPP(sample_t* __restrict pSrc, double* __restrict Pos, float& Pitch) {
                 if (INTERPOLATE) return Interpolate1StepStereoCPP(pSrc, Pos, Pitch);
                 else { // no pitch, so no interpolation necessary
-                    int pos_int = (int) *Pos;
+                    int pos_int = (int) *Pos + INTERPOLATION_PRE_ROLL;
                     pos_int <<= 1;
                     *Pos += 1.0;
                     stereo_sample_t samplePoint;
@@ -77,80 +135,14 @@ namespace LinuxSampler {
                 }
             }
 
-#if 0 // CONFIG_ASM && ARCH_X86
-            inline static void GetNext4SamplesMonoMMXSSE(sample_t* pSrc, void* Pos, float& Pitch) {
-                if (INTERPOLATE) Interpolate4StepsMonoMMXSSE(pSrc, Pos, Pitch);
-                else { // no pitch, so no interpolation necessary
-                    const float __4f = 4.0f;
-                    __asm__ __volatile__ (
-                        "movss    (%1), %%xmm5           # load Pos\n\t"
-                        "cvtss2si %%xmm5, %%edi          # int(Pos)\n\t"
-                        "addss    %2, %%xmm5             # Pos += 4.0f\n\t"
-                        "movswl   (%0,%%edi,2), %%eax    # load sample 0\n\t"
-                        "cvtsi2ss  %%eax, %%xmm2         # convert to float\n\t"
-                        "shufps    $0x93, %%xmm2, %%xmm2 # shift up\n\t"
-                        "movswl   2(%0,%%edi,2), %%edx   # load sample 1\n\t"
-                        "cvtsi2ss  %%edx, %%xmm2         # convert to float\n\t"
-                        "shufps    $0x93, %%xmm2, %%xmm2 # shift up\n\t"
-                        "movss     %%xmm5, (%1)          # update Pos\n\t"
-                        "movswl   4(%0,%%edi,2), %%eax   # load sample 2\n\t"
-                        "cvtsi2ss  %%eax, %%xmm2         # convert to float\n\t"
-                        "shufps    $0x93, %%xmm2, %%xmm2 # shift up\n\t"
-                        "movswl   6(%0,%%edi,2), %%edx   # load sample 3\n\t"
-                        "cvtsi2ss  %%edx, %%xmm2         # convert to float\n\t"
-                        "shufps    $0x1b, %%xmm2, %%xmm2 # swap to correct order\n\t"
-                        :: "r" (pSrc), "r" (Pos), "m" (__4f)
-                        :  "%eax", "%edx", "%edi"
-                    );
-                }
-            }
-
-            inline static void GetNext4SamplesStereoMMXSSE(sample_t* pSrc, void* Pos, float& Pitch) {
-                if (INTERPOLATE) {
-                    Interpolate4StepsStereoMMXSSE(pSrc, Pos, Pitch);
-                    //EMMS;
-                } else { // no pitch, so no interpolation necessary
-                    const float __4f = 4.0f;
-                    __asm__ __volatile__ (
-                        "movss    (%1), %%xmm5           # load Pos\n\t"
-                        "cvtss2si %%xmm5, %%edi          # int(Pos)\n\t"
-                        "addss    %2, %%xmm5             # Pos += 4.0f\n\t"
-                        "movswl    (%0, %%edi,4), %%eax  # load sample 0 (left)\n\t"
-                        "cvtsi2ss  %%eax, %%xmm2         # convert to float\n\t"
-                        "shufps    $0x93, %%xmm2, %%xmm2 # shift up\n\t"
-                        "movss     %%xmm5, (%1)          # update Pos\n\t"
-                        "movswl   2(%0, %%edi,4), %%edx  # load sample 0 (left)\n\t"
-                        "cvtsi2ss  %%edx, %%xmm3         # convert to float\n\t"
-                        "shufps    $0x93, %%xmm3, %%xmm3 # shift up\n\t"
-                        "movswl   4(%0, %%edi,4), %%eax  # load sample 1 (left)\n\t"
-                        "cvtsi2ss  %%eax, %%xmm2         # convert to float\n\t"
-                        "shufps    $0x93, %%xmm2, %%xmm2 # shift up\n\t"
-                        "movswl   6(%0, %%edi,4), %%edx  # load sample 1 (right)\n\t"
-                        "cvtsi2ss  %%edx, %%xmm3         # convert to float\n\t"
-                        "shufps    $0x93, %%xmm3, %%xmm3 # shift up\n\t"
-                        "movswl   8(%0, %%edi,4), %%eax  # load sample 2 (left)\n\t"
-                        "cvtsi2ss  %%eax, %%xmm2         # convert to float\n\t"
-                        "shufps    $0x93, %%xmm2, %%xmm2 # shift up\n\t"
-                        "movswl  10(%0, %%edi,4), %%edx  # load sample 2 (right)\n\t"
-                        "cvtsi2ss  %%edx, %%xmm3         # convert to float\n\t"
-                        "shufps    $0x93, %%xmm3, %%xmm3 # shift up\n\t"
-                        "movswl  12(%0, %%edi,4), %%eax  # load sample 3 (left)\n\t"
-                        "cvtsi2ss  %%eax, %%xmm2         # convert to float\n\t"
-                        "shufps    $0x1b, %%xmm2, %%xmm2 # swap to correct order\n\t"
-                        "movswl  14(%0, %%edi,4), %%edx  # load sample 3 (right)\n\t"
-                        "cvtsi2ss  %%edx, %%xmm3         # convert to float\n\t"
-                        "shufps    $0x1b, %%xmm3, %%xmm3 # swap to correct order\n\t"
-                        :: "r" (pSrc), "r" (Pos), "m" (__4f)
-                        :  "%eax", "%edx", "%edi"
-                    );
-                }
-            }
-#endif // CONFIG_ASM && ARCH_X86
-
         protected:
 
             inline static int32_t getSample(sample_t* __restrict src, int pos) {
-                if (BITDEPTH24) {
+                if (BITDEPTH32) {
+                    // already expanded to 32 bit (in native byte order) when
+                    // the sample was loaded, so a simple aligned read
+                    return ((int32_t*)src)[pos];
+                } else if (BITDEPTH24) {
                     pos *= 3;
                     #if WORDS_BIGENDIAN
                     unsigned char* p = (unsigned char*)src;
@@ -168,272 +160,283 @@ namespace LinuxSampler {
             inline static float Interpolate1StepMonoCPP(sample_t* __restrict pSrc, double* __restrict Pos, float& Pitch) {
                 int   pos_int   = (int) *Pos;     // integer position
                 float pos_fract = *Pos - pos_int; // fractional part of position
-
-                #if USE_LINEAR_INTERPOLATION
-                    int x1 = getSample(pSrc, pos_int);
-                    int x2 = getSample(pSrc, pos_int + 1);
-                    float samplePoint  = (x1 + pos_fract * (x2 - x1));
-                #else // polynomial interpolation
-                    float xm1 = getSample(pSrc, pos_int);
-                    float x0  = getSample(pSrc, pos_int + 1);
-                    float x1  = getSample(pSrc, pos_int + 2);
-                    float x2  = getSample(pSrc, pos_int + 3);
-                    float a   = (3.0f * (x0 - x1) - xm1 + x2) * 0.5f;
-                    float b   = 2.0f * x1 + xm1 - (5.0f * x0 + x2) * 0.5f;
-                    float c   = (x1 - xm1) * 0.5f;
-                    float samplePoint =  (((a * pos_fract) + b) * pos_fract + c) * pos_fract + x0;
-                #endif // USE_LINEAR_INTERPOLATION
-
                 *Pos += Pitch;
-                return samplePoint;
+                return InterpolateMono<DEFAULT_INTERPOLATION>(pSrc, pos_int, pos_fract);
             }
 
             inline static stereo_sample_t Interpolate1StepStereoCPP(sample_t* __restrict pSrc, double* __restrict Pos, float& Pitch) {
                 int   pos_int   = (int) *Pos;  // integer position
                 float pos_fract = *Pos - pos_int;     // fractional part of position
-                pos_int <<= 1;
+                *Pos += Pitch;
+                return InterpolateStereo<DEFAULT_INTERPOLATION>(pSrc, pos_int, pos_fract);
+            }
 
-                stereo_sample_t samplePoint;
+            /**
+             * Converts the given playback position (or pitch) to a 32.32
+             * fixed point number. Negative positions (at the beginning of
+             * the pre-roll, see INTERPOLATION_PRE_ROLL) are stored in two's
+             * complement, so the integer part is still yielded by the upper
+             * 32 bits.
+             */
+            inline static uint64_t PosToFixed(double pos) {
+                return uint64_t(int64_t(pos * 4294967296.0));
+            }
 
-                #if USE_LINEAR_INTERPOLATION
-                    // left channel
+            /**
+             * Converts the given 32.32 fixed point playback position back
+             * to a floating point position.
+             */
+            inline static double FixedToPos(uint64_t pos) {
+                return double(int64_t(pos)) * (1.0 / 4294967296.0);
+            }
+
+            /**
+             * Returns the fractional part of the given 32.32 fixed point
+             * playback position as float (in range 0.0 <= x < 1.0). Only the
+             * upper 24 bits of the fractional part are used, which is
+             * exactly the precision of a float and ensures the result is
+             * never rounded up to 1.0.
+             */
+            inline static float FixedFract(uint64_t pos) {
+                return float(uint32_t(pos) >> 8) * (1.0f / 16777216.0f);
+            }
+
+            /**
+             * Same as Interpolate1StepMonoCPP(), but uses a 32.32 fixed point
+             * phase accumulator as playback position instead of a double, so
+             * the integer and fractional part of the position can be
+             * extracted without any floating point to integer conversion.
+             */
+            template<interpolation_t ALGO>
+            inline static float Interpolate1StepMonoFixed(sample_t* __restrict pSrc, uint64_t& Phase, const uint64_t Increment) {
+                const int   pos_int   = int(Phase >> 32);
+                const float pos_fract = FixedFract(Phase);
+                Phase += Increment;
+                return InterpolateMono<ALGO>(pSrc, pos_int, pos_fract);
+            }
+
+            /**
+             * Same as Interpolate1StepStereoCPP(), but uses a 32.32 fixed
+             * point phase accumulator as playback position.
+             */
+            template<interpolation_t ALGO>
+            inline static stereo_sample_t Interpolate1StepStereoFixed(sample_t* __restrict pSrc, uint64_t& Phase, const uint64_t Increment) {
+                const int   pos_int   = int(Phase >> 32);
+                const float pos_fract = FixedFract(Phase);
+                Phase += Increment;
+                return InterpolateStereo<ALGO>(pSrc, pos_int, pos_fract);
+            }
+
+            template<interpolation_t ALGO>
+            inline static float InterpolateMono(sample_t* __restrict pSrc, int pos_int, float pos_fract) {
+                if (ALGO == interpolation_sinc) {
+                    return InterpolateSincMono(pSrc, pos_int, pos_fract);
+                }
+                pos_int += INTERPOLATION_PRE_ROLL;
+                if (ALGO == interpolation_cubic) { // polynomial interpolation
+                    float xm1 = getSample(pSrc, pos_int - 1);
+                    float x0  = getSample(pSrc, pos_int);
+                    float x1  = getSample(pSrc, pos_int + 1);
+                    float x2  = getSample(pSrc, pos_int + 2);
+                    float a   = (3.0f * (x0 - x1) - xm1 + x2) * 0.5f;
+                    float b   = 2.0f * x1 + xm1 - (5.0f * x0 + x2) * 0.5f;
+                    float c   = (x1 - xm1) * 0.5f;
+                    return (((a * pos_fract) + b) * pos_fract + c) * pos_fract + x0;
+                } else { // linear interpolation
                     int x1 = getSample(pSrc, pos_int);
-                    int x2 = getSample(pSrc, pos_int + 2);
-                    samplePoint.left  = (x1 + pos_fract * (x2 - x1));
-                    // right channel
-                    x1 = getSample(pSrc, pos_int + 1);
-                    x2 = getSample(pSrc, pos_int + 3);
-                    samplePoint.right = (x1 + pos_fract * (x2 - x1));
-                #else // polynomial interpolation
+                    int x2 = getSample(pSrc, pos_int + 1);
+                    return (x1 + pos_fract * (x2 - x1));
+                }
+            }
+
+            template<interpolation_t ALGO>
+            inline static stereo_sample_t InterpolateStereo(sample_t* __restrict pSrc, int pos_int, float pos_fract) {
+                stereo_sample_t samplePoint;
+
+                if (ALGO == interpolation_sinc) {
+                    return InterpolateSincStereo(pSrc, pos_int, pos_fract);
+                }
+                pos_int += INTERPOLATION_PRE_ROLL;
+                if (ALGO == interpolation_cubic) { // polynomial interpolation
+                    pos_int <<= 1;
+
                     // calculate left channel
-                    float xm1 = getSample(pSrc, pos_int);
-                    float x0  = getSample(pSrc, pos_int + 2);
-                    float x1  = getSample(pSrc, pos_int + 4);
-                    float x2  = getSample(pSrc, pos_int + 6);
+                    float xm1 = getSample(pSrc, pos_int - 2);
+                    float x0  = getSample(pSrc, pos_int);
+                    float x1  = getSample(pSrc, pos_int + 2);
+                    float x2  = getSample(pSrc, pos_int + 4);
                     float a   = (3.0f * (x0 - x1) - xm1 + x2) * 0.5f;
                     float b   = 2.0f * x1 + xm1 - (5.0f * x0 + x2) * 0.5f;
                     float c   = (x1 - xm1) * 0.5f;
                     samplePoint.left = (((a * pos_fract) + b) * pos_fract + c) * pos_fract + x0;
 
                     //calculate right channel
-                    xm1 = getSample(pSrc, pos_int + 1);
-                    x0  = getSample(pSrc, pos_int + 3);
-                    x1  = getSample(pSrc, pos_int + 5);
-                    x2  = getSample(pSrc, pos_int + 7);
+                    xm1 = getSample(pSrc, pos_int - 1);
+                    x0  = getSample(pSrc, pos_int + 1);
+                    x1  = getSample(pSrc, pos_int + 3);
+                    x2  = getSample(pSrc, pos_int + 5);
                     a   = (3.0f * (x0 - x1) - xm1 + x2) * 0.5f;
                     b   = 2.0f * x1 + xm1 - (5.0f * x0 + x2) * 0.5f;
                     c   = (x1 - xm1) * 0.5f;
                     samplePoint.right =  (((a * pos_fract) + b) * pos_fract + c) * pos_fract + x0;
-                #endif // USE_LINEAR_INTERPOLATION
+                } else { // linear interpolation
+                    pos_int <<= 1;
 
-                *Pos += Pitch;
+                    // left channel
+                    int x1 = getSample(pSrc, pos_int);
+                    int x2 = getSample(pSrc, pos_int + 2);
+                    samplePoint.left  = (x1 + pos_fract * (x2 - x1));
+                    // right channel
+                    x1 = getSample(pSrc, pos_int + 1);
+                    x2 = getSample(pSrc, pos_int + 3);
+                    samplePoint.right = (x1 + pos_fract * (x2 - x1));
+                }
+
+                return samplePoint;
+            }
+
+            /**
+             * Windowed sinc interpolation of one output sample point. Like
+             * all other algorithms, it interpolates between the source
+             * sample points (pos_int + INTERPOLATION_PRE_ROLL) and
+             * (pos_int + INTERPOLATION_PRE_ROLL + 1), with the filter taps
+             * reaching from pos_int to (pos_int + TAPS - 1). The filter
+             * coefficients are linear interpolated between the two nearest
+             * precomputed phases of the SincTable.
+             */
+            inline static float InterpolateSincMono(sample_t* __restrict pSrc, int pos_int, float pos_fract) {
+                const float fPhase = pos_fract * SINC_INTERPOLATION_PHASES;
+                const int   phase  = int(fPhase);
+                const float fract  = fPhase - phase;
+                const float* c0 = SincTable::Row(phase);
+                const float* c1 = SincTable::Row(phase + 1);
+                float samplePoint = 0.0f;
+                for (int i = 0; i < SINC_INTERPOLATION_TAPS; ++i)
+                    samplePoint += getSample(pSrc, pos_int + i) * (c0[i] + fract * (c1[i] - c0[i]));
                 return samplePoint;
             }
 
-#if 0 // CONFIG_ASM && ARCH_X86
-            // TODO: no support for cubic interpolation yet
-            inline static void Interpolate4StepsMonoMMXSSE(sample_t* pSrc, void* Pos, float& Pitch) {
-                /* calculate playback position of each of the 4 samples by adding the associated pitch */
-                __asm__ __volatile__ (
-                    "movss    (%0),%%xmm0             # sample position of sample[0] -> xmm0[0]\n\t"
-                    "movss    %1,%%xmm1               # copy pitch -> xmm1[0]\n\t"
-                    "shufps   $0x90,%%xmm0,%%xmm0     # shift up, but keep xmm0[0]\n\t"
-                    "addss    %%xmm1,%%xmm0           # calculate sample position of sample[1]\n\t"
-                    "shufps   $0x90,%%xmm0,%%xmm0     # shift up, but keep xmm0[0]\n\t"
-                    "addss    %%xmm1,%%xmm0           # calculate sample position of sample[2]\n\t"
-                    "shufps   $0x90,%%xmm0,%%xmm0     # shift up, but keep xmm0[0]\n\t"
-                    "addss    %%xmm1,%%xmm0           # calculate sample position of sample[3]\n\t"
-                    "movss    %%xmm0,%%xmm2           # xmm0[0] -> xmm2[0]\n\t"
-                    "addss    %%xmm1,%%xmm2           # calculate initial sample position for the next 4-sample cycle\n\t"
-                    "movss    %%xmm2,(%0)             # update 'Pos'\n\t"
-                    "shufps   $0x1b,%%xmm0,%%xmm0     # swap, so that xmm0[0]=sample pos 0, xmm0[1]=sample pos 1,...\n\t"
-                    "cvttps2pi %%xmm0,%%mm4           # int(xmm0[0-1]) -> mm4\n\t"
-                    "shufps   $0xe4,%%xmm0,%%xmm1     # xmm0[2-3] -> xmm1[2-3]\n\t"
-                    "shufps   $0x0e,%%xmm1,%%xmm1     # xmm1[2-3] -> xmm1[0-1]\n\t"
-                    "cvttps2pi %%xmm1,%%mm5           # int(xmm1[0-1]) -> mm5\n\t"
-                    "cvtpi2ps %%mm5,%%xmm1            # double(mm5) -> xmm1[0-1]\n\t"
-                    "shufps   $0x44,%%xmm1,%%xmm1     # shift lower 2 FPs up to the upper 2 cells\n\t"
-                    "cvtpi2ps %%mm4,%%xmm1            # double(mm4) -> xmm1[0-1]\n\t"
-                    "subps    %%xmm1,%%xmm0           # xmm0[1-3] = xmm0[1-3] - xmm1[1-3]\n\t"
-                    :
-                    : "r" (Pos),  /* %0 */
-                      "m" (Pitch) /* %1 */
-                    : "%xmm0", /* holds fractional position (0.0 <= x < 1.0) of sample 0-3 at the end */
-                      "%xmm1", /* holds integer position (back converted to SPFP) of sample 0-3 at the end */
-                      "mm4",  /* holds integer position of sample 0-1 at the end */
-                      "mm5",  /* holds integer position of sample 2-3 at the end */
-                      "st", "st(1)", "st(2)", "st(3)", "st(4)", "st(5)", "st(6)", "st(7)"
-                );
-                /* get sample values of pSrc[pos_int] and pSrc[pos_int+1] of the 4 samples */
-                __asm__ __volatile__ (
-                    "movd   %%mm4,%%edi               # sample position of sample 0\n\t"
-                    "psrlq  $32,%%mm4                 # mm4 >> 32\n\t"
-                    "movswl (%0,%%edi,2),%%eax        # pSrc[pos_int] (sample 0)\n\t"
-                    "movswl 2(%0,%%edi,2),%%ecx       # pSrc[pos_int] (sample 0+1)\n\t"
-                    "cvtsi2ss %%eax, %%xmm2           # pSrc[pos_int] -> xmm2[0]\n\t"
-                    "cvtsi2ss %%ecx, %%xmm3           # pSrc[pos_int] -> xmm3[0]\n\t"
-                    "shufps    $0x93, %%xmm2, %%xmm2  # shift up\n\t"
-                    "shufps    $0x93, %%xmm3, %%xmm3  # shift up\n\t"
-                    "movd   %%mm4,%%edi               # sample position of sample 1\n\t"
-                    "movswl (%0,%%edi,2),%%eax        # pSrc[pos_int] (sample 1)\n\t"
-                    "movswl 2(%0,%%edi,2),%%ecx       # pSrc[pos_int] (sample 1+1)\n\t"
-                    "cvtsi2ss %%eax, %%xmm2           # pSrc[pos_int] -> xmm2[0]\n\t"
-                    "cvtsi2ss %%ecx, %%xmm3           # pSrc[pos_int] -> xmm3[0]\n\t"
-                    "shufps    $0x93, %%xmm2, %%xmm2  # shift up\n\t"
-                    "shufps    $0x93, %%xmm3, %%xmm3  # shift up\n\t"
-                    "movd   %%mm5,%%edi               # sample position of sample 2\n\t"
-                    "psrlq  $32,%%mm5                 # mm5 >> 32\n\t"
-                    "movswl (%0,%%edi,2),%%eax        # pSrc[pos_int] (sample 2)\n\t"
-                    "movswl 2(%0,%%edi,2),%%ecx       # pSrc[pos_int] (sample 2+1)\n\t"
-                    "cvtsi2ss %%eax, %%xmm2           # pSrc[pos_int] -> xmm2[0]\n\t"
-                    "cvtsi2ss %%ecx, %%xmm3           # pSrc[pos_int] -> xmm3[0]\n\t"
-                    "shufps    $0x93, %%xmm2, %%xmm2  # shift up\n\t"
-                    "shufps    $0x93, %%xmm3, %%xmm3  # shift up\n\t"
-                    "movd   %%mm5,%%edi               # sample position of sample 2\n\t"
-                    "movswl (%0,%%edi,2),%%eax        # pSrc[pos_int] (sample 3)\n\t"
-                    "movswl 2(%0,%%edi,2),%%ecx       # pSrc[pos_int] (sample 3+1)\n\t"
-                    "cvtsi2ss %%eax, %%xmm2           # pSrc[pos_int] -> xmm2[0]\n\t"
-                    "cvtsi2ss %%ecx, %%xmm3           # pSrc[pos_int] -> xmm3[0]\n\t"
-                    "shufps    $0x1b, %%xmm2, %%xmm2  # swap to correct order\n\t"
-                    "shufps    $0x1b, %%xmm3, %%xmm3  # swap to correct order\n\t"
-                    : /* no output */
-                    : "S" (pSrc) /* %0 - sample read position  */
-                    : "%eax", "%ecx", /*"%edx",*/ "%edi",
-                      "%xmm2", /* holds pSrc[int_pos]   of the 4 samples at the end */
-                      "%xmm3", /* holds pSrc[int_pos+1] of the 4 samples at the end */
-                      "mm4",  /* holds integer position of sample 0-1 at the end */
-                      "mm5",  /* holds integer position of sample 2-3 at the end */
-                      "st", "st(1)", "st(2)", "st(3)", "st(4)", "st(5)", "st(6)", "st(7)"
-                );
-                /* linear interpolation of the 4 samples simultaniously */
-                __asm__ __volatile__ (
-                    "subps %%xmm2,%%xmm3   # xmm3 = pSrc[pos_int+1] - pSrc[pos_int]\n\t"
-                    "mulps %%xmm0,%%xmm3   # xmm3 = pos_fract * (pSrc[pos_int+1] - pSrc[pos_int])\n\t"
-                    "addps %%xmm3,%%xmm2   # xmm2 = pSrc[pos_int] + (pos_fract * (pSrc[pos_int+1] - pSrc[pos_int]))\n\t"
-                    : /* no output */
-                    : /* no input */
-                    : "%xmm2" /* holds linear interpolated sample point (of all 4 samples) at the end */
-                );
+            inline static stereo_sample_t InterpolateSincStereo(sample_t* __restrict pSrc, int pos_int, float pos_fract) {
+                const float fPhase = pos_fract * SINC_INTERPOLATION_PHASES;
+                const int   phase  = int(fPhase);
+                const float fract  = fPhase - phase;
+                const float* c0 = SincTable::Row(phase);
+                const float* c1 = SincTable::Row(phase + 1);
+                stereo_sample_t samplePoint = { 0.0f, 0.0f };
+                pos_int <<= 1;
+                for (int i = 0; i < SINC_INTERPOLATION_TAPS; ++i, pos_int += 2) {
+                    const float c = c0[i] + fract * (c1[i] - c0[i]);
+                    samplePoint.left  += getSample(pSrc, pos_int)     * c;
+                    samplePoint.right += getSample(pSrc, pos_int + 1) * c;
+                }
+                return samplePoint;
+            }
+
+#if HAVE_GCC_VECTOR_EXTENSIONS
+            /**
+             * Vector version of Interpolate1StepMonoFixed(): calculates the
+             * next 4 output sample points at once. The source sample points
+             * still have to be gathered one by one, but the actual
+             * interpolation is then performed on all 4 output sample points
+             * simultaniously (with SSE2, NEON or AltiVec instructions,
+             * depending on the target architecture). The windowed sinc
+             * interpolation is calculated for each output sample point
+             * separately instead, since its filter tap loop is already
+             * vectorized by the compiler.
+             */
+            template<interpolation_t ALGO>
+            inline static v4sf Interpolate4StepsMonoSIMD(sample_t* __restrict pSrc, uint64_t& Phase, const uint64_t Increment) {
+                v4sf_cells fract, xm1, x0, x1, x2;
+                for (int i = 0; i < 4; ++i, Phase += Increment) {
+                    if (ALGO == interpolation_sinc) {
+                        x0.f[i] = InterpolateSincMono(pSrc, int(Phase >> 32), FixedFract(Phase));
+                        continue;
+                    }
+                    const int pos_int = int(Phase >> 32) + INTERPOLATION_PRE_ROLL;
+                    fract.f[i] = float(uint32_t(Phase) >> 8);
+                    if (ALGO == interpolation_cubic) {
+                        xm1.f[i] = getSample(pSrc, pos_int - 1);
+                        x0.f[i]  = getSample(pSrc, pos_int);
+                        x1.f[i]  = getSample(pSrc, pos_int + 1);
+                        x2.f[i]  = getSample(pSrc, pos_int + 2);
+                    } else {
+                        x1.f[i]  = getSample(pSrc, pos_int);
+                        x2.f[i]  = getSample(pSrc, pos_int + 1);
+                    }
+                }
+                if (ALGO == interpolation_sinc) return x0.v;
+                const float scale = 1.0f / 16777216.0f;
+                fract.v *= (v4sf) { scale, scale, scale, scale };
+                if (ALGO == interpolation_cubic)
+                    return Cubic4SIMD(xm1.v, x0.v, x1.v, x2.v, fract.v);
+                else
+                    return x1.v + fract.v * (x2.v - x1.v);
+            }
+
+            /**
+             * Vector version of Interpolate1StepStereoFixed(): calculates the
+             * next 4 output sample points of both channels at once.
+             */
+            template<interpolation_t ALGO>
+            inline static void Interpolate4StepsStereoSIMD(sample_t* __restrict pSrc, uint64_t& Phase, const uint64_t Increment, v4sf& left, v4sf& right) {
+                v4sf_cells fract, lxm1, lx0, lx1, lx2, rxm1, rx0, rx1, rx2;
+                for (int i = 0; i < 4; ++i, Phase += Increment) {
+                    if (ALGO == interpolation_sinc) {
+                        const stereo_sample_t samplePoint = InterpolateSincStereo(pSrc, int(Phase >> 32), FixedFract(Phase));
+                        lx0.f[i] = samplePoint.left;
+                        rx0.f[i] = samplePoint.right;
+                        continue;
+                    }
+                    const int pos_int = (int(Phase >> 32) + INTERPOLATION_PRE_ROLL) << 1;
+                    fract.f[i] = float(uint32_t(Phase) >> 8);
+                    if (ALGO == interpolation_cubic) {
+                        lxm1.f[i] = getSample(pSrc, pos_int - 2);
+                        rxm1.f[i] = getSample(pSrc, pos_int - 1);
+                        lx0.f[i]  = getSample(pSrc, pos_int);
+                        rx0.f[i]  = getSample(pSrc, pos_int + 1);
+                        lx1.f[i]  = getSample(pSrc, pos_int + 2);
+                        rx1.f[i]  = getSample(pSrc, pos_int + 3);
+                        lx2.f[i]  = getSample(pSrc, pos_int + 4);
+                        rx2.f[i]  = getSample(pSrc, pos_int + 5);
+                    } else {
+                        lx1.f[i]  = getSample(pSrc, pos_int);
+                        rx1.f[i]  = getSample(pSrc, pos_int + 1);
+                        lx2.f[i]  = getSample(pSrc, pos_int + 2);
+                        rx2.f[i]  = getSample(pSrc, pos_int + 3);
+                    }
+                }
+                if (ALGO == interpolation_sinc) {
+                    left  = lx0.v;
+                    right = rx0.v;
+                    return;
+                }
+                const float scale = 1.0f / 16777216.0f;
+                fract.v *= (v4sf) { scale, scale, scale, scale };
+                if (ALGO == interpolation_cubic) {
+                    left  = Cubic4SIMD(lxm1.v, lx0.v, lx1.v, lx2.v, fract.v);
+                    right = Cubic4SIMD(rxm1.v, rx0.v, rx1.v, rx2.v, fract.v);
+                } else {
+                    left  = lx1.v + fract.v * (lx2.v - lx1.v);
+                    right = rx1.v + fract.v * (rx2.v - rx1.v);
+                }
             }
 
-            // TODO: no support for cubic interpolation yet
-            inline static void Interpolate4StepsStereoMMXSSE(sample_t* pSrc, void* Pos, float& Pitch) {
-                /* calculate playback position of each of the 4 samples by adding the associated pitch */
-                __asm__ __volatile__ (
-                    "movss    (%0),%%xmm0             # sample position of sample[0] -> xmm0[0]\n\t"
-                    "movss    %1,%%xmm1               # copy pitch -> xmm1[0]\n\t"
-                    "shufps   $0x90,%%xmm0,%%xmm0     # shift up, but keep xmm0[0]\n\t"
-                    "addss    %%xmm1,%%xmm0           # calculate sample position of sample[1]\n\t"
-                    "shufps   $0x90,%%xmm0,%%xmm0     # shift up, but keep xmm0[0]\n\t"
-                    "addss    %%xmm1,%%xmm0           # calculate sample position of sample[2]\n\t"
-                    "shufps   $0x90,%%xmm0,%%xmm0     # shift up, but keep xmm0[0]\n\t"
-                    "addss    %%xmm1,%%xmm0           # calculate sample position of sample[3]\n\t"
-                    "movss    %%xmm0,%%xmm2           # xmm0[0] -> xmm2[0]\n\t"
-                    "addss    %%xmm1,%%xmm2           # calculate initial sample position for the next 4-sample cycle\n\t"
-                    "movss    %%xmm2,(%0)             # update 'Pos'\n\t"
-                    "shufps   $0x1b,%%xmm0,%%xmm0     # swap, so that xmm0[0]=sample pos 0, xmm0[1]=sample pos 1,...\n\t"
-                    "cvttps2pi %%xmm0,%%mm4           # int(xmm0[0-1]) -> mm4\n\t"
-                    "shufps   $0xe4,%%xmm0,%%xmm1     # xmm0[2-3] -> xmm1[2-3]\n\t"
-                    "shufps   $0x0e,%%xmm1,%%xmm1     # xmm1[2-3] -> xmm1[0-1]\n\t"
-                    "cvttps2pi %%xmm1,%%mm5           # int(xmm1[0-1]) -> mm5\n\t"
-                    "cvtpi2ps %%mm5,%%xmm1            # double(mm5) -> xmm1[0-1]\n\t"
-                    "shufps   $0x44,%%xmm1,%%xmm1     # shift lower 2 FPs up to the upper 2 cells\n\t"
-                    "cvtpi2ps %%mm4,%%xmm1            # double(mm4) -> xmm1[0-1]\n\t"
-                    "subps    %%xmm1,%%xmm0           # xmm0[1-3] = xmm0[1-3] - xmm1[1-3]\n\t"
-                    :
-                    : "r" (Pos),  /* %0 */
-                      "m" (Pitch) /* %1 */
-                    : "%xmm0", /* holds fractional position (0.0 <= x < 1.0) of sample 0-3 at the end */
-                      "%xmm1", /* holds integer position (back converted to SPFP) of sample 0-3 at the end */
-                      "mm4",  /* holds integer position of sample 0-1 at the end */
-                      "mm5",  /* holds integer position of sample 2-3 at the end */
-                      "st", "st(1)", "st(2)", "st(3)", "st(4)", "st(5)", "st(6)", "st(7)"
-                );
-
-                /* get sample values of pSrc[pos_int], pSrc[pos_int+1], pSrc[pos_int+2] and pSrc[pos_int+3] of the 4 samples */
-                __asm__ __volatile__ (
-                    "xorl   %%eax,%%eax               # clear eax\n\t"
-                    "xorl   %%edx,%%edx               # clear edx\n\t"
-                    "movd   %%mm4,%%edi               # sample position of sample 0\n\t"
-                    "psrlq  $32,%%mm4                 # mm4 >> 32\n\t"
-                    "movswl (%0,%%edi,4),%%eax        # pSrc[pos_int] (sample 0)\n\t"
-                    "cvtsi2ss %%eax, %%xmm2           # pSrc[pos_int] -> xmm2[0]\n\t"
-                    "shufps    $0x93, %%xmm2, %%xmm2  # shift up\n\t"
-                    "movswl 2(%0,%%edi,4),%%edx       # pSrc[pos_int] (sample 0+1)\n\t"
-                    "cvtsi2ss %%edx, %%xmm3           # pSrc[pos_int] -> xmm3[0]\n\t"
-                    "shufps    $0x93, %%xmm3, %%xmm3  # shift up\n\t"
-                    "movswl 4(%0,%%edi,4),%%eax       # pSrc[pos_int] (sample 0+2)\n\t"
-                    "cvtsi2ss %%eax, %%xmm4           # pSrc[pos_int] -> xmm4[0]\n\t"
-                    "shufps    $0x93, %%xmm4, %%xmm4  # shift up\n\t"
-                    "movswl 6(%0,%%edi,4),%%edx       # pSrc[pos_int] (sample 0+3)\n\t"
-                    "cvtsi2ss %%edx, %%xmm5           # pSrc[pos_int] -> xmm5[0]\n\t"
-                    "movd   %%mm4,%%edi               # sample position of sample 1\n\t"
-                    "shufps    $0x93, %%xmm5, %%xmm5  # shift up\n\t"
-                    "movswl (%0,%%edi,4),%%eax        # pSrc[pos_int] (sample 1)\n\t"
-                    "cvtsi2ss %%eax, %%xmm2           # pSrc[pos_int] -> xmm2[0]\n\t"
-                    "shufps    $0x93, %%xmm2, %%xmm2  # shift up\n\t"
-                    "movswl 2(%0,%%edi,4),%%edx       # pSrc[pos_int] (sample 1+1)\n\t"
-                    "cvtsi2ss %%edx, %%xmm3           # pSrc[pos_int] -> xmm3[0]\n\t"
-                    "shufps    $0x93, %%xmm3, %%xmm3  # shift up\n\t"
-                    "movswl 4(%0,%%edi,4),%%eax       # pSrc[pos_int] (sample 1+2)\n\t"
-                    "cvtsi2ss %%eax, %%xmm4           # pSrc[pos_int] -> xmm4[0]\n\t"
-                    "shufps    $0x93, %%xmm4, %%xmm4  # shift up\n\t"
-                    "movswl 6(%0,%%edi,4),%%edx       # pSrc[pos_int] (sample 1+3)\n\t"
-                    "cvtsi2ss %%edx, %%xmm5           # pSrc[pos_int] -> xmm5[0]\n\t"
-                    "movd   %%mm5,%%edi               # sample position of sample 2\n\t"
-                    "shufps    $0x93, %%xmm5, %%xmm5  # shift up\n\t"
-                    "psrlq  $32,%%mm5                 # mm5 >> 32\n\t"
-                    "movswl (%0,%%edi,4),%%eax        # pSrc[pos_int] (sample 2)\n\t"
-                    "cvtsi2ss %%eax, %%xmm2           # pSrc[pos_int] -> xmm2[0]\n\t"
-                    "shufps    $0x93, %%xmm2, %%xmm2  # shift up\n\t"
-                    "movswl 2(%0,%%edi,4),%%edx       # pSrc[pos_int] (sample 2+1)\n\t"
-                    "cvtsi2ss %%edx, %%xmm3           # pSrc[pos_int] -> xmm3[0]\n\t"
-                    "shufps    $0x93, %%xmm3, %%xmm3  # shift up\n\t"
-                    "movswl 4(%0,%%edi,4),%%eax       # pSrc[pos_int] (sample 2+2)\n\t"
-                    "cvtsi2ss %%eax, %%xmm4           # pSrc[pos_int] -> xmm4[0]\n\t"
-                    "shufps    $0x93, %%xmm4, %%xmm4  # shift up\n\t"
-                    "movswl 6(%0,%%edi,4),%%edx       # pSrc[pos_int] (sample 2+3)\n\t"
-                    "cvtsi2ss %%edx, %%xmm5           # pSrc[pos_int] -> xmm5[0]\n\t"
-                    "movd   %%mm5,%%edi               # sample position of sample 3\n\t"
-                    "shufps    $0x93, %%xmm5, %%xmm5  # shift up\n\t"
-                    "movswl (%0,%%edi,4),%%eax        # pSrc[pos_int] (sample 3)\n\t"
-                    "cvtsi2ss %%eax, %%xmm2           # pSrc[pos_int] -> xmm2[0]\n\t"
-                    "shufps    $0x1b, %%xmm2, %%xmm2  # shift up\n\t"
-                    "movswl 2(%0,%%edi,4),%%edx       # pSrc[pos_int] (sample 3+1)\n\t"
-                    "cvtsi2ss %%edx, %%xmm3           # pSrc[pos_int] -> xmm3[0]\n\t"
-                    "shufps    $0x1b, %%xmm3, %%xmm3  # shift up\n\t"
-                    "movswl 4(%0,%%edi,4),%%eax       # pSrc[pos_int] (sample 3+2)\n\t"
-                    "cvtsi2ss %%eax, %%xmm4           # pSrc[pos_int] -> xmm4[0]\n\t"
-                    "shufps    $0x1b, %%xmm4, %%xmm4  # swap to correct order\n\t"
-                    "movswl 6(%0,%%edi,4),%%edx       # pSrc[pos_int] (sample 3+3)\n\t"
-                    "cvtsi2ss %%edx, %%xmm5           # pSrc[pos_int] -> xmm5[0]\n\t"
-                    "shufps    $0x1b, %%xmm5, %%xmm5  # swap to correct order\n\t"
-                    : /* no output */
-                    : "S" (pSrc) /* %0 - sample read position  */
-                    : "%eax", "%edx", "%edi",
-                      "xmm2", /* holds pSrc[int_pos]   of the 4 samples at the end */
-                      "xmm3", /* holds pSrc[int_pos+1] of the 4 samples at the end */
-                      "xmm4", /* holds pSrc[int_pos+2] of the 4 samples at the end */
-                      "xmm5", /* holds pSrc[int_pos+3] of the 4 samples at the end */
-                      "mm4",  /* holds integer position of sample 0-1 at the end */
-                      "mm5",  /* holds integer position of sample 2-3 at the end */
-                      "st", "st(1)", "st(2)", "st(3)", "st(4)", "st(5)", "st(6)", "st(7)"
-                );
-                /* linear interpolation of the 4 samples (left & right channel) simultaniously */
-                __asm__ __volatile__ (
-                    "subps %%xmm2,%%xmm4   # xmm4 = pSrc[pos_int+2] - pSrc[pos_int] (left channel)\n\t"
-                    "mulps %%xmm0,%%xmm4   # xmm4 = pos_fract * (pSrc[pos_int+2] - pSrc[pos_int]) (left channel)\n\t"
-                    "addps %%xmm4,%%xmm2   # xmm2 = pSrc[pos_int] + (pos_fract * (pSrc[pos_int+2] - pSrc[pos_int])) (left channel)\n\t"
-                    "subps %%xmm3,%%xmm5   # xmm5 = pSrc[pos_int+3] - pSrc[pos_int+1] (right channel)\n\t"
-                    "mulps %%xmm0,%%xmm5   # xmm5 = pos_fract * (pSrc[pos_int+3] - pSrc[pos_int+1]) (right channel)\n\t"
-                    "addps %%xmm5,%%xmm3   # xmm3 = pSrc[pos_int+1] + (pos_fract * (pSrc[pos_int+3] - pSrc[pos_int+1])) (right channel)\n\t"
-                    : /* no output */
-                    : /* no input */
-                    : "%xmm2", /* holds linear interpolated sample of left  channel (of all 4 samples) at the end */
-                      "%xmm3"  /* holds linear interpolated sample of right channel (of all 4 samples) at the end */
-                );
+            /**
+             * 4-point, 3rd order Hermite interpolation of 4 independent
+             * output sample points (same polynomial as used by the scalar
+             * implementation).
+             */
+            inline static v4sf Cubic4SIMD(const v4sf& xm1, const v4sf& x0, const v4sf& x1, const v4sf& x2, const v4sf& fract) {
+                const v4sf half  = { 0.5f, 0.5f, 0.5f, 0.5f };
+                const v4sf two   = { 2.0f, 2.0f, 2.0f, 2.0f };
+                const v4sf three = { 3.0f, 3.0f, 3.0f, 3.0f };
+                const v4sf five  = { 5.0f, 5.0f, 5.0f, 5.0f };
+                const v4sf a = (three * (x0 - x1) - xm1 + x2) * half;
+                const v4sf b = two * x1 + xm1 - (five * x0 + x2) * half;
+                const v4sf c = (x1 - xm1) * half;
+                return (((a * fract) + b) * fract + c) * fract + x0;
             }
-#endif // CONFIG_ASM && ARCH_X86
+#endif // HAVE_GCC_VECTOR_EXTENSIONS
     };
 
 } // namespace LinuxSampler
@@ -24,9 +24,26 @@
 #include "SampleFile.h"
 #include "../../common/global_private.h"
 #include "../../common/Exception.h"
+#include "DiskLatency.h"
+
+#include "../../common/Thread.h"
 
 #include <cstring>
 
+// memory mapping of samples is only implemented for POSIX systems
+#if CONFIG_MMAP_SAMPLES && !defined(WIN32)
+# define MMAP_SAMPLES CONFIG_MMAP_SAMPLES
+#else
+# define MMAP_SAMPLES 0
+#endif
+
+#if MMAP_SAMPLES
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+#endif
+
 #define CONVERT_BUFFER_SIZE 4096
 
 namespace LinuxSampler {
@@ -34,10 +51,39 @@ namespace LinuxSampler {
     int SampleFile_OpenFilesCount = 0;
     #endif
 
+    #if MMAP_SAMPLES
+    /**
+     * Looks up the position and size of the 'data' chunk of the RIFF WAVE
+     * file @a fd. Returns false if it's not a RIFF WAVE file or if it has
+     * no 'data' chunk.
+     */
+    static bool findWaveData(int fd, int64_t& DataOffset, int64_t& DataSize) {
+        uint8_t header[12];
+        if (pread(fd, header, 12, 0) != 12) return false;
+        if (memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4)) return false;
+        off_t pos = 12;
+        uint8_t chunk[8];
+        while (pread(fd, chunk, 8, pos) == 8) {
+            const uint32_t size = chunk[4] | (chunk[5] << 8) | (chunk[6] << 16) | (uint32_t(chunk[7]) << 24);
+            if (!memcmp(chunk, "data", 4)) {
+                DataOffset = pos + 8;
+                DataSize   = size;
+                return true;
+            }
+            pos += 8 + off_t(size) + (size & 1); // chunks are word aligned
+        }
+        return false;
+    }
+    #endif
+
     SampleFile::SampleFile(String File, bool DontClose) {
         this->File      = File;
         this->pSndFile  = NULL;
         pConvertBuffer  = NULL;
+        pMapping        = NULL;
+        MappingSize     = 0;
+        Mappable        = -1;
+        DataOffset      = 0;
 
         SF_INFO sfInfo;
         sfInfo.format = 0;
@@ -64,7 +110,12 @@ namespace LinuxSampler {
             case SF_FORMAT_DWVW_24:
             case SF_FORMAT_PCM_32:
             case SF_FORMAT_FLOAT:
+#if CONFIG_32BIT_SAMPLES
+                // decoded only once, to aligned 32 bit integers
+                FrameSize = 4 * ChannelCount;
+#else
                 FrameSize = 3 * ChannelCount;
+#endif
                 break;
             default:
                 FrameSize = 2 * ChannelCount;
@@ -102,6 +153,7 @@ namespace LinuxSampler {
         Close();
         ReleaseSampleData();
         delete[] pConvertBuffer;
+        DiskLatency::ForgetFile(File);
     }
 
     void SampleFile::Open() {
@@ -159,15 +211,18 @@ namespace LinuxSampler {
     }
 
     Sample::buffer_t SampleFile::LoadSampleDataWithNullSamplesExtension(unsigned long FrameCount, uint NullFramesCount) {
-        Open();
         if (FrameCount > GetTotalFrameCount()) FrameCount = GetTotalFrameCount();
-        
+
+        // map the whole sample instead of copying it, if possible
+        if (FrameCount == GetTotalFrameCount() && Map(NullFramesCount)) return GetCache();
+
+        Open();
         if (Offset > MaxOffset && FrameCount < GetTotalFrameCount()) {
             FrameCount = FrameCount + Offset > GetTotalFrameCount() ? GetTotalFrameCount() - Offset : FrameCount;
             // Offset the RAM cache
             RAMCacheOffset = Offset;
         }
-        if (RAMCache.pStart) delete[] (int8_t*) RAMCache.pStart;
+        ReleaseSampleData();
         unsigned long allocationsize = (FrameCount + NullFramesCount) * this->FrameSize;
         SetPos(RAMCacheOffset, SEEK_SET); // reset read position to playback start point
         RAMCache.pStart            = new int8_t[allocationsize];
@@ -185,6 +240,15 @@ namespace LinuxSampler {
         
         if (GetPos() + FrameCount > GetTotalFrameCount()) FrameCount = GetTotalFrameCount() - GetPos(); // For the cases where a different sample end is specified (not the end of the file)
 
+#if CONFIG_32BIT_SAMPLES
+        // 24 bit, 32 bit and float samples are stored as 32 bit integers
+        // (in native byte order), which is exactly what libsndfile
+        // delivers, so no intermediate conversion is needed
+        if (FrameSize == 4 * ChannelCount) {
+            return (long) sf_readf_int(pSndFile, static_cast<int*>(pBuffer), FrameCount);
+        }
+#endif
+
         // ogg and flac files must be read with sf_readf, not
         // sf_read_raw. On big endian machines, sf_readf_short is also
         // used for 16 bit wav files, to get automatic endian
@@ -253,7 +317,104 @@ namespace LinuxSampler {
         return count;
     }
 
+    bool SampleFile::IsMappable() {
+        #if MMAP_SAMPLES && !WORDS_BIGENDIAN
+        if (Mappable < 0) {
+            Mappable = 0;
+            // only formats which Read() copies 1:1 by sf_read_raw()
+            const int subformat = Format & SF_FORMAT_SUBMASK;
+            if ((Format & SF_FORMAT_TYPEMASK) == SF_FORMAT_WAV && (
+                    (subformat == SF_FORMAT_PCM_16 && FrameSize == 2 * ChannelCount) ||
+                    (subformat == SF_FORMAT_PCM_24 && FrameSize == 3 * ChannelCount)))
+            {
+                const int fd = open(File.c_str(), O_RDONLY);
+                if (fd >= 0) {
+                    struct stat st;
+                    int64_t size;
+                    // the sample must end with the data chunk (apart from the
+                    // pad byte), everything past the file's end reads as zero
+                    if (!fstat(fd, &st) && findWaveData(fd, DataOffset, size) &&
+                        size == int64_t(GetTotalFrameCount()) * FrameSize &&
+                        DataOffset + size <= st.st_size &&
+                        DataOffset + size + (size & 1) >= st.st_size) Mappable = 1;
+                    close(fd);
+                }
+            }
+        }
+        return Mappable == 1;
+        #else
+        return false;
+        #endif
+    }
+
+    bool SampleFile::Map(uint NullFramesCount) {
+        #if MMAP_SAMPLES
+        if (!IsMappable()) return false;
+        const int fd = open(File.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st)) {
+            close(fd);
+            return false;
+        }
+
+        const size_t page     = size_t(sysconf(_SC_PAGESIZE));
+        const off_t  start    = off_t(DataOffset) & ~off_t(page - 1);
+        const size_t head     = size_t(DataOffset - start);
+        const size_t dataSize = size_t(GetTotalFrameCount()) * FrameSize;
+        // only map the file up to the page containing its end (accessing
+        // file mapped pages past it would raise SIGBUS), the rest of the
+        // null extension is anonymous memory, which is zero as well
+        const size_t fileSize = (size_t(st.st_size - start) + page - 1) & ~(page - 1);
+        size_t size = (head + dataSize + NullFramesCount * FrameSize + page - 1) & ~(page - 1);
+        if (size < fileSize) size = fileSize;
+
+        void* p = mmap(NULL, size, PROT_READ, MAP_PRIVATE | MAP_ANON, -1, 0);
+        if (p == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        int flags = MAP_PRIVATE | MAP_FIXED;
+        #if defined(MAP_POPULATE)
+        flags |= MAP_POPULATE; // read it now, so the audio thread never page faults
+        #endif
+        const bool bMapped = mmap(p, fileSize, PROT_READ, flags, fd, start) != MAP_FAILED;
+        close(fd);
+        // the optional pad byte of the data chunk must be zero as well
+        if (!bMapped || (dataSize & 1 && ((uint8_t*)p)[head + dataSize])) {
+            munmap(p, size);
+            return false;
+        }
+        #if !defined(MAP_POPULATE)
+        madvise(p, size, MADV_WILLNEED);
+        #endif
+        #if MMAP_SAMPLES > 1
+        if (!Thread::lockMemory(p, size))
+            std::cerr << "Sample::Map() " << "Failed to lock " << File << " in RAM" << std::endl;
+        #endif
+
+        ReleaseSampleData();
+        pMapping                   = p;
+        MappingSize                = size;
+        RAMCacheOffset             = 0;
+        RAMCache.pStart            = (int8_t*)p + head;
+        RAMCache.Size              = dataSize;
+        RAMCache.NullExtensionSize = size - head - dataSize;
+        dmsg(3,("Mapped sample \"%s\" (%lu bytes)\n", File.c_str(), (unsigned long)dataSize));
+        return true;
+        #else
+        return false;
+        #endif
+    }
+
     void SampleFile::ReleaseSampleData() {
+        #if MMAP_SAMPLES
+        if (pMapping) {
+            munmap(pMapping, MappingSize); // also unlocks it
+            pMapping    = NULL;
+            MappingSize = 0;
+        } else
+        #endif
         if (RAMCache.pStart) delete[] (int8_t*) RAMCache.pStart;
         RAMCache.pStart = NULL;
         RAMCache.Size   = 0;
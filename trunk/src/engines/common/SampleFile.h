@@ -66,6 +66,17 @@ namespace LinuxSampler {
             void Open();
             void Close();
 
+            /**
+             * Returns true if this sample's data can be memory mapped from
+             * its file, instead of being copied into RAM, when it is loaded
+             * as a whole with LoadSampleDataWithNullSamplesExtension(). This
+             * requires CONFIG_MMAP_SAMPLES and an uncompressed 16 or 24 bit
+             * WAV file, whose sample data is stored exactly in the format
+             * used by the voices and at the end of the file (so that it is
+             * followed by silence in the mapping).
+             */
+            bool IsMappable();
+
         private:
             String File;
             int    SampleRate;
@@ -80,10 +91,15 @@ namespace LinuxSampler {
             SNDFILE* pSndFile;
 
             buffer_t RAMCache;        ///< Buffers samples (already uncompressed) in RAM.
+            void*    pMapping;        ///< Start of the memory mapping RAMCache points into, NULL if RAMCache was allocated.
+            size_t   MappingSize;     ///< Size of the memory mapping in bytes.
+            int      Mappable;        ///< Cached result of IsMappable(), -1 if not checked yet.
+            int64_t  DataOffset;      ///< Position of the sample data in the file (only valid if mappable).
 
             int* pConvertBuffer;
 
             long SetPos(unsigned long FrameCount, int Whence);
+            bool Map(uint NullFramesCount);
     };
 
     template <class R>
@@ -58,6 +58,22 @@ namespace LinuxSampler {
                     return normalizer * (float) (SAWUP ? uiLevel : intLimit - uiLevel) + offset;
             }
 
+            /**
+             * Renders the next \a n sample points of the LFO wave at once,
+             * the same as calling render() \a n times.
+             */
+            inline void render(float* pOut, unsigned int n) {
+                const unsigned int intLimit = (unsigned int) -1; // all 0xFFFF...
+                const float norm = normalizer;
+                const float offs = (RANGE == range_unsigned) ? 0.0f : offset;
+                unsigned int level = uiLevel;
+                for (unsigned int k = 0; k < n; ++k) {
+                    level += c;
+                    pOut[k] = norm * (float) (SAWUP ? level : intLimit - level) + offs;
+                }
+                uiLevel = level;
+            }
+
             /**
              * Update LFO depth with a new external controller value.
              *
@@ -24,9 +24,18 @@
 
 #include "LFOBase.h"
 
+// resolution of the sine lookup table used by SineLFO (2^SINE_LFO_TABLE_BITS
+// points per period), with linear interpolation between the table points
+// the error of the LFO wave is below 1e-5
+#define SINE_LFO_TABLE_BITS 10
+
 namespace LinuxSampler {
 
     /** @brief sine LFO
+     *
+     * The wave is read from a lookup table with linear interpolation, so
+     * rendering an LFO level costs just a few multiplications instead of a
+     * call to the libm sin() function.
      */
     template<range_type_t RANGE>
     class SineLFO : public LFOBase<RANGE> {
@@ -47,10 +56,24 @@ namespace LinuxSampler {
              */
             inline float render() {
                 uiLevel += c;
+                // upper bits of the phase select the table point, the
+                // remaining lower bits are the interpolation fraction
+                const unsigned int i = uiLevel >> (32 - SINE_LFO_TABLE_BITS);
+                const float fract = float(uiLevel & ((1u << (32 - SINE_LFO_TABLE_BITS)) - 1)) *
+                                    (1.0f / float(1u << (32 - SINE_LFO_TABLE_BITS)));
+                const float level = sineTable.Points[i] + fract * (sineTable.Points[i + 1] - sineTable.Points[i]);
                 if (RANGE == range_unsigned)
-                    return normalizer * (sin(c2 * (float)uiLevel) + 1.0f);
+                    return normalizer * (level + 1.0f);
                 else /* signed range */
-                    return normalizer * sin(c2 * (float)uiLevel);
+                    return normalizer * level;
+            }
+
+            /**
+             * Renders the next \a n sample points of the LFO wave at once,
+             * the same as calling render() \a n times.
+             */
+            inline void render(float* pOut, unsigned int n) {
+                for (unsigned int k = 0; k < n; ++k) pOut[k] = render();
             }
 
             /**
@@ -93,7 +116,6 @@ namespace LinuxSampler {
                 const float freq = Frequency * this->ScriptFrequencyFactor;
                 const float r = freq / (float) SampleRate; // frequency alteration quotient
                 c = (int) (intLimit * r);
-                c2 = (2.0f * M_PI) / (float) intLimit;
 
                 uiLevel = 0;
             }
@@ -130,10 +152,27 @@ namespace LinuxSampler {
         protected:
             unsigned int uiLevel;
             int   c;
-            float c2;
             float normalizer;
+
+        private:
+            /// One period of the sine wave, plus the first point repeated at the end for the interpolation.
+            struct SineTable {
+                float Points[(1 << SINE_LFO_TABLE_BITS) + 1];
+
+                SineTable() {
+                    const int n = 1 << SINE_LFO_TABLE_BITS;
+                    for (int i = 0; i < n; i++)
+                        Points[i] = (float) sin(2.0 * M_PI * double(i) / double(n));
+                    Points[n] = Points[0];
+                }
+            };
+
+            static const SineTable sineTable;
     };
 
+    template<range_type_t RANGE>
+    const typename SineLFO<RANGE>::SineTable SineLFO<RANGE>::sineTable;
+
 } // namespace LinuxSampler
 
 #endif // __LS_SINELFO_H__
@@ -27,6 +27,8 @@
 
 #include "../../common/global.h"
 #include "../../common/RingBuffer.h"
+#include "../../common/atomic.h"
+#include "../../common/RTMath.h"
 #include "Sample.h"
 
 namespace LinuxSampler {
@@ -64,13 +66,21 @@ namespace LinuxSampler {
                     int TotalSampleCount;
             };
 
-            Stream(uint BufferSize, uint BufferWrapElements) {
+            /**
+             * @param BufferSize         - size of the ring buffer (in sample points)
+             * @param BufferWrapElements - size of the ring buffer's wrap area (in sample points)
+             * @param MaxBytesPerSample  - max. size (in bytes) of one sample point to be streamed
+             */
+            Stream(uint BufferSize, uint BufferWrapElements, uint MaxBytesPerSample = 3) {
                 this->pExportReference       = NULL;
                 this->State                  = state_unused;
                 this->hThis                  = 0;
                 this->PlaybackState.position = 0;
                 this->PlaybackState.reverse  = false;
-                this->pRingBuffer            = new RingBuffer<uint8_t,false>(BufferSize * 3, BufferWrapElements * 3);
+                this->pActiveStreamCount     = NULL;
+                this->DrainRate              = 0;
+                this->OrderTime              = 0;
+                this->pRingBuffer            = new RingBuffer<uint8_t,false>(BufferSize * MaxBytesPerSample, BufferWrapElements * MaxBytesPerSample);
                 UnusedStreams++;
                 TotalStreams++;
             }
@@ -102,6 +112,30 @@ namespace LinuxSampler {
                 return pRingBuffer->get_read_ptr();
             }
 
+            /**
+             * Returns the time (in sample points) until the consumer (voice)
+             * will have read all data currently in the buffer, if it keeps
+             * reading at the rate reported with SetDrainRate().
+             */
+            inline float GetTimeToUnderrun() {
+                // a consumer not reading at all is treated as reading very
+                // slowly, so its stream still gets refilled when idle
+                const float rate = (DrainRate > 0.001f) ? DrainRate : 0.001f;
+                return float(GetReadSpace()) / rate;
+            }
+
+            /**
+             * Called by the consumer (voice) after each audio fragment to
+             * tell the disk thread how fast it is currently reading from
+             * this stream, which mainly depends on its current pitch.
+             *
+             * @param SampleWords - amount of sample words read in the fragment
+             * @param Samples     - length of the fragment in sample points
+             */
+            inline void SetDrainRate(uint SampleWords, uint Samples) {
+                if (Samples) DrainRate = float(SampleWords) / float(Samples);
+            }
+
             inline void IncrementReadPos(uint Count)  {
                 Count *= SampleInfo.BytesPerSample;
                 uint leftspace = pRingBuffer->read_space();
@@ -127,6 +161,9 @@ namespace LinuxSampler {
             reference_t*                pExportReference;
             state_t                     State;
             Handle                      hThis;
+            atomic_t*                   pActiveStreamCount; ///< Counter of streams in use of the disk thread owning this stream (updated on launch and reset).
+            float                       DrainRate;          ///< Sample words the consumer (voice) read per sample point in its last audio fragment (written by audio thread, read by disk thread).
+            RTMath::usecs_t             OrderTime;          ///< When the consumer ordered this stream, until its first refill (0 if not measured, see DiskLatency).
 
             // Static Attributes
             static uint UnusedStreams; //< Reflects how many stream objects of all stream instances are currently not in use.
@@ -146,6 +183,18 @@ namespace LinuxSampler {
             virtual long Read(uint8_t* pBuf, long SamplesToRead) = 0;
             virtual void Reset() = 0;
 
+            /**
+             * Returns the object (i.e. file) this stream is currently
+             * reading from. The disk thread never refills two streams with
+             * the same source in parallel, since the sample decoders keep
+             * state (like the file position) per source. Streams returning
+             * NULL are refilled all by the same thread.
+             */
+            virtual const void* GetSource() { return NULL; }
+
+            /// Returns the file this stream is currently reading from, if known.
+            virtual String GetSourceFile() { return String(); }
+
         private:
 
             // Methods
@@ -43,7 +43,7 @@ namespace LinuxSampler {
     class StreamBase : public Stream {
         public:
             // Methods
-            StreamBase(uint BufferSize, uint BufferWrapElements) : Stream(BufferSize, BufferWrapElements) {
+            StreamBase(uint BufferSize, uint BufferWrapElements, uint MaxBytesPerSample = 3) : Stream(BufferSize, BufferWrapElements, MaxBytesPerSample) {
                 this->pRegion      = NULL;
                 this->SampleOffset = 0;
             }
@@ -89,6 +89,7 @@ namespace LinuxSampler {
                 bool                   DoLoop
             ) {
                 UnusedStreams--;
+                if (pActiveStreamCount) atomic_inc(pActiveStreamCount);
                 this->pExportReference  = pExportReference;
                 this->hThis             = hStream;
                 this->pRegion           = pRgn;
@@ -96,6 +97,7 @@ namespace LinuxSampler {
                 this->PlaybackState     = PlaybackState;
                 this->SampleOffset      = SampleOffset;
                 this->DoLoop            = DoLoop;
+                this->DrainRate         = float(SampleInfo.ChannelsPerFrame); // until the voice reports, assume original pitch
                 SetState(state_active);
             }
 
@@ -120,6 +122,7 @@ namespace LinuxSampler {
                     }
                     State = state_unused;
                     UnusedStreams++;
+                    if (pActiveStreamCount) atomic_dec(pActiveStreamCount);
                 }
             }
 
@@ -0,0 +1,102 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#include "UnrolledLoop.h"
+
+#include <string.h>
+
+namespace LinuxSampler {
+
+    // Sample points are accessed the same way as by the Resampler: packed
+    // 24 bit sample points are always little endian, all other ones are in
+    // native byte order.
+
+    static int32_t getSample(const uint8_t* p, uint BytesPerSample) {
+        switch (BytesPerSample) {
+            case 2:  return int32_t(*(const int16_t*)p) << 16;
+            case 3:  return p[0] << 8 | p[1] << 16 | p[2] << 24;
+            default: return *(const int32_t*)p;
+        }
+    }
+
+    static void setSample(uint8_t* p, uint BytesPerSample, int32_t value) {
+        switch (BytesPerSample) {
+            case 2:
+                *(int16_t*)p = int16_t(value >> 16);
+                break;
+            case 3:
+                p[0] = uint8_t(value >> 8);
+                p[1] = uint8_t(value >> 16);
+                p[2] = uint8_t(value >> 24);
+                break;
+            default:
+                *(int32_t*)p = value;
+        }
+    }
+
+    UnrolledLoop::UnrolledLoop(const void* pCache, uint FrameSize, uint ChannelCount, uint LoopStart, uint LoopSize, uint MinLoopSize, uint CrossfadeFrames, uint ReadAheadFrames) {
+        uiLoopStart = LoopStart;
+        uiReadAhead = ReadAheadFrames;
+        uiLoopSize  = (MinLoopSize > LoopSize) ? (MinLoopSize + LoopSize - 1) / LoopSize * LoopSize : LoopSize;
+
+        const uint   uiLoopEnd = LoopStart + LoopSize; // of the original loop
+        const size_t frames    = size_t(uiLoopStart) + uiLoopSize + ReadAheadFrames;
+        pBuffer = new int32_t[(frames * FrameSize + 3) / 4];
+
+        // copy the head of the sample up to the (original) loop end
+        const uint8_t* src = (const uint8_t*) pCache;
+        uint8_t*       buf = (uint8_t*) pBuffer;
+        memcpy(buf, src, size_t(uiLoopEnd) * FrameSize);
+
+        // fade the end of the loop over to the sample points before the
+        // loop start, so the signal continues seamlessly at the loop start
+        if (CrossfadeFrames > LoopStart) CrossfadeFrames = LoopStart;
+        if (CrossfadeFrames > LoopSize)  CrossfadeFrames = LoopSize;
+        const uint BytesPerSample = FrameSize / ChannelCount;
+        for (uint i = 0; i < CrossfadeFrames; ++i) {
+            const double fadeIn = double(i + 1) / double(CrossfadeFrames + 1);
+            const uint8_t* pPre = &src[size_t(uiLoopStart - CrossfadeFrames + i) * FrameSize];
+            uint8_t*       pEnd = &buf[size_t(uiLoopEnd - CrossfadeFrames + i) * FrameSize];
+            for (uint c = 0; c < ChannelCount; ++c) {
+                const double pre = getSample(&pPre[c * BytesPerSample], BytesPerSample);
+                const double end = getSample(&pEnd[c * BytesPerSample], BytesPerSample);
+                setSample(&pEnd[c * BytesPerSample], BytesPerSample, int32_t(end + fadeIn * (pre - end)));
+            }
+        }
+
+        // repeat the (crossfaded) loop up to the end of the buffer
+        const uint8_t* pLoop = &buf[size_t(uiLoopStart) * FrameSize];
+        uint8_t*       pDst  = &buf[size_t(uiLoopEnd) * FrameSize];
+        for (size_t left = (frames - uiLoopEnd) * FrameSize; left; ) {
+            const size_t n = (left < size_t(LoopSize) * FrameSize) ? left : size_t(LoopSize) * FrameSize;
+            memcpy(pDst, pLoop, n);
+            pDst += n;
+            left -= n;
+        }
+    }
+
+    UnrolledLoop::~UnrolledLoop() {
+        delete[] pBuffer;
+    }
+
+} // namespace LinuxSampler
@@ -0,0 +1,113 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_UNROLLEDLOOP_H__
+#define __LS_UNROLLEDLOOP_H__
+
+#include "../../common/global_private.h"
+
+namespace LinuxSampler {
+
+    /** @brief Sample loop unrolled to a contiguous RAM buffer
+     *
+     * Copy of the head of a (completely RAM cached) sample up to the end
+     * of its loop, where the loop is repeated (unrolled) as many times as
+     * needed to be at least a given amount of sample points long. An
+     * optional crossfade between the end of the loop and the sample points
+     * right before the loop start is precomputed, and the buffer is
+     * followed by further repetitions of the loop, so the interpolator can
+     * read ahead across the loop end without hearing anything else than
+     * the loop itself.
+     *
+     * Voices playing an endless loop from RAM use this buffer instead of
+     * the sample's RAM cache, so they have to wrap around the loop far
+     * less often. The buffer is created when the instrument is loaded and
+     * is not modified afterwards (it is replaced when the instrument is
+     * reloaded for a larger audio fragment size).
+     */
+    class UnrolledLoop {
+    public:
+        /**
+         * Unrolls the given loop of the given sample data.
+         *
+         * @param pCache          - RAM cache of the sample (must at least contain all sample points up to the loop end)
+         * @param FrameSize       - size of one sample point (all channels) in bytes
+         * @param ChannelCount    - number of audio channels of the sample
+         * @param LoopStart       - first sample point of the loop
+         * @param LoopSize        - length of the loop (in sample points)
+         * @param MinLoopSize     - min. length of the unrolled loop (in sample points)
+         * @param CrossfadeFrames - length of the loop crossfade (in sample points, 0 for none)
+         * @param ReadAheadFrames - amount of sample points the interpolator may read beyond the loop end
+         */
+        UnrolledLoop(const void* pCache, uint FrameSize, uint ChannelCount, uint LoopStart, uint LoopSize, uint MinLoopSize, uint CrossfadeFrames, uint ReadAheadFrames);
+        ~UnrolledLoop();
+
+        /**
+         * Returns the sample data (starting with the first sample point of
+         * the sample).
+         */
+        sample_t* GetBuffer() const { return (sample_t*) pBuffer; }
+
+        /**
+         * Returns the first sample point of the loop, which is the same as
+         * of the original loop.
+         */
+        uint GetLoopStart() const { return uiLoopStart; }
+
+        /**
+         * Returns the end of the unrolled loop (which is the first sample
+         * point after the unrolled loop).
+         */
+        uint GetLoopEnd() const { return uiLoopStart + uiLoopSize; }
+
+        /**
+         * Returns the length of the unrolled loop (in sample points), which
+         * is a multiple of the original loop's length.
+         */
+        uint GetLoopSize() const { return uiLoopSize; }
+
+        /**
+         * Returns the amount of sample points the interpolator may read
+         * beyond the end of the unrolled loop.
+         */
+        uint GetReadAhead() const { return uiReadAhead; }
+
+        /**
+         * Returns whether it is worth to create an unrolled copy of a loop
+         * with the given parameters, that is either if the loop is shorter
+         * than @a MinLoopSize or if it has a crossfade.
+         */
+        static bool IsWorthwhile(uint LoopSize, uint MinLoopSize, uint CrossfadeFrames) {
+            return LoopSize && (LoopSize < MinLoopSize || CrossfadeFrames);
+        }
+
+    private:
+        int32_t* pBuffer; ///< int32_t to ensure the sample data is at least 4 byte aligned
+        uint     uiLoopStart;
+        uint     uiLoopSize;
+        uint     uiReadAhead;
+    };
+
+} // namespace LinuxSampler
+
+#endif // __LS_UNROLLEDLOOP_H__
@@ -120,15 +120,15 @@ namespace LinuxSampler {
                             if (RAMLoop) SYNTHESIS_MODE_SET_LOOP(SynthesisMode, true); // enable looping
 
                             // render current fragment
-                            Synthesize(Samples, (sample_t*) pSample->GetCache().pStart, Delay);
+                            Synthesize(Samples, (pUnrolledLoop) ? pUnrolledLoop->GetBuffer() : (sample_t*) pSample->GetCache().pStart, Delay);
 
                             if (DiskVoice) {
                                 // check if we reached the allowed limit of the sample RAM cache
-                                if (finalSynthesisParameters.dPos > MaxRAMPos) {
-                                    dmsg(5,("VoiceBase: switching to disk playback (Pos=%f)\n", finalSynthesisParameters.dPos));
+                                if (SynthesisPos() > MaxRAMPos) {
+                                    dmsg(5,("VoiceBase: switching to disk playback (Pos=%f)\n", SynthesisPos()));
                                     this->PlaybackState = Voice::playback_state_disk;
                                 }
-                            } else if (finalSynthesisParameters.dPos >= pSample->GetCache().Size / SmplInfo.FrameSize) {
+                            } else if (!pUnrolledLoop /* endless loop */ && SynthesisPos() >= pSample->GetCache().Size / SmplInfo.FrameSize) {
                                 this->PlaybackState = Voice::playback_state_end;
                             }
                         }
@@ -144,9 +144,9 @@ namespace LinuxSampler {
                                     return;
                                 }
                                 DiskStreamRef.pStream->IncrementReadPos(uint(
-                                    SmplInfo.ChannelCount * (int(finalSynthesisParameters.dPos) - MaxRAMPos)
+                                    SmplInfo.ChannelCount * (int(SynthesisPos()) - MaxRAMPos)
                                 ));
-                                finalSynthesisParameters.dPos -= int(finalSynthesisParameters.dPos);
+                                SynthesisPos() -= int(SynthesisPos());
                                 RealSampleWordsLeftToRead = -1; // -1 means no silence has been added yet
                             }
 
@@ -154,7 +154,7 @@ namespace LinuxSampler {
 
                             // add silence sample at the end if we reached the end of the stream (for the interpolator)
                             if (DiskStreamRef.State == Stream::state_end) {
-                                const int maxSampleWordsPerCycle = (GetEngine()->MaxSamplesPerCycle << CONFIG_MAX_PITCH) * SmplInfo.ChannelCount + 6; // +6 for the interpolator algorithm
+                                const int maxSampleWordsPerCycle = ((GetEngine()->MaxSamplesPerCycle << CONFIG_MAX_PITCH) + MAX_INTERPOLATION_READ_AHEAD) * SmplInfo.ChannelCount;
                                 if (sampleWordsLeftToRead <= maxSampleWordsPerCycle) {
                                     // remember how many sample words there are before any silence has been added
                                     if (RealSampleWordsLeftToRead < 0) RealSampleWordsLeftToRead = sampleWordsLeftToRead;
@@ -167,10 +167,18 @@ namespace LinuxSampler {
                             // render current audio fragment
                             Synthesize(Samples, ptr, Delay);
 
-                            const int iPos = (int) finalSynthesisParameters.dPos;
+                            const int iPos = (int) SynthesisPos();
                             const int readSampleWords = iPos * SmplInfo.ChannelCount; // amount of sample words actually been read
                             DiskStreamRef.pStream->IncrementReadPos(readSampleWords);
-                            finalSynthesisParameters.dPos -= iPos; // just keep fractional part of playback position
+                            DiskStreamRef.pStream->SetDrainRate(readSampleWords, Samples);
+
+                            // wake up the disk thread early if our stream is about to run
+                            // dry, unless its file was read completely already (state_end),
+                            // in which case there is nothing left to refill
+                            if (DiskStreamRef.State == Stream::state_active &&
+                                DiskStreamRef.pStream->GetTimeToUnderrun() < GetEngine()->SampleRate * (DISK_THREAD_LOW_WATER_TIME / 1000000.f))
+                                pDiskThread->Wakeup();
+                            SynthesisPos() -= iPos; // just keep fractional part of playback position
 
                             // change state of voice to 'end' if we really reached the end of the sample data
                             if (RealSampleWordsLeftToRead >= 0) {
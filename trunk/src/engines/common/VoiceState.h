@@ -0,0 +1,103 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2003, 2004 by Benno Senoner and Christian Schoenebeck   *
+ *   Copyright (C) 2005 - 2016 Christian Schoenebeck                       *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_VOICESTATE_H__
+#define __LS_VOICESTATE_H__
+
+#include <string.h>
+
+namespace LinuxSampler {
+
+    /** @brief Hot synthesis state of all voices of an engine
+     *
+     * Keeps those synthesis parameters of all voices of an engine, which
+     * are carried over from one audio fragment to the next one, in one
+     * separate array per parameter (structure of arrays), instead of
+     * keeping them scattered over the large voice objects. Each voice owns
+     * one slot in each array (see AbstractVoice::Slot), so scanning a
+     * parameter of all voices, for example the current volume of all
+     * voices, only touches a few cache lines and can be vectorized by the
+     * compiler.
+     *
+     * The arrays are only (re)allocated by Resize(), which must not be
+     * called by the real-time thread.
+     */
+    class VoiceState {
+        public:
+            double* Pos;         ///< Current playback position of each voice in its sample source buffer (see SynthesisParam::dPos).
+            float*  Pitch;       ///< Final pitch factor of each voice as of the end of its last rendered subfragment.
+            float*  VolumeLeft;  ///< Current final volume of the left channel of each voice.
+            float*  VolumeRight; ///< Current final volume of the right channel of each voice.
+            float*  Cutoff;      ///< Final filter cutoff frequency of each voice as of the end of its last rendered subfragment.
+
+            VoiceState() : Pos(NULL), Pitch(NULL), VolumeLeft(NULL), VolumeRight(NULL), Cutoff(NULL), iSlots(0) {
+            }
+
+            ~VoiceState() {
+                Free();
+            }
+
+            /**
+             * Reallocates the arrays for the given amount of voice slots
+             * and resets the state of all slots to zero.
+             */
+            void Resize(int Slots) {
+                Free();
+                if (Slots <= 0) return;
+                Pos         = new double[Slots];
+                Pitch       = new float[Slots];
+                VolumeLeft  = new float[Slots];
+                VolumeRight = new float[Slots];
+                Cutoff      = new float[Slots];
+                iSlots      = Slots;
+                memset(Pos,         0, Slots * sizeof(double));
+                memset(Pitch,       0, Slots * sizeof(float));
+                memset(VolumeLeft,  0, Slots * sizeof(float));
+                memset(VolumeRight, 0, Slots * sizeof(float));
+                memset(Cutoff,      0, Slots * sizeof(float));
+            }
+
+            /// Returns the amount of voice slots.
+            int Size() const { return iSlots; }
+
+        private:
+            int iSlots;
+
+            void Free() {
+                if (Pos)         delete[] Pos;
+                if (Pitch)       delete[] Pitch;
+                if (VolumeLeft)  delete[] VolumeLeft;
+                if (VolumeRight) delete[] VolumeRight;
+                if (Cutoff)      delete[] Cutoff;
+                Pos = NULL;
+                Pitch = VolumeLeft = VolumeRight = Cutoff = NULL;
+                iSlots = 0;
+            }
+
+            VoiceState(const VoiceState&); // not allowed
+            VoiceState& operator=(const VoiceState&); // not allowed
+    };
+
+} // namespace LinuxSampler
+
+#endif // __LS_VOICESTATE_H__
@@ -36,16 +36,19 @@ namespace gig {
     DiskThread::DiskThread(int MaxStreams, uint BufferWrapElements, InstrumentResourceManager* pInstruments) :
         DiskThreadBase< ::gig::DimensionRegion, InstrumentResourceManager>(MaxStreams, BufferWrapElements, pInstruments)
     {
-        DecompressionBuffer = ::gig::Sample::CreateDecompressionBuffer(CONFIG_STREAM_MAX_REFILL_SIZE);
+        DecompressionBuffers.resize(ReaderCount());
+        for (int i = 0; i < DecompressionBuffers.size(); i++)
+            DecompressionBuffers[i] = ::gig::Sample::CreateDecompressionBuffer(CONFIG_STREAM_MAX_REFILL_SIZE);
         CreateAllStreams(MaxStreams, BufferWrapElements);
     }
 
     DiskThread::~DiskThread() {
-        ::gig::Sample::DestroyDecompressionBuffer(DecompressionBuffer);
+        for (int i = 0; i < DecompressionBuffers.size(); i++)
+            ::gig::Sample::DestroyDecompressionBuffer(DecompressionBuffers[i]);
     }
 
     LinuxSampler::Stream* DiskThread::CreateStream(long BufferSize, uint BufferWrapElements) {
-        return new Stream(&DecompressionBuffer, (uint)BufferSize, BufferWrapElements); // 131072 sample words
+        return new Stream(&DecompressionBuffers[0], (uint)BufferSize, BufferWrapElements); // 131072 sample words
     }
 
     void DiskThread::LaunchStream (
@@ -59,6 +62,8 @@ namespace gig {
         Stream* pGigStream = dynamic_cast<Stream*>(pStream);
         if(!pGigStream) throw Exception("Invalid stream type");
         pGigStream->Launch(hStream, pExportReference, pRgn, SampleOffset, DoLoop);
+        // use the decompression buffer of the thread which refills this stream
+        pGigStream->SetDecompressionBuffer(&DecompressionBuffers[ReaderOf(pGigStream)]);
     }
 }} // namespace LinuxSampler::gig
 
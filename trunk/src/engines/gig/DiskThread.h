@@ -39,7 +39,7 @@ namespace LinuxSampler { namespace gig {
 
     class DiskThread: public LinuxSampler::DiskThreadBase< ::gig::DimensionRegion, InstrumentResourceManager> {
         protected:
-            ::gig::buffer_t DecompressionBuffer; ///< Used for thread safe streaming.
+            std::vector< ::gig::buffer_t> DecompressionBuffers; ///< Used for thread safe streaming, one for each thread refilling the streams (see ReaderCount()).
 
             virtual LinuxSampler::Stream* CreateStream(long BufferSize, uint BufferWrapElements);
 
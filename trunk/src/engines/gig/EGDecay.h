@@ -93,6 +93,23 @@ namespace LinuxSampler { namespace gig {
                 return (Level += Coeff);
             }
 
+            /**
+             * Renders the next \a n levels of the envelope at once, without
+             * advancing it (see advance()).
+             */
+            inline void render(float* pOut, unsigned int n) const {
+                for (unsigned int k = 0; k < n; ++k)
+                    pOut[k] = Level + Coeff * float(k + 1);
+            }
+
+            /**
+             * Advances the envelope by one step to \a level, which has to
+             * be the respective level rendered by render().
+             */
+            inline void advance(float level) {
+                Level = level;
+            }
+
             /**
              * Returns the level which this envelope will have in
              * \a SamplePoints steps. It will not alter anything.
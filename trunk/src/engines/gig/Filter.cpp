@@ -21,6 +21,7 @@
  ***************************************************************************/
 
 #include "Filter.h"
+#include "../../common/global_private.h"
 
 namespace LinuxSampler {
     const LowpassFilter1p         Filter::lp1p;
@@ -38,4 +39,242 @@ namespace LinuxSampler {
     const gig::LowpassFilter      Filter::LPFilter;
     const gig::BandrejectFilter   Filter::BRFilter;
     const gig::LowpassTurboFilter Filter::LPTFilter;
+
+    void Filter::ApplyStereo(Filter& left, Filter& right, float* pL, float* pR, uint uiSamples) {
+        Filter* const filters[2] = { &left, &right };
+        float* const bufs[2] = { pL, pR };
+        if (left.type != right.type || !ApplyParallel(filters, bufs, 2, uiSamples)) {
+            left.Apply(pL, uiSamples);
+            right.Apply(pR, uiSamples);
+        }
+    }
+
+#if HAVE_GCC_VECTOR_EXTENSIONS
+
+namespace {
+
+    inline void KillDenormal(v4sf& f) {
+        #if !HAVE_FPU_FTZ_MODE
+        const v4sf tiny = { 1e-18f, 1e-18f, 1e-18f, 1e-18f };
+        f += tiny;
+        f -= tiny;
+        #endif
+    }
+
+    inline BiquadFilterData& Stage(FilterData& d, int k) {
+        return (k == 0) ? d : (k == 1) ? d.d2 : d.d3;
+    }
+
+    // copies the member m of each lane's filter data to one vector
+    #define GATHER(dst, lane_data) { \
+        v4sf_cells c; \
+        for (int l = 0; l < 4; ++l) c.f[l] = lane_data; \
+        dst = c.v; \
+    }
+
+    // copies each lane of a vector back to the respective filter data
+    #define SCATTER(src, lane_data) { \
+        v4sf_cells c; \
+        c.v = src; \
+        for (int l = 0; l < nLanes; ++l) lane_data = c.f[l]; \
+    }
+
+    /**
+     * Cascade of @a STAGES biquad filters (LinuxSampler::BiquadFilter,
+     * DoubleBiquadFilter, TripleBiquadFilter), one filter per vector lane.
+     */
+    template<int STAGES>
+    void ApplyBiquadLanes(FilterData** pData, int nLanes, float* const* ppBuf, uint uiSamples) {
+        v4sf b0[STAGES], b1[STAGES], b2[STAGES], a1[STAGES], a2[STAGES];
+        v4sf x1[STAGES], x2[STAGES], y1[STAGES], y2[STAGES];
+        for (int k = 0; k < STAGES; ++k) {
+            GATHER(b0[k], Stage(*pData[l], k).b0);
+            GATHER(b1[k], Stage(*pData[l], k).b1);
+            GATHER(b2[k], Stage(*pData[l], k).b2);
+            GATHER(a1[k], Stage(*pData[l], k).a1);
+            GATHER(a2[k], Stage(*pData[l], k).a2);
+            GATHER(x1[k], Stage(*pData[l], k).x1);
+            GATHER(x2[k], Stage(*pData[l], k).x2);
+            GATHER(y1[k], Stage(*pData[l], k).y1);
+            GATHER(y2[k], Stage(*pData[l], k).y2);
+        }
+
+        for (uint i = 0; i < uiSamples; ++i) {
+            v4sf x = { ppBuf[0][i], ppBuf[1][i], ppBuf[2][i], ppBuf[3][i] };
+            v4sf_cells io;
+            for (int k = 0; k < STAGES; ++k) {
+                v4sf y = b0[k] * x + b1[k] * x1[k] + b2[k] * x2[k] +
+                         a1[k] * y1[k] + a2[k] * y2[k];
+                KillDenormal(y);
+                x2[k] = x1[k];
+                x1[k] = x;
+                y2[k] = y1[k];
+                y1[k] = y;
+                x = y;
+            }
+            io.v = x;
+            for (int l = 0; l < nLanes; ++l) ppBuf[l][i] = io.f[l];
+        }
+
+        for (int k = 0; k < STAGES; ++k) {
+            SCATTER(x1[k], Stage(*pData[l], k).x1);
+            SCATTER(x2[k], Stage(*pData[l], k).x2);
+            SCATTER(y1[k], Stage(*pData[l], k).y1);
+            SCATTER(y2[k], Stage(*pData[l], k).y2);
+        }
+    }
+
+    /**
+     * The gig engine filters (LinuxSampler::gig::LowpassFilter and
+     * friends), one filter per vector lane. All gig filter types are
+     * expressed by a generalized feed forward part with the coefficients
+     * c0 .. c3 here. It is summed up in the same order as the scalar
+     * implementations do, so the results are the same.
+     */
+    template<Filter::vcf_type_t TYPE>
+    void ApplyGigLanes(FilterData** pData, int nLanes, float* const* ppBuf, uint uiSamples) {
+        const bool bTurbo  = (TYPE == Filter::vcf_type_gig_lowpassturbo);
+        const bool bScaled = (TYPE == Filter::vcf_type_gig_highpass ||
+                              TYPE == Filter::vcf_type_gig_bandreject);
+        v4sf c0, c1, c2, c3, scale;
+        switch (TYPE) {
+            case Filter::vcf_type_gig_highpass:
+                GATHER(c0, -1.0f);
+                GATHER(c1, 1.0f);
+                GATHER(c2, 1.0f);
+                GATHER(c3, -1.0f);
+                break;
+            case Filter::vcf_type_gig_bandreject:
+                GATHER(c0, 1.0f);
+                GATHER(c1, -1.0f);
+                GATHER(c2, pData[l]->b2);
+                GATHER(c3, 1.0f);
+                break;
+            case Filter::vcf_type_gig_bandpass:
+                GATHER(c0, pData[l]->b0);
+                GATHER(c1, 0.0f);
+                GATHER(c2, pData[l]->b2);
+                GATHER(c3, 0.0f);
+                break;
+            default: // lowpass and lowpass turbo
+                GATHER(c0, pData[l]->b0);
+                GATHER(c1, 0.0f);
+                GATHER(c2, 0.0f);
+                GATHER(c3, 0.0f);
+        }
+        if (bScaled) GATHER(scale, pData[l]->scale);
+        v4sf a1, a2, a3, x1, x2, x3, y1, y2, y3, b20, y21, y22, y23;
+        GATHER(a1, pData[l]->a1);
+        GATHER(a2, pData[l]->a2);
+        GATHER(a3, pData[l]->a3);
+        GATHER(x1, pData[l]->x1);
+        GATHER(x2, pData[l]->x2);
+        GATHER(x3, pData[l]->x3);
+        GATHER(y1, pData[l]->y1);
+        GATHER(y2, pData[l]->y2);
+        GATHER(y3, pData[l]->y3);
+        if (bTurbo) {
+            GATHER(b20, pData[l]->b20);
+            GATHER(y21, pData[l]->y21);
+            GATHER(y22, pData[l]->y22);
+            GATHER(y23, pData[l]->y23);
+        }
+
+        for (uint i = 0; i < uiSamples; ++i) {
+            const v4sf x = { ppBuf[0][i], ppBuf[1][i], ppBuf[2][i], ppBuf[3][i] };
+            v4sf_cells io;
+            v4sf y = c0 * x + c1 * x1 + c2 * x2 + c3 * x3;
+            y = y - a1 * y1 - a2 * y2 - a3 * y3;
+            KillDenormal(y);
+            y3 = y2;
+            y2 = y1;
+            y1 = y;
+            x3 = x2;
+            x2 = x1;
+            x1 = x;
+            if (bTurbo) {
+                y = b20 * y - a1 * y21 - a2 * y22 - a3 * y23;
+                KillDenormal(y);
+                y23 = y22;
+                y22 = y21;
+                y21 = y;
+            } else if (bScaled) {
+                y *= scale;
+            }
+            io.v = y;
+            for (int l = 0; l < nLanes; ++l) ppBuf[l][i] = io.f[l];
+        }
+
+        SCATTER(y1, pData[l]->y1);
+        SCATTER(y2, pData[l]->y2);
+        SCATTER(y3, pData[l]->y3);
+        if (bTurbo) {
+            SCATTER(y21, pData[l]->y21);
+            SCATTER(y22, pData[l]->y22);
+            SCATTER(y23, pData[l]->y23);
+        } else if (TYPE != Filter::vcf_type_gig_lowpass) {
+            // the gig lowpass filters don't have a feed forward state
+            SCATTER(x1, pData[l]->x1);
+            SCATTER(x2, pData[l]->x2);
+            SCATTER(x3, pData[l]->x3);
+        }
+    }
+
+    #undef SCATTER
+    #undef GATHER
+
+} // anonymous namespace
+
+    bool Filter::ApplyParallel(Filter* const* ppFilters, float* const* ppBuf, uint nFilters, uint uiSamples) {
+        // unused lanes are fed with the first filter's data and signal,
+        // their results are discarded
+        FilterData* pData[4];
+        float* pBuf[4];
+        for (uint l = 0; l < 4; ++l) {
+            pData[l] = &ppFilters[l < nFilters ? l : 0]->d;
+            pBuf[l]  = ppBuf[l < nFilters ? l : 0];
+        }
+        switch (ppFilters[0]->type) {
+            case vcf_type_gig_highpass:
+                ApplyGigLanes<vcf_type_gig_highpass>(pData, nFilters, pBuf, uiSamples);
+                return true;
+            case vcf_type_gig_bandreject:
+                ApplyGigLanes<vcf_type_gig_bandreject>(pData, nFilters, pBuf, uiSamples);
+                return true;
+            case vcf_type_gig_bandpass:
+                ApplyGigLanes<vcf_type_gig_bandpass>(pData, nFilters, pBuf, uiSamples);
+                return true;
+            case vcf_type_gig_lowpass:
+                ApplyGigLanes<vcf_type_gig_lowpass>(pData, nFilters, pBuf, uiSamples);
+                return true;
+            case vcf_type_gig_lowpassturbo:
+                ApplyGigLanes<vcf_type_gig_lowpassturbo>(pData, nFilters, pBuf, uiSamples);
+                return true;
+            case vcf_type_2p_lowpass:
+            case vcf_type_2p_highpass:
+            case vcf_type_2p_bandpass:
+            case vcf_type_2p_bandreject:
+                ApplyBiquadLanes<1>(pData, nFilters, pBuf, uiSamples);
+                return true;
+            case vcf_type_4p_lowpass:
+            case vcf_type_4p_highpass:
+                ApplyBiquadLanes<2>(pData, nFilters, pBuf, uiSamples);
+                return true;
+            case vcf_type_6p_lowpass:
+            case vcf_type_6p_highpass:
+                ApplyBiquadLanes<3>(pData, nFilters, pBuf, uiSamples);
+                return true;
+            default: // one pole filters are not worth it
+                return false;
+        }
+    }
+
+#else
+
+    bool Filter::ApplyParallel(Filter* const* ppFilters, float* const* ppBuf, uint nFilters, uint uiSamples) {
+        return false;
+    }
+
+#endif // HAVE_GCC_VECTOR_EXTENSIONS
+
 }
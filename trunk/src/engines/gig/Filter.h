@@ -26,6 +26,7 @@
 #define __LS_GIG_FILTER_H__
 
 #include "../../common/global.h"
+#include "../../common/Features.h"
 
 #if AC_APPLE_UNIVERSAL_BUILD
 # include <libgig/gig.h>
@@ -88,6 +89,9 @@ namespace LinuxSampler {
 
     /**
      * Abstract base class for all filter implementations.
+     *
+     * The filters only prevent denormal numbers by themselves if the FPU
+     * can't flush them to zero (see Features::enableDenormalsAreZeroMode()).
      */
     class FilterBase {
     public:
@@ -97,8 +101,10 @@ namespace LinuxSampler {
         virtual void Reset(FilterData& d) const = 0;
     protected:
         void KillDenormal(float& f) const {
+            #if !HAVE_FPU_FTZ_MODE
             f += 1e-18f;
             f -= 1e-18f;
+            #endif
         }
     };
 
@@ -601,10 +607,28 @@ namespace gig {
             FilterData d;
             const FilterBase* pFilter;
 
+            /**
+             * Applies @a filter on the given block of sample points. The
+             * filter's Apply() method is called by its qualified name, so
+             * that it is resolved at compile time and can be inlined. The
+             * filter state is copied to a local variable, which allows the
+             * compiler to keep it in registers for the whole block, instead
+             * of storing it after each sample point (as @a pBuf might
+             * alias it).
+             */
+            template<class F>
+            inline static void ApplyBlock(const F& filter, FilterData& d, float* pBuf, uint uiSamples) {
+                FilterData s = d;
+                for (uint i = 0; i < uiSamples; ++i)
+                    pBuf[i] = filter.F::Apply(s, pBuf[i]);
+                d = s;
+            }
+
         public:
             Filter() {
                 // set filter type to 'lowpass' by default
                 pFilter = &LPFilter;
+                type    = vcf_type_gig_lowpass;
                 pFilter->Reset(d);
             }
 
@@ -627,6 +651,7 @@ namespace gig {
             };
 
             void SetType(vcf_type_t FilterType) {
+                type = FilterType;
                 switch (FilterType) {
                     case vcf_type_gig_highpass:
                         pFilter = &HPFilter;
@@ -672,10 +697,15 @@ namespace gig {
                         break;
                     default:
                         pFilter = &LPFilter;
+                        type    = vcf_type_gig_lowpass;
                 }
                 pFilter->Reset(d);
             }
 
+            vcf_type_t GetType() const {
+                return type;
+            }
+
             void SetParameters(float cutoff, float resonance, float fs) {
                 pFilter->SetParameters(d, cutoff, resonance, fs);
             }
@@ -687,6 +717,86 @@ namespace gig {
             float Apply(float in) {
                 return pFilter->Apply(d, in);
             }
+
+            /**
+             * Applies the filter on a whole block of sample points (in
+             * place). This should be preferred over calling Apply(float)
+             * for each sample point, since the filter type is resolved only
+             * once per block here, instead of a virtual method call for
+             * each sample point.
+             *
+             * @param pBuf      - sample points to be filtered
+             * @param uiSamples - amount of sample points in @a pBuf
+             */
+            void Apply(float* pBuf, uint uiSamples) {
+                switch (type) {
+                    case vcf_type_gig_highpass:
+                        ApplyBlock(HPFilter, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_gig_bandreject:
+                        ApplyBlock(BRFilter, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_gig_bandpass:
+                        ApplyBlock(BPFilter, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_gig_lowpassturbo:
+                        ApplyBlock(LPTFilter, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_1p_lowpass:
+                        ApplyBlock(lp1p, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_1p_highpass:
+                        ApplyBlock(hp1p, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_2p_lowpass:
+                        ApplyBlock(lp2p, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_2p_highpass:
+                        ApplyBlock(hp2p, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_2p_bandpass:
+                        ApplyBlock(bp2p, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_2p_bandreject:
+                        ApplyBlock(br2p, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_4p_lowpass:
+                        ApplyBlock(lp4p, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_4p_highpass:
+                        ApplyBlock(hp4p, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_6p_lowpass:
+                        ApplyBlock(lp6p, d, pBuf, uiSamples);
+                        break;
+                    case vcf_type_6p_highpass:
+                        ApplyBlock(hp6p, d, pBuf, uiSamples);
+                        break;
+                    default:
+                        ApplyBlock(LPFilter, d, pBuf, uiSamples);
+                }
+            }
+
+            /**
+             * Applies the left and right channel filter of a stereo voice
+             * on their respective block of sample points (in place). If
+             * both are of the same type, they are processed in parallel,
+             * each one in its own lane of a vector register, otherwise
+             * (or for the one pole filters) one by one with
+             * Apply(float*, uint).
+             *
+             * @param left      - filter of the left channel
+             * @param right     - filter of the right channel
+             * @param pL        - sample points of the left channel
+             * @param pR        - sample points of the right channel
+             * @param uiSamples - amount of sample points in each buffer
+             */
+            static void ApplyStereo(Filter& left, Filter& right, float* pL, float* pR, uint uiSamples);
+
+        protected:
+            vcf_type_t type;
+
+            static bool ApplyParallel(Filter* const* ppFilters, float* const* ppBuf, uint nFilters, uint uiSamples);
     };
 
 } //namespace LinuxSampler
@@ -29,6 +29,7 @@
 
 #include "../../common/global_private.h"
 #include "../../plugins/InstrumentEditorFactory.h"
+#include "../common/DiskLatency.h"
 
 namespace LinuxSampler { namespace gig {
 
@@ -649,6 +650,7 @@ namespace LinuxSampler { namespace gig {
             gig->DeleteSample(pSample);
             if (!gig->GetFirstSample()) {
                 dmsg(2,("No more samples in use - freeing gig\n"));
+                DiskLatency::ForgetFile(gig->GetFileName());
                 delete gig;
                 delete riff;
             }
@@ -695,13 +697,17 @@ namespace LinuxSampler { namespace gig {
         }
         if (!pSample->SamplesTotal) return; // skip zero size samples
 
-        if (pSample->SamplesTotal <= CONFIG_PRELOAD_SAMPLES) {
+        const uint preloadSamples = DiskLatency::PreloadSamples(
+            static_cast< ::gig::File*>(pSample->GetParent())->GetFileName(),
+            pSample->SamplesPerSecond, maxSamplesPerCycle
+        );
+        if (pSample->SamplesTotal <= CONFIG_PRELOAD_SAMPLES || pSample->SamplesTotal <= preloadSamples) {
             // Sample is too short for disk streaming, so we load the whole
             // sample into RAM and place 'pAudioIO->FragmentSize << CONFIG_MAX_PITCH'
             // number of '0' samples (silence samples) behind the official buffer
             // border, to allow the interpolator do it's work even at the end of
             // the sample.
-            const uint neededSilenceSamples = uint((maxSamplesPerCycle << CONFIG_MAX_PITCH) + 3);
+            const uint neededSilenceSamples = uint((maxSamplesPerCycle << CONFIG_MAX_PITCH) + MAX_INTERPOLATION_READ_AHEAD);
             const uint currentlyCachedSilenceSamples = uint(pSample->GetCache().NullExtensionSize / pSample->FrameSize);
             if (currentlyCachedSilenceSamples < neededSilenceSamples) {
                 dmsg(3,("Caching whole sample (sample name: \"%s\", sample size: %llu)\n", pSample->pInfo->Name.c_str(), (long long)pSample->SamplesTotal));
@@ -709,8 +715,8 @@ namespace LinuxSampler { namespace gig {
                 dmsg(4,("Cached %llu Bytes, %llu silence bytes.\n", (long long)buf.Size, (long long)buf.NullExtensionSize));
             }
         }
-        else { // we only cache CONFIG_PRELOAD_SAMPLES and stream the other sample points from disk
-            if (!pSample->GetCache().Size) pSample->LoadSampleData(CONFIG_PRELOAD_SAMPLES);
+        else { // we only cache preloadSamples and stream the other sample points from disk
+            if (!pSample->GetCache().Size) pSample->LoadSampleData(preloadSamples);
         }
 
         if (!pSample->GetCache().Size) std::cerr << "Unable to cache sample - maybe memory full!" << std::endl << std::flush;
@@ -985,6 +991,7 @@ namespace LinuxSampler { namespace gig {
             if (deleteInstrument) pResource->DeleteInstrument(instrument);
         }
         if (deleteFile) {
+            DiskLatency::ForgetFile(pResource->GetFileName());
             delete pResource;
             delete (::RIFF::File*) pArg;
         } else {
@@ -52,7 +52,8 @@ namespace LinuxSampler { namespace gig {
             PlaybackState.position = pbs.position;
             PlaybackState.reverse = pbs.reverse;
             PlaybackState.loop_cycles_left = pbs.loop_cycles_left;
-            endofsamplereached = (this->PlaybackState.position >= pSample->SamplesTotal);
+            endofsamplereached = (this->PlaybackState.position >= pSample->SamplesTotal ||
+                                  total_readsamples < SamplesToRead); // no more data in the file
             dmsg(5,("Refilled stream %d with %ld (SamplePos: %lu)", this->hThis, total_readsamples, this->PlaybackState.position));
         }
         else { // normal forward playback
@@ -68,7 +69,8 @@ namespace LinuxSampler { namespace gig {
             // we have to store the position within the sample, because other streams might use the same sample
             this->SampleOffset = pSample->GetPos();
 
-            endofsamplereached = (SampleOffset >= pSample->SamplesTotal);
+            endofsamplereached = (SampleOffset >= pSample->SamplesTotal ||
+                                  SamplesToRead > 0); // no more data in the file
             dmsg(5,("Refilled stream %d with %ld (SamplePos: %lu)", this->hThis, total_readsamples, this->SampleOffset));
         }
 
@@ -102,4 +104,14 @@ namespace LinuxSampler { namespace gig {
         );
     }
 
+    const void* Stream::GetSource() {
+        // all samples of a gig file are read through the same file handle
+        return (pRegion && pRegion->pSample) ? pRegion->pSample->GetParent() : NULL;
+    }
+
+    String Stream::GetSourceFile() {
+        if (!pRegion || !pRegion->pSample) return String();
+        return static_cast< ::gig::File*>(pRegion->pSample->GetParent())->GetFileName();
+    }
+
 }} // namespace LinuxSampler::gig
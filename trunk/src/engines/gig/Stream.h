@@ -50,6 +50,15 @@ namespace LinuxSampler { namespace gig {
                 unsigned long            SampleOffset,
                 bool                     DoLoop
             );
+
+            /// Sets the decompression buffer to be used by Read().
+            void SetDecompressionBuffer( ::gig::buffer_t* pDecompressionBuffer) {
+                this->pDecompressionBuffer = pDecompressionBuffer;
+            }
+
+        protected:
+            virtual const void* GetSource();
+            virtual String GetSourceFile();
     };
 
 
@@ -6,6 +6,8 @@
 #define __LS_SYNTHESIS_PARAM_H__
 
 #include "../../common/global_private.h"
+#include "../EngineChannel.h"
+#include "../common/Mixer.h"
 #include "Filter.h"
 
 namespace LinuxSampler { namespace gig {
@@ -31,6 +33,9 @@ namespace LinuxSampler { namespace gig {
         float*    pOutLeft;
         float*    pOutRight;
         uint      uiToGo;
+        interpolation_t Interpolation; ///< Interpolation algorithm to be used if pitching is required.
+        MixFunction_Fn* pMixFunction;  ///< Mixer kernel for the current subfragment (see Mixer::GetMixFunction()).
+        float     fPeak;               ///< Peak magnitude of the rendered (resampled and filtered) signal before the volume is applied, accumulated by the synthesizer for silence detection (a negative value disables the measurement).
     };
 
 }} // namespace LinuxSampler::gig
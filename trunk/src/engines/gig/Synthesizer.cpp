@@ -27,142 +27,403 @@
 
 #include "Synthesizer.h"
 
-#define SYNTHESIZE(CHAN,LOOP,FILTER,INTERPOLATE,BITDEPTH24)                           \
-        Synthesizer<CHAN,LOOP,FILTER,INTERPOLATE,BITDEPTH24>::SynthesizeSubFragment(  \
+#define SYNTHESIZE(CHAN,LOOP,FILTER,INTERPOLATE,BITDEPTH24,BITDEPTH32,SIMD)                           \
+        Synthesizer<CHAN,LOOP,FILTER,INTERPOLATE,BITDEPTH24,BITDEPTH32,SIMD>::SynthesizeSubFragment(  \
         pFinalParam, pLoop)
 
 namespace LinuxSampler { namespace gig {
 
     void SynthesizeFragment_mode00(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,0,0,0,0);
+        SYNTHESIZE(MONO,0,0,0,0,0,0);
     }
 
     void SynthesizeFragment_mode01(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,0,0,1,0);
+        SYNTHESIZE(MONO,0,0,1,0,0,0);
     }
 
     void SynthesizeFragment_mode02(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,0,1,0,0);
+        SYNTHESIZE(MONO,0,1,0,0,0,0);
     }
 
     void SynthesizeFragment_mode03(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,0,1,1,0);
+        SYNTHESIZE(MONO,0,1,1,0,0,0);
     }
 
     void SynthesizeFragment_mode04(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,1,0,0,0);
+        SYNTHESIZE(MONO,1,0,0,0,0,0);
     }
 
     void SynthesizeFragment_mode05(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,1,0,1,0);
+        SYNTHESIZE(MONO,1,0,1,0,0,0);
     }
 
     void SynthesizeFragment_mode06(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,1,1,0,0);
+        SYNTHESIZE(MONO,1,1,0,0,0,0);
     }
 
     void SynthesizeFragment_mode07(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,1,1,1,0);
+        SYNTHESIZE(MONO,1,1,1,0,0,0);
     }
 
     void SynthesizeFragment_mode08(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,0,0,0,0);
+        SYNTHESIZE(STEREO,0,0,0,0,0,0);
     }
 
     void SynthesizeFragment_mode09(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,0,0,1,0);
+        SYNTHESIZE(STEREO,0,0,1,0,0,0);
     }
 
     void SynthesizeFragment_mode0a(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,0,1,0,0);
+        SYNTHESIZE(STEREO,0,1,0,0,0,0);
     }
 
     void SynthesizeFragment_mode0b(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,0,1,1,0);
+        SYNTHESIZE(STEREO,0,1,1,0,0,0);
     }
 
     void SynthesizeFragment_mode0c(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,1,0,0,0);
+        SYNTHESIZE(STEREO,1,0,0,0,0,0);
     }
 
     void SynthesizeFragment_mode0d(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,1,0,1,0);
+        SYNTHESIZE(STEREO,1,0,1,0,0,0);
     }
 
     void SynthesizeFragment_mode0e(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,1,1,0,0);
+        SYNTHESIZE(STEREO,1,1,0,0,0,0);
     }
 
     void SynthesizeFragment_mode0f(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,1,1,1,0);
+        SYNTHESIZE(STEREO,1,1,1,0,0,0);
     }
 
     void SynthesizeFragment_mode10(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,0,0,0,1);
+        SYNTHESIZE(MONO,0,0,0,1,0,0);
     }
 
     void SynthesizeFragment_mode11(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,0,0,1,1);
+        SYNTHESIZE(MONO,0,0,1,1,0,0);
     }
 
     void SynthesizeFragment_mode12(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,0,1,0,1);
+        SYNTHESIZE(MONO,0,1,0,1,0,0);
     }
 
     void SynthesizeFragment_mode13(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,0,1,1,1);
+        SYNTHESIZE(MONO,0,1,1,1,0,0);
     }
 
     void SynthesizeFragment_mode14(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,1,0,0,1);
+        SYNTHESIZE(MONO,1,0,0,1,0,0);
     }
 
     void SynthesizeFragment_mode15(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,1,0,1,1);
+        SYNTHESIZE(MONO,1,0,1,1,0,0);
     }
 
     void SynthesizeFragment_mode16(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,1,1,0,1);
+        SYNTHESIZE(MONO,1,1,0,1,0,0);
     }
 
     void SynthesizeFragment_mode17(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(MONO,1,1,1,1);
+        SYNTHESIZE(MONO,1,1,1,1,0,0);
     }
 
     void SynthesizeFragment_mode18(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,0,0,0,1);
+        SYNTHESIZE(STEREO,0,0,0,1,0,0);
     }
 
     void SynthesizeFragment_mode19(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,0,0,1,1);
+        SYNTHESIZE(STEREO,0,0,1,1,0,0);
     }
 
     void SynthesizeFragment_mode1a(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,0,1,0,1);
+        SYNTHESIZE(STEREO,0,1,0,1,0,0);
     }
 
     void SynthesizeFragment_mode1b(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,0,1,1,1);
+        SYNTHESIZE(STEREO,0,1,1,1,0,0);
     }
 
     void SynthesizeFragment_mode1c(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,1,0,0,1);
+        SYNTHESIZE(STEREO,1,0,0,1,0,0);
     }
 
     void SynthesizeFragment_mode1d(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,1,0,1,1);
+        SYNTHESIZE(STEREO,1,0,1,1,0,0);
     }
 
     void SynthesizeFragment_mode1e(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,1,1,0,1);
+        SYNTHESIZE(STEREO,1,1,0,1,0,0);
     }
 
     void SynthesizeFragment_mode1f(SynthesisParam* pFinalParam, Loop* pLoop) {
-        SYNTHESIZE(STEREO,1,1,1,1);
+        SYNTHESIZE(STEREO,1,1,1,1,0,0);
     }
 
+    void SynthesizeFragment_mode20(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,0,0,0,0,1);
+    }
+
+    void SynthesizeFragment_mode21(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,0,1,0,0,1);
+    }
+
+    void SynthesizeFragment_mode22(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,1,0,0,0,1);
+    }
+
+    void SynthesizeFragment_mode23(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,1,1,0,0,1);
+    }
+
+    void SynthesizeFragment_mode24(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,0,0,0,0,1);
+    }
+
+    void SynthesizeFragment_mode25(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,0,1,0,0,1);
+    }
+
+    void SynthesizeFragment_mode26(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,1,0,0,0,1);
+    }
+
+    void SynthesizeFragment_mode27(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,1,1,0,0,1);
+    }
+
+    void SynthesizeFragment_mode28(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,0,0,0,0,1);
+    }
+
+    void SynthesizeFragment_mode29(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,0,1,0,0,1);
+    }
+
+    void SynthesizeFragment_mode2a(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,1,0,0,0,1);
+    }
+
+    void SynthesizeFragment_mode2b(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,1,1,0,0,1);
+    }
+
+    void SynthesizeFragment_mode2c(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,0,0,0,0,1);
+    }
+
+    void SynthesizeFragment_mode2d(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,0,1,0,0,1);
+    }
+
+    void SynthesizeFragment_mode2e(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,1,0,0,0,1);
+    }
+
+    void SynthesizeFragment_mode2f(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,1,1,0,0,1);
+    }
+
+    void SynthesizeFragment_mode30(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,0,0,1,0,1);
+    }
+
+    void SynthesizeFragment_mode31(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,0,1,1,0,1);
+    }
+
+    void SynthesizeFragment_mode32(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,1,0,1,0,1);
+    }
+
+    void SynthesizeFragment_mode33(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,1,1,1,0,1);
+    }
+
+    void SynthesizeFragment_mode34(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,0,0,1,0,1);
+    }
+
+    void SynthesizeFragment_mode35(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,0,1,1,0,1);
+    }
+
+    void SynthesizeFragment_mode36(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,1,0,1,0,1);
+    }
+
+    void SynthesizeFragment_mode37(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,1,1,1,0,1);
+    }
+
+    void SynthesizeFragment_mode38(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,0,0,1,0,1);
+    }
+
+    void SynthesizeFragment_mode39(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,0,1,1,0,1);
+    }
+
+    void SynthesizeFragment_mode3a(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,1,0,1,0,1);
+    }
+
+    void SynthesizeFragment_mode3b(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,1,1,1,0,1);
+    }
+
+    void SynthesizeFragment_mode3c(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,0,0,1,0,1);
+    }
+
+    void SynthesizeFragment_mode3d(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,0,1,1,0,1);
+    }
+
+    void SynthesizeFragment_mode3e(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,1,0,1,0,1);
+    }
+
+    void SynthesizeFragment_mode3f(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,1,1,1,0,1);
+    }
+
+#if CONFIG_32BIT_SAMPLES
+    // sample data expanded to 32 bit on load (the 24 bit mode bit is never
+    // set in combination with the 32 bit one)
+
+    void SynthesizeFragment_mode80(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,0,0,0,1,0);
+    }
+
+    void SynthesizeFragment_mode81(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,0,1,0,1,0);
+    }
+
+    void SynthesizeFragment_mode82(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,1,0,0,1,0);
+    }
+
+    void SynthesizeFragment_mode83(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,1,1,0,1,0);
+    }
+
+    void SynthesizeFragment_mode84(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,0,0,0,1,0);
+    }
+
+    void SynthesizeFragment_mode85(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,0,1,0,1,0);
+    }
+
+    void SynthesizeFragment_mode86(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,1,0,0,1,0);
+    }
+
+    void SynthesizeFragment_mode87(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,1,1,0,1,0);
+    }
+
+    void SynthesizeFragment_mode88(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,0,0,0,1,0);
+    }
+
+    void SynthesizeFragment_mode89(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,0,1,0,1,0);
+    }
+
+    void SynthesizeFragment_mode8a(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,1,0,0,1,0);
+    }
+
+    void SynthesizeFragment_mode8b(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,1,1,0,1,0);
+    }
+
+    void SynthesizeFragment_mode8c(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,0,0,0,1,0);
+    }
+
+    void SynthesizeFragment_mode8d(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,0,1,0,1,0);
+    }
+
+    void SynthesizeFragment_mode8e(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,1,0,0,1,0);
+    }
+
+    void SynthesizeFragment_mode8f(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,1,1,0,1,0);
+    }
+
+    void SynthesizeFragment_modea0(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,0,0,0,1,1);
+    }
+
+    void SynthesizeFragment_modea1(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,0,1,0,1,1);
+    }
+
+    void SynthesizeFragment_modea2(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,1,0,0,1,1);
+    }
+
+    void SynthesizeFragment_modea3(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,0,1,1,0,1,1);
+    }
+
+    void SynthesizeFragment_modea4(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,0,0,0,1,1);
+    }
+
+    void SynthesizeFragment_modea5(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,0,1,0,1,1);
+    }
+
+    void SynthesizeFragment_modea6(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,1,0,0,1,1);
+    }
+
+    void SynthesizeFragment_modea7(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(MONO,1,1,1,0,1,1);
+    }
+
+    void SynthesizeFragment_modea8(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,0,0,0,1,1);
+    }
+
+    void SynthesizeFragment_modea9(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,0,1,0,1,1);
+    }
+
+    void SynthesizeFragment_modeaa(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,1,0,0,1,1);
+    }
+
+    void SynthesizeFragment_modeab(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,0,1,1,0,1,1);
+    }
+
+    void SynthesizeFragment_modeac(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,0,0,0,1,1);
+    }
+
+    void SynthesizeFragment_modead(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,0,1,0,1,1);
+    }
+
+    void SynthesizeFragment_modeae(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,1,0,0,1,1);
+    }
+
+    void SynthesizeFragment_modeaf(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE(STEREO,1,1,1,0,1,1);
+    }
+#endif // CONFIG_32BIT_SAMPLES
+
     void* GetSynthesisFunction(int SynthesisMode) {
-        // Mode Bits: (PROF),(IMPL),24BIT,CHAN,LOOP,FILT,INTERP
+        // Mode Bits: 32BIT,(PROF),SIMD,24BIT,CHAN,LOOP,FILT,INTERP
         switch (SynthesisMode) {
             case 0x00: return (void*) SynthesizeFragment_mode00;
             case 0x01: return (void*) SynthesizeFragment_mode01;
@@ -196,6 +457,72 @@ namespace LinuxSampler { namespace gig {
             case 0x1d: return (void*) SynthesizeFragment_mode1d;
             case 0x1e: return (void*) SynthesizeFragment_mode1e;
             case 0x1f: return (void*) SynthesizeFragment_mode1f;
+            case 0x20: return (void*) SynthesizeFragment_mode20;
+            case 0x21: return (void*) SynthesizeFragment_mode21;
+            case 0x22: return (void*) SynthesizeFragment_mode22;
+            case 0x23: return (void*) SynthesizeFragment_mode23;
+            case 0x24: return (void*) SynthesizeFragment_mode24;
+            case 0x25: return (void*) SynthesizeFragment_mode25;
+            case 0x26: return (void*) SynthesizeFragment_mode26;
+            case 0x27: return (void*) SynthesizeFragment_mode27;
+            case 0x28: return (void*) SynthesizeFragment_mode28;
+            case 0x29: return (void*) SynthesizeFragment_mode29;
+            case 0x2a: return (void*) SynthesizeFragment_mode2a;
+            case 0x2b: return (void*) SynthesizeFragment_mode2b;
+            case 0x2c: return (void*) SynthesizeFragment_mode2c;
+            case 0x2d: return (void*) SynthesizeFragment_mode2d;
+            case 0x2e: return (void*) SynthesizeFragment_mode2e;
+            case 0x2f: return (void*) SynthesizeFragment_mode2f;
+            case 0x30: return (void*) SynthesizeFragment_mode30;
+            case 0x31: return (void*) SynthesizeFragment_mode31;
+            case 0x32: return (void*) SynthesizeFragment_mode32;
+            case 0x33: return (void*) SynthesizeFragment_mode33;
+            case 0x34: return (void*) SynthesizeFragment_mode34;
+            case 0x35: return (void*) SynthesizeFragment_mode35;
+            case 0x36: return (void*) SynthesizeFragment_mode36;
+            case 0x37: return (void*) SynthesizeFragment_mode37;
+            case 0x38: return (void*) SynthesizeFragment_mode38;
+            case 0x39: return (void*) SynthesizeFragment_mode39;
+            case 0x3a: return (void*) SynthesizeFragment_mode3a;
+            case 0x3b: return (void*) SynthesizeFragment_mode3b;
+            case 0x3c: return (void*) SynthesizeFragment_mode3c;
+            case 0x3d: return (void*) SynthesizeFragment_mode3d;
+            case 0x3e: return (void*) SynthesizeFragment_mode3e;
+            case 0x3f: return (void*) SynthesizeFragment_mode3f;
+#if CONFIG_32BIT_SAMPLES
+            case 0x80: return (void*) SynthesizeFragment_mode80;
+            case 0x81: return (void*) SynthesizeFragment_mode81;
+            case 0x82: return (void*) SynthesizeFragment_mode82;
+            case 0x83: return (void*) SynthesizeFragment_mode83;
+            case 0x84: return (void*) SynthesizeFragment_mode84;
+            case 0x85: return (void*) SynthesizeFragment_mode85;
+            case 0x86: return (void*) SynthesizeFragment_mode86;
+            case 0x87: return (void*) SynthesizeFragment_mode87;
+            case 0x88: return (void*) SynthesizeFragment_mode88;
+            case 0x89: return (void*) SynthesizeFragment_mode89;
+            case 0x8a: return (void*) SynthesizeFragment_mode8a;
+            case 0x8b: return (void*) SynthesizeFragment_mode8b;
+            case 0x8c: return (void*) SynthesizeFragment_mode8c;
+            case 0x8d: return (void*) SynthesizeFragment_mode8d;
+            case 0x8e: return (void*) SynthesizeFragment_mode8e;
+            case 0x8f: return (void*) SynthesizeFragment_mode8f;
+            case 0xa0: return (void*) SynthesizeFragment_modea0;
+            case 0xa1: return (void*) SynthesizeFragment_modea1;
+            case 0xa2: return (void*) SynthesizeFragment_modea2;
+            case 0xa3: return (void*) SynthesizeFragment_modea3;
+            case 0xa4: return (void*) SynthesizeFragment_modea4;
+            case 0xa5: return (void*) SynthesizeFragment_modea5;
+            case 0xa6: return (void*) SynthesizeFragment_modea6;
+            case 0xa7: return (void*) SynthesizeFragment_modea7;
+            case 0xa8: return (void*) SynthesizeFragment_modea8;
+            case 0xa9: return (void*) SynthesizeFragment_modea9;
+            case 0xaa: return (void*) SynthesizeFragment_modeaa;
+            case 0xab: return (void*) SynthesizeFragment_modeab;
+            case 0xac: return (void*) SynthesizeFragment_modeac;
+            case 0xad: return (void*) SynthesizeFragment_modead;
+            case 0xae: return (void*) SynthesizeFragment_modeae;
+            case 0xaf: return (void*) SynthesizeFragment_modeaf;
+#endif
             default: {
                 std::cerr << "gig::Synthesizer: Invalid Synthesis Mode: " << SynthesisMode << std::endl << std::flush;
                 exit(-1);
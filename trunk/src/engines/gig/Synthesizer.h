@@ -24,9 +24,13 @@
 #ifndef __LS_GIG_SYNTHESIZER_H__
 #define __LS_GIG_SYNTHESIZER_H__
 
+#include <math.h>
+#include <string.h>
+
 #include "../../common/global_private.h"
 #include "../../common/RTMath.h"
 #include "../common/Resampler.h"
+#include "../common/Mixer.h"
 #include "Filter.h"
 #include "SynthesisParam.h"
 
@@ -35,10 +39,10 @@
 #define SYNTHESIS_MODE_SET_LOOP(iMode,bVal)             { if (bVal) iMode |= 0x04; else iMode &= ~0x04; }   /* (un)set mode bit 2 */
 #define SYNTHESIS_MODE_SET_CHANNELS(iMode,bVal)         { if (bVal) iMode |= 0x08; else iMode &= ~0x08; }   /* (un)set mode bit 3 */
 #define SYNTHESIS_MODE_SET_BITDEPTH24(iMode,bVal)       { if (bVal) iMode |= 0x10; else iMode &= ~0x10; }   /* (un)set mode bit 4 */
-//TODO: the Asm implementation mode is currently not implemented anymore, since Asm synthesis code is currently broken!
 #define SYNTHESIS_MODE_SET_IMPLEMENTATION(iMode,bVal)   { if (bVal) iMode |= 0x20; else iMode &= ~0x20; }   /* (un)set mode bit 5 */
 //TODO: the profiling mode is currently not implemented anymore!
 #define SYNTHESIS_MODE_SET_PROFILING(iMode,bVal)        { if (bVal) iMode |= 0x40; else iMode &= ~0x40; }   /* (un)set mode bit 6 */
+#define SYNTHESIS_MODE_SET_BITDEPTH32(iMode,bVal)       { if (bVal) iMode |= 0x80; else iMode &= ~0x80; }   /* (un)set mode bit 7 */
 
 #define SYNTHESIS_MODE_GET_INTERPOLATE(iMode)           (iMode & 0x01)
 #define SYNTHESIS_MODE_GET_FILTER(iMode)                (iMode & 0x02)
@@ -46,6 +50,7 @@
 #define SYNTHESIS_MODE_GET_CHANNELS(iMode)              (iMode & 0x08)
 #define SYNTHESIS_MODE_GET_BITDEPTH24(iMode)            (iMode & 0x10)
 #define SYNTHESIS_MODE_GET_IMPLEMENTATION(iMode)        (iMode & 0x20)
+#define SYNTHESIS_MODE_GET_BITDEPTH32(iMode)            (iMode & 0x80)
 
 
 namespace LinuxSampler { namespace gig {
@@ -65,9 +70,22 @@ namespace LinuxSampler { namespace gig {
      * Implementation of the main synthesis algorithms of the Gigasampler
      * format capable sampler engine. This means resampling / interpolation
      * for pitching the audio signal, looping, filter and amplification.
+     *
+     * The audio signal is rendered in stages: it is resampled to a small
+     * scratch block first, which is then filtered and finally mixed to
+     * the output channels by the (engine independent) Mixer.
+     *
+     * If @a SIMD is true, vector instructions (SSE2, NEON, AltiVec) are
+     * used for resampling and mixing wherever possible, otherwise the pure
+     * scalar C++ implementation is used.
+     *
+     * If @a BITDEPTH32 is true, the sample data has already been expanded
+     * to aligned 32 bit integers when it was loaded (see
+     * CONFIG_32BIT_SAMPLES), otherwise @a BITDEPTH24 selects between 16
+     * bit and packed 24 bit sample data.
      */
-    template<channels_t CHANNELS, bool DOLOOP, bool USEFILTER, bool INTERPOLATE, bool BITDEPTH24>
-    class Synthesizer : public __RTMath<CPP>, public LinuxSampler::Resampler<INTERPOLATE,BITDEPTH24> {
+    template<channels_t CHANNELS, bool DOLOOP, bool USEFILTER, bool INTERPOLATE, bool BITDEPTH24, bool BITDEPTH32, bool SIMD>
+    class Synthesizer : public __RTMath<CPP>, public LinuxSampler::Resampler<INTERPOLATE,BITDEPTH24,BITDEPTH32> {
 
             // declarations of derived functions (see "Name lookup,
             // templates, and accessing members of base classes" in
@@ -75,16 +93,45 @@ namespace LinuxSampler { namespace gig {
             // needed).
             //using LinuxSampler::Resampler<INTERPOLATE>::GetNextSampleMonoCPP;
             //using LinuxSampler::Resampler<INTERPOLATE>::GetNextSampleStereoCPP;
-            using LinuxSampler::Resampler<INTERPOLATE,BITDEPTH24>::Interpolate1StepMonoCPP;
-            using LinuxSampler::Resampler<INTERPOLATE,BITDEPTH24>::Interpolate1StepStereoCPP;
+            typedef LinuxSampler::Resampler<INTERPOLATE,BITDEPTH24,BITDEPTH32> Resampler_t;
+            using LinuxSampler::Resampler<INTERPOLATE,BITDEPTH24,BITDEPTH32>::PosToFixed;
+            using LinuxSampler::Resampler<INTERPOLATE,BITDEPTH24,BITDEPTH32>::FixedToPos;
+            using LinuxSampler::Resampler<INTERPOLATE,BITDEPTH24,BITDEPTH32>::getSample;
 
         public:
         //protected:
 
+            /**
+             * Renders the current subfragment. The playback position
+             * (SynthesisParam::dPos) lags INTERPOLATION_PRE_ROLL sample
+             * points behind the sample point actually heard (see Resampler),
+             * so the loop points are moved accordingly here.
+             */
             static void SynthesizeSubFragment(SynthesisParam* pFinalParam, Loop* pLoop) {
-                if (DOLOOP) {
-                    const float fLoopEnd   = Float(pLoop->uiEnd);
-                    const float fLoopStart = Float(pLoop->uiStart);
+                if (DOLOOP && !INTERPOLATE) {
+                    // no pitch, so the playback position advances exactly one
+                    // sample point per output sample point, thus we can
+                    // handle the loop with pure integer math
+                    const int iLoopEnd   = int(pLoop->uiEnd)   - INTERPOLATION_PRE_ROLL;
+                    const int iLoopStart = int(pLoop->uiStart) - INTERPOLATION_PRE_ROLL;
+                    const int iLoopSize  = pLoop->uiSize;
+                    if (pLoop->uiTotalCycles) {
+                        // render loop (loop count limited)
+                        for (; pFinalParam->uiToGo > 0 && pLoop->uiCyclesLeft; pLoop->uiCyclesLeft -= WrapLoopInt(iLoopStart, iLoopSize, iLoopEnd, &pFinalParam->dPos)) {
+                            const uint uiToGo = Min(pFinalParam->uiToGo, uint(Max(DiffToLoopEndInt(iLoopEnd, pFinalParam->dPos), 1)));
+                            SynthesizeSubSubFragment(pFinalParam, uiToGo);
+                        }
+                        // render on without loop
+                        SynthesizeSubSubFragment(pFinalParam, pFinalParam->uiToGo);
+                    } else { // render loop (endless loop)
+                        for (; pFinalParam->uiToGo > 0; WrapLoopInt(iLoopStart, iLoopSize, iLoopEnd, &pFinalParam->dPos)) {
+                            const uint uiToGo = Min(pFinalParam->uiToGo, uint(Max(DiffToLoopEndInt(iLoopEnd, pFinalParam->dPos), 1)));
+                            SynthesizeSubSubFragment(pFinalParam, uiToGo);
+                        }
+                    }
+                } else if (DOLOOP) {
+                    const float fLoopEnd   = Float(int(pLoop->uiEnd)   - INTERPOLATION_PRE_ROLL);
+                    const float fLoopStart = Float(int(pLoop->uiStart) - INTERPOLATION_PRE_ROLL);
                     const float fLoopSize  = Float(pLoop->uiSize);
                     if (pLoop->uiTotalCycles) {
                         // render loop (loop count limited)
@@ -112,15 +159,26 @@ namespace LinuxSampler { namespace gig {
                 return uint((LoopEnd - *((double *)Pos)) / Pitch);
             }
 
-#if 0
-            //TODO: this method is not in use yet, it's intended to be used for pitch=x.0f where we could use integer instead of float as playback position variable
-            inline static int WrapLoop(const int& LoopStart, const int& LoopSize, const int& LoopEnd, int& Pos) {
-                //TODO: we can easily eliminate the branch here
-                if (Pos < LoopEnd) return 0;
-                Pos = (Pos - LoopEnd) % LoopSize + LoopStart;
+            /**
+             * Returns the difference to the sample's loop end in case no
+             * pitching is performed (integer version of the method above).
+             */
+            inline static int DiffToLoopEndInt(const int LoopEnd, const double& Pos) {
+                return LoopEnd - int(Pos);
+            }
+
+            /**
+             * Integer version of WrapLoop() (see below), used for the
+             * case no pitching is performed. Only the integer part of the
+             * playback position is wrapped, a possible fractional part (left
+             * over from previous pitched rendering) is preserved.
+             */
+            inline static int WrapLoopInt(const int LoopStart, const int LoopSize, const int LoopEnd, double* Pos) {
+                const int pos_int = int(*Pos);
+                if (pos_int < LoopEnd) return 0;
+                *Pos += (pos_int - LoopEnd) % LoopSize + LoopStart - pos_int;
                 return 1;
             }
-#endif
 
             /**
              * This method handles looping of the RAM playback part of the
@@ -136,161 +194,156 @@ namespace LinuxSampler { namespace gig {
                 return 1;
             }
 
-            inline static int32_t getSample(sample_t* src, int pos) {
-                if (BITDEPTH24) {
-                    pos *= 3;
-                    #if WORDS_BIGENDIAN
-                    unsigned char* p = (unsigned char*)src;
-                    return p[pos] << 8 | p[pos + 1] << 16 | p[pos + 2] << 24;
-                    #else
-                    // 24bit read optimization: 
-                    // a misaligned 32bit read and subquent 8 bit shift is faster (on x86)  than reading 3 single bytes and shifting them
-                    return (*((int32_t *)(&((char *)(src))[pos])))<<8;
-                    #endif
-                } else {
-                    return src[pos];
+            inline static void SynthesizeSubSubFragment(SynthesisParam* pFinalParam, uint uiToGo) {
+                // dispatch the interpolation algorithm once here, so it
+                // is a compile time constant within the sample point loops
+                if (INTERPOLATE) {
+                    switch (pFinalParam->Interpolation) {
+                        case interpolation_sinc:
+                            SynthesizeSubSubFragment<interpolation_sinc>(pFinalParam, uiToGo);
+                            return;
+                        case interpolation_cubic:
+                            SynthesizeSubSubFragment<interpolation_cubic>(pFinalParam, uiToGo);
+                            return;
+                        default:
+                            break;
+                    }
                 }
+                SynthesizeSubSubFragment<interpolation_linear>(pFinalParam, uiToGo);
             }
 
+            /**
+             * Renders the requested amount of sample points. This is done
+             * in blocks of (max.) MIXER_BLOCK_SIZE sample points: each block
+             * is first resampled to a scratch block, then filtered (if
+             * requested), its peak is measured (if requested, see
+             * SynthesisParam::fPeak) and finally mixed to the output buffers by the
+             * mixer kernel selected for the current subfragment, which
+             * applies the volume (ramp).
+             */
+            template<interpolation_t ALGO>
             static void SynthesizeSubSubFragment(SynthesisParam* pFinalParam, uint uiToGo) {
-                float fVolumeL = pFinalParam->fFinalVolumeLeft;
-                float fVolumeR = pFinalParam->fFinalVolumeRight;
-                sample_t* pSrc = pFinalParam->pSrc;
-                float* pOutL   = pFinalParam->pOutLeft;
-                float* pOutR   = pFinalParam->pOutRight;
-#ifdef CONFIG_INTERPOLATE_VOLUME
-                float fDeltaL  = pFinalParam->fFinalVolumeDeltaLeft;
-                float fDeltaR  = pFinalParam->fFinalVolumeDeltaRight;
-#endif
-                switch (CHANNELS) {
-                    case MONO: {
-                        float samplePoint;
-                        if (INTERPOLATE) {
-                            double dPos    = pFinalParam->dPos;
-                            float fPitch   = pFinalParam->fFinalPitch;
-                            if (USEFILTER) {
-                                Filter& filterL = pFinalParam->filterLeft;
-                                for (int i = 0; i < uiToGo; ++i) {
-                                    samplePoint = Interpolate1StepMonoCPP(pSrc, &dPos, fPitch);
-                                    samplePoint = filterL.Apply(samplePoint);
-#ifdef CONFIG_INTERPOLATE_VOLUME
-                                    fVolumeL += fDeltaL;
-                                    fVolumeR += fDeltaR;
-#endif
-                                    pOutL[i] += samplePoint * fVolumeL;
-                                    pOutR[i] += samplePoint * fVolumeR;
-                                }
-                            } else { // no filter needed
-                                for (int i = 0; i < uiToGo; ++i) {
-                                    samplePoint = Interpolate1StepMonoCPP(pSrc, &dPos, fPitch);
+                mixer_block_t bufL, bufR;
 #ifdef CONFIG_INTERPOLATE_VOLUME
-                                    fVolumeL += fDeltaL;
-                                    fVolumeR += fDeltaR;
+                const float fDeltaL = pFinalParam->fFinalVolumeDeltaLeft;
+                const float fDeltaR = pFinalParam->fFinalVolumeDeltaRight;
+#else
+                const float fDeltaL = 0.0f;
+                const float fDeltaR = 0.0f;
 #endif
-                                    pOutL[i] += samplePoint * fVolumeL;
-                                    pOutR[i] += samplePoint * fVolumeR;
-                                }
-                            }
-                            pFinalParam->dPos = dPos;
-                        } else { // no interpolation
-                            int pos_offset = (int) pFinalParam->dPos;
-                            if (USEFILTER) {
-                                Filter& filterL = pFinalParam->filterLeft;
-                                for (int i = 0; i < uiToGo; ++i) {
-                                    samplePoint = getSample(pSrc, i + pos_offset);
-                                    samplePoint = filterL.Apply(samplePoint);
-#ifdef CONFIG_INTERPOLATE_VOLUME
-                                    fVolumeL += fDeltaL;
-                                    fVolumeR += fDeltaR;
-#endif
-                                    pOutL[i] += samplePoint * fVolumeL;
-                                    pOutR[i] += samplePoint * fVolumeR;
-                                }
-                            } else { // no filter needed
-                                for (int i = 0; i < uiToGo; ++i) {
-                                    samplePoint = getSample(pSrc, i + pos_offset);
-#ifdef CONFIG_INTERPOLATE_VOLUME
-                                    fVolumeL += fDeltaL;
-                                    fVolumeR += fDeltaR;
-#endif
-                                    pOutL[i] += samplePoint * fVolumeL;
-                                    pOutR[i] += samplePoint * fVolumeR;
-                                }
-                            }
-                            pFinalParam->dPos += uiToGo;
+                while (uiToGo) {
+                    const uint n = Min(uiToGo, uint(MIXER_BLOCK_SIZE));
+                    Resample<ALGO>(pFinalParam, bufL.f, bufR.f, n);
+                    if (USEFILTER) {
+                        if (CHANNELS == MONO) {
+                            pFinalParam->filterLeft.Apply(bufL.f, n);
+                        } else {
+                            Filter::ApplyStereo(pFinalParam->filterLeft, pFinalParam->filterRight, bufL.f, bufR.f, n);
                         }
-                        break;
                     }
-                    case STEREO: {
-                        stereo_sample_t samplePoint;
-                        if (INTERPOLATE) {
-                            double dPos    = pFinalParam->dPos;
-                            float fPitch   = pFinalParam->fFinalPitch;
-                            if (USEFILTER) {
-                                Filter& filterL = pFinalParam->filterLeft;
-                                Filter& filterR = pFinalParam->filterRight;
-                                for (int i = 0; i < uiToGo; ++i) {
-                                    samplePoint = Interpolate1StepStereoCPP(pSrc, &dPos, fPitch);
-                                    samplePoint.left  = filterL.Apply(samplePoint.left);
-                                    samplePoint.right = filterR.Apply(samplePoint.right);
-#ifdef CONFIG_INTERPOLATE_VOLUME
-                                    fVolumeL += fDeltaL;
-                                    fVolumeR += fDeltaR;
-#endif
-                                    pOutL[i] += samplePoint.left  * fVolumeL;
-                                    pOutR[i] += samplePoint.right * fVolumeR;
-                                }
-                            } else { // no filter needed
-                                for (int i = 0; i < uiToGo; ++i) {
-                                    samplePoint = Interpolate1StepStereoCPP(pSrc, &dPos, fPitch);
-#ifdef CONFIG_INTERPOLATE_VOLUME
-                                    fVolumeL += fDeltaL;
-                                    fVolumeR += fDeltaR;
-#endif
-                                    pOutL[i] += samplePoint.left  * fVolumeL;
-                                    pOutR[i] += samplePoint.right * fVolumeR;
-                                }
+                    if (pFinalParam->fPeak >= 0.0f) {
+                        float fPeak = pFinalParam->fPeak;
+                        for (uint k = 0; k < n; ++k) fPeak = Max(fPeak, fabsf(bufL.f[k]));
+                        if (CHANNELS == STEREO)
+                            for (uint k = 0; k < n; ++k) fPeak = Max(fPeak, fabsf(bufR.f[k]));
+                        pFinalParam->fPeak = fPeak;
+                    }
+                    pFinalParam->pMixFunction(
+                        bufL.f, (CHANNELS == MONO) ? bufL.f : bufR.f,
+                        pFinalParam->pOutLeft, pFinalParam->pOutRight, n,
+                        pFinalParam->fFinalVolumeLeft, pFinalParam->fFinalVolumeRight,
+                        fDeltaL, fDeltaR
+                    );
+                    pFinalParam->pOutLeft  += n;
+                    pFinalParam->pOutRight += n;
+                    pFinalParam->uiToGo    -= n;
+                    uiToGo -= n;
+                }
+            }
+
+            /**
+             * Renders @a uiToGo (interpolated) sample points to the given
+             * buffers and advances the playback position accordingly. For
+             * mono samples only @a pL is written.
+             */
+            template<interpolation_t ALGO>
+            static void Resample(SynthesisParam* pFinalParam, float* pL, float* pR, uint uiToGo) {
+                sample_t* pSrc = pFinalParam->pSrc;
+                uint i = 0;
+                if (INTERPOLATE) {
+                    uint64_t phase = PosToFixed(pFinalParam->dPos);
+                    const uint64_t increment = PosToFixed(pFinalParam->fFinalPitch);
+                    // the filter taps of cubic and sinc interpolation reach
+                    // before the sample start during the pre-roll
+                    if (ALGO != interpolation_linear && int64_t(phase) < 0)
+                        i = ResamplePreRoll<ALGO>(pSrc, phase, increment, pL, pR, uiToGo);
+#if HAVE_GCC_VECTOR_EXTENSIONS
+                    if (SIMD) {
+                        // pL and pR are aligned scratch blocks
+                        for (; i + 4 <= uiToGo; i += 4) {
+                            if (CHANNELS == MONO) {
+                                *(v4sf*)&pL[i] = Resampler_t::template Interpolate4StepsMonoSIMD<ALGO>(pSrc, phase, increment);
+                            } else {
+                                Resampler_t::template Interpolate4StepsStereoSIMD<ALGO>(pSrc, phase, increment, *(v4sf*)&pL[i], *(v4sf*)&pR[i]);
                             }
-                            pFinalParam->dPos = dPos;
-                        } else { // no interpolation
-                            int pos_offset = ((int) pFinalParam->dPos) << 1;
-                            if (USEFILTER) {
-                                Filter& filterL = pFinalParam->filterLeft;
-                                Filter& filterR = pFinalParam->filterRight;
-                                for (int i = 0, ii = 0; i < uiToGo; ++i, ii+=2) {
-                                    samplePoint.left = getSample(pSrc, ii + pos_offset);
-                                    samplePoint.right = getSample(pSrc, ii + pos_offset + 1);
-                                    samplePoint.left  = filterL.Apply(samplePoint.left);
-                                    samplePoint.right = filterR.Apply(samplePoint.right);
-#ifdef CONFIG_INTERPOLATE_VOLUME
-                                    fVolumeL += fDeltaL;
-                                    fVolumeR += fDeltaR;
-#endif
-                                    pOutL[i] += samplePoint.left  * fVolumeL;
-                                    pOutR[i] += samplePoint.right * fVolumeR;
-                                }
-                            } else { // no filter needed
-                                for (int i = 0, ii = 0; i < uiToGo; ++i, ii+=2) {
-                                    samplePoint.left = getSample(pSrc, ii + pos_offset);
-                                    samplePoint.right = getSample(pSrc, ii + pos_offset + 1);
-#ifdef CONFIG_INTERPOLATE_VOLUME
-                                    fVolumeL += fDeltaL;
-                                    fVolumeR += fDeltaR;
+                        }
+                    }
 #endif
-                                    pOutL[i] += samplePoint.left  * fVolumeL;
-                                    pOutR[i] += samplePoint.right * fVolumeR;
-                                }
-                            }
-                            pFinalParam->dPos += uiToGo;
+                    for (; i < uiToGo; ++i) {
+                        if (CHANNELS == MONO) {
+                            pL[i] = Resampler_t::template Interpolate1StepMonoFixed<ALGO>(pSrc, phase, increment);
+                        } else {
+                            stereo_sample_t samplePoint = Resampler_t::template Interpolate1StepStereoFixed<ALGO>(pSrc, phase, increment);
+                            pL[i] = samplePoint.left;
+                            pR[i] = samplePoint.right;
                         }
-                        break;
+                    }
+                    pFinalParam->dPos = FixedToPos(phase);
+                } else { // no interpolation
+                    const int pos_offset = int(floor(pFinalParam->dPos)) + INTERPOLATION_PRE_ROLL;
+                    for (; i < uiToGo; ++i) {
+                        if (CHANNELS == MONO) {
+                            pL[i] = getSample(pSrc, pos_offset + i);
+                        } else {
+                            pL[i] = getSample(pSrc, (pos_offset + i) << 1);
+                            pR[i] = getSample(pSrc, ((pos_offset + i) << 1) + 1);
+                        }
+                    }
+                    pFinalParam->dPos += uiToGo;
+                }
+            }
+
+            /**
+             * Renders the sample points of the pre-roll whose filter taps
+             * would read before the start of the source buffer. Those source
+             * sample points are silence, so the head of the source buffer is
+             * copied behind a block of silence on the stack, which is then
+             * read instead. Stops at the first sample point at or after the
+             * sample start whose index is a multiple of 4, so the SIMD
+             * implementation continues on aligned output blocks.
+             *
+             * @returns amount of sample points rendered
+             */
+            template<interpolation_t ALGO>
+            static uint ResamplePreRoll(sample_t* pSrc, uint64_t& phase, const uint64_t increment, float* pL, float* pR, uint uiToGo) {
+                const int frameSize = ((CHANNELS == MONO) ? 1 : 2) * (BITDEPTH32 ? 4 : BITDEPTH24 ? 3 : 2);
+                // +1 word for the 32 bit read of the last packed 24 bit sample point
+                int32_t head[(INTERPOLATION_PRE_ROLL + MAX_INTERPOLATION_READ_AHEAD) * 2 + 1];
+                memset(head, 0, INTERPOLATION_PRE_ROLL * frameSize);
+                memcpy((uint8_t*)head + INTERPOLATION_PRE_ROLL * frameSize, pSrc, MAX_INTERPOLATION_READ_AHEAD * frameSize);
+                sample_t* pHead = (sample_t*)((uint8_t*)head + INTERPOLATION_PRE_ROLL * frameSize);
+                uint i = 0;
+                for (; i < uiToGo && (int64_t(phase) < 0 || (i & 3)); ++i) {
+                    sample_t* p = (int64_t(phase) < 0) ? pHead : pSrc;
+                    if (CHANNELS == MONO) {
+                        pL[i] = Resampler_t::template Interpolate1StepMonoFixed<ALGO>(p, phase, increment);
+                    } else {
+                        stereo_sample_t samplePoint = Resampler_t::template Interpolate1StepStereoFixed<ALGO>(p, phase, increment);
+                        pL[i] = samplePoint.left;
+                        pR[i] = samplePoint.right;
                     }
                 }
-                pFinalParam->fFinalVolumeLeft = fVolumeL;
-                pFinalParam->fFinalVolumeRight = fVolumeR;
-                pFinalParam->pOutRight += uiToGo;
-                pFinalParam->pOutLeft  += uiToGo;
-                pFinalParam->uiToGo    -= uiToGo;
+                return i;
             }
     };
 
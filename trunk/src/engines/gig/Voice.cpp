@@ -278,10 +278,10 @@ namespace LinuxSampler { namespace gig {
                            lfo1_internal_depth,
                            pRegion->LFO1ControlDepth,
                            pRegion->LFO1FlipPhase,
-                           pEngine->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                           GetSubfragmentRate());
             pLFO1->updateByMIDICtrlValue(pLFO1->ExtController ? GetGigEngineChannel()->ControllerTable[pLFO1->ExtController] : 0);
             pLFO1->setScriptDepthFactor(pNote->Override.AmpLFODepth);
-            pLFO1->setScriptFrequencyFactor(pNote->Override.AmpLFOFreq, pEngine->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+            pLFO1->setScriptFrequencyFactor(pNote->Override.AmpLFOFreq, GetSubfragmentRate());
         }
     }
 
@@ -324,10 +324,10 @@ namespace LinuxSampler { namespace gig {
                            lfo2_internal_depth,
                            pRegion->LFO2ControlDepth,
                            pRegion->LFO2FlipPhase,
-                           pEngine->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                           GetSubfragmentRate());
             pLFO2->updateByMIDICtrlValue(pLFO2->ExtController ? GetGigEngineChannel()->ControllerTable[pLFO2->ExtController] : 0);
             pLFO2->setScriptDepthFactor(pNote->Override.CutoffLFODepth);
-            pLFO2->setScriptFrequencyFactor(pNote->Override.CutoffLFOFreq, pEngine->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+            pLFO2->setScriptFrequencyFactor(pNote->Override.CutoffLFOFreq, GetSubfragmentRate());
         }
     }
 
@@ -370,10 +370,10 @@ namespace LinuxSampler { namespace gig {
                            lfo3_internal_depth,
                            pRegion->LFO3ControlDepth,
                            false,
-                           pEngine->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                           GetSubfragmentRate());
             pLFO3->updateByMIDICtrlValue(pLFO3->ExtController ? GetGigEngineChannel()->ControllerTable[pLFO3->ExtController] : 0);
             pLFO3->setScriptDepthFactor(pNote->Override.PitchLFODepth);
-            pLFO3->setScriptFrequencyFactor(pNote->Override.PitchLFOFreq, pEngine->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+            pLFO3->setScriptFrequencyFactor(pNote->Override.PitchLFOFreq, GetSubfragmentRate());
         }
     }
 
@@ -484,7 +484,7 @@ namespace LinuxSampler { namespace gig {
                     pRegion->EG1Sustain * (pNote ? pNote->Override.Sustain : 1.f),
                     RTMath::Max(pRegion->EG1Release * velrelease, 0.014) * egInfo.Release,
                     velocityAttenuation,
-                    sampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                    sampleRate / SubfragmentSize);
     }
 
     void Voice::TriggerEG2(const EGInfo& egInfo, double velrelease, double velocityAttenuation, uint sampleRate, uint8_t velocity) {
@@ -504,7 +504,7 @@ namespace LinuxSampler { namespace gig {
                     uint(RgnInfo.EG2Sustain),
                     RgnInfo.EG2Release * egInfo.Release * velrelease,
                     velocityAttenuation,
-                    sampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                    sampleRate / SubfragmentSize);
     }
 
     void Voice::ProcessGroupEvent(RTList<Event>::Iterator& itEvent) {
@@ -525,6 +525,7 @@ namespace LinuxSampler { namespace gig {
 
             // kill the voice fast
             pEG1->enterFadeOutStage();
+            bFadingOut = true;
         }
     }
 
@@ -61,7 +61,7 @@ namespace LinuxSampler { namespace gig {
             virtual ~Voice();
             void SetOutput(AudioOutputDevice* pAudioOutputDevice);
             void SetEngine(LinuxSampler::Engine* pEngine);
-            void CalculateFadeOutCoeff(float FadeOutTime, float SampleRate);
+            void CalculateFadeOutCoeff(float FadeOutTime, float SampleRate) OVERRIDE;
             virtual release_trigger_t GetReleaseTriggerFlags() OVERRIDE;
 
         protected:
@@ -30,17 +30,17 @@ namespace LinuxSampler { namespace sf2 {
     }
     
     void EGUnit::EnterReleaseStage() {
-        update(EG::event_release, pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+        update(EG::event_release, pVoice->GetSubfragmentRate());
     }
     
     void EGUnit::CancelRelease() {
-        update(EG::event_cancel_release, pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+        update(EG::event_cancel_release, pVoice->GetSubfragmentRate());
     }
 
     
     void VolEGUnit::Trigger() {
         // set the delay trigger
-        double d = pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+        double d = pVoice->GetSubfragmentRate();
         uiDelayTrigger = pVoice->pRegion->GetEG1PreAttackDelay(pVoice->pPresetRegion) * d;
         ////////////
 
@@ -56,7 +56,7 @@ namespace LinuxSampler { namespace sf2 {
             pVoice->pRegion->GetEG1Decay(pVoice->pPresetRegion),
             sustain,
             pVoice->pRegion->GetEG1Release(pVoice->pPresetRegion),
-            pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE,
+            pVoice->GetSubfragmentRate(),
             false
         );
     }
@@ -86,17 +86,17 @@ namespace LinuxSampler { namespace sf2 {
 
             // if sample has a loop and loop start has been reached in this subfragment, send a special event to EG1 to let it finish the attack hold stage
             /*if (pVoice->SmplInfo.HasLoops && pVoice->Pos <= pVoice->SmplInfo.LoopStart && pVoice->SmplInfo.LoopStart < newPos) {
-                update(EG::event_hold_end, pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+                update(EG::event_hold_end, pVoice->GetSubfragmentRate());
             }*/
             // TODO: ^^^
 
             increment(1);
-            if (!toStageEndLeft()) update(EG::event_stage_end, pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+            if (!toStageEndLeft()) update(EG::event_stage_end, pVoice->GetSubfragmentRate());
          }
     }
     
     void ModEGUnit::Trigger() {
-        double d = pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+        double d = pVoice->GetSubfragmentRate();
         uiDelayTrigger = pVoice->pRegion->GetEG2PreAttackDelay(pVoice->pPresetRegion) * d;
 
         trigger (
@@ -106,7 +106,7 @@ namespace LinuxSampler { namespace sf2 {
             pVoice->pRegion->GetEG2Decay(pVoice->pPresetRegion),
             uint(1000 - pVoice->pRegion->GetEG2Sustain(pVoice->pPresetRegion)),
             pVoice->pRegion->GetEG2Release(pVoice->pPresetRegion),
-            pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE,
+            pVoice->GetSubfragmentRate(),
             true
         );
     }
@@ -134,7 +134,7 @@ namespace LinuxSampler { namespace sf2 {
         
         if (active()) {
             increment(1);
-            if (!toStageEndLeft()) update(EG::event_stage_end, pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
+            if (!toStageEndLeft()) update(EG::event_stage_end, pVoice->GetSubfragmentRate());
         }
     }
 
@@ -144,7 +144,7 @@ namespace LinuxSampler { namespace sf2 {
         Level = 0;
         
         // set the delay trigger
-        double samplerate = pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+        double samplerate = pVoice->GetSubfragmentRate();
         uiDelayTrigger = pVoice->pRegion->GetDelayModLfo(pVoice->pPresetRegion) * samplerate;
         ////////////
             
@@ -170,7 +170,7 @@ namespace LinuxSampler { namespace sf2 {
         Level = 0;
 
         // set the delay trigger
-        double samplerate = pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+        double samplerate = pVoice->GetSubfragmentRate();
         uiDelayTrigger = pVoice->pRegion->GetDelayVibLfo(pVoice->pPresetRegion) * samplerate;
         ////////////
             
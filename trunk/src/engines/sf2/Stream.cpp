@@ -53,7 +53,8 @@ namespace LinuxSampler { namespace sf2 {
             PlaybackState.position = pbs.position;
             PlaybackState.reverse = pbs.reverse;
             PlaybackState.loop_cycles_left = pbs.loop_cycles_left;
-            endofsamplereached = (this->PlaybackState.position >= pSample->GetTotalFrameCount());
+            endofsamplereached = (this->PlaybackState.position >= pSample->GetTotalFrameCount() ||
+                                  total_readsamples < SamplesToRead); // no more data in the file
             dmsg(5,("Refilled stream %d with %ld (SamplePos: %lu)", this->hThis, total_readsamples, this->PlaybackState.position));
         }
         else { // normal forward playback
@@ -69,7 +70,8 @@ namespace LinuxSampler { namespace sf2 {
             // we have to store the position within the sample, because other streams might use the same sample
             this->SampleOffset = pSample->GetPos();
 
-            endofsamplereached = (SampleOffset >= pSample->GetTotalFrameCount());
+            endofsamplereached = (SampleOffset >= pSample->GetTotalFrameCount() ||
+                                  SamplesToRead > 0); // no more data in the file
             dmsg(5,("Refilled stream %d with %ld (SamplePos: %lu)", this->hThis, total_readsamples, this->SampleOffset));
         }
 
@@ -346,6 +346,7 @@ namespace LinuxSampler { namespace sf2 {
         if (itEvent->Param.Note.Key != HostKey()) {
             // kill the voice fast
             SignalRack.EnterFadeOutStage();
+            bFadingOut = true;
         }
     }
 
@@ -54,7 +54,7 @@ namespace LinuxSampler { namespace sf2 {
             virtual ~Voice();
             void SetOutput(AudioOutputDevice* pAudioOutputDevice);
             void SetEngine(LinuxSampler::Engine* pEngine);
-            void CalculateFadeOutCoeff(float FadeOutTime, float SampleRate);
+            void CalculateFadeOutCoeff(float FadeOutTime, float SampleRate) OVERRIDE;
             virtual release_trigger_t GetReleaseTriggerFlags() OVERRIDE;
 
         protected:
@@ -153,7 +153,7 @@ namespace LinuxSampler { namespace sfz {
     DiskThread* Engine::CreateDiskThread() {
         return new DiskThread (
             iMaxDiskStreams,
-            ((pAudioOutputDevice->MaxSamplesPerCycle() << CONFIG_MAX_PITCH) << 1) + 6, //FIXME: assuming stereo
+            ((pAudioOutputDevice->MaxSamplesPerCycle() << CONFIG_MAX_PITCH) + MAX_INTERPOLATION_READ_AHEAD) << 1, //FIXME: assuming stereo
             &instruments
         );
     }
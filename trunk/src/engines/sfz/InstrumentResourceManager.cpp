@@ -30,6 +30,7 @@
 
 #include "../../common/global_private.h"
 #include "../../common/Path.h"
+#include "../common/DiskLatency.h"
 #include "../../plugins/InstrumentEditorFactory.h"
 
 
@@ -117,6 +118,9 @@ namespace LinuxSampler { namespace sfz {
             float localProgress = (float) i / (float) regionCount;
             DispatchResourceProgressEvent(Key, localProgress);
             CacheInitialSamples(pInstrument->regions[i]->GetSample(), maxSamplesPerCycle);
+            #if CONFIG_UNROLL_LOOPS
+            UnrollLoop(pInstrument->regions[i], maxSamplesPerCycle);
+            #endif
             //pInstrument->regions[i]->GetSample()->Close();
         }
         dmsg(1,("OK\n"));
@@ -143,6 +147,58 @@ namespace LinuxSampler { namespace sfz {
         delete pEntry;
     }
 
+    /**
+     * Creates an unrolled copy of the given region's loop, if the loop is an
+     * endless loop of a sample which is completely cached in RAM and if the
+     * loop is either shorter than the amount of sample points a voice may
+     * consume in one audio fragment or has a crossfade (which is then
+     * precomputed). Whether the sample is completely cached depends on the
+     * preload size the sample was cached with (see GetPreloadSamples()), so
+     * this has to be called after CacheInitialSamples(). An unrolled loop
+     * created for a smaller audio fragment size is replaced.
+     */
+    void InstrumentResourceManager::UnrollLoop(::sfz::Region* pRegion, uint maxSamplesPerCycle) {
+        Sample* pSample = pRegion->pSample;
+        if (!pSample || !pRegion->HasLoop() || pRegion->GetLoopCount()) return;
+
+        Sample::buffer_t cache = pSample->GetCache();
+        const unsigned long cachedFrames = cache.Size / pSample->GetFrameSize();
+        const uint loopStart = pRegion->GetLoopStart();
+        const uint loopSize  = pRegion->GetLoopEnd() - loopStart;
+        const uint minLoopSize = maxSamplesPerCycle << CONFIG_MAX_PITCH;
+        const uint crossfade   = (pRegion->loop_crossfade) ? uint(*pRegion->loop_crossfade * pSample->GetSampleRate()) : 0;
+        // the interpolator may read as far beyond the loop end as beyond
+        // the end of the sample (see CacheInitialSamples())
+        const uint readAhead = (maxSamplesPerCycle << CONFIG_MAX_PITCH) + MAX_INTERPOLATION_READ_AHEAD;
+
+        const bool bUnroll =
+            !pSample->RAMCacheOffset && cachedFrames >= pSample->GetTotalFrameCount() && // not disk streamed
+            loopStart + loopSize <= cachedFrames &&
+            UnrolledLoop::IsWorthwhile(loopSize, minLoopSize, crossfade);
+
+        if (pRegion->pUnrolledLoop) {
+            if (bUnroll && pRegion->pUnrolledLoop->GetReadAhead() >= readAhead) return; // still fine
+            delete pRegion->pUnrolledLoop;
+            pRegion->pUnrolledLoop = NULL;
+        }
+        if (!bUnroll) return;
+
+        pRegion->pUnrolledLoop = new UnrolledLoop(
+            cache.pStart, pSample->GetFrameSize(), pSample->GetChannelCount(),
+            loopStart, loopSize, minLoopSize, crossfade, readAhead
+        );
+        dmsg(3,("Unrolled loop of sample \"%s\" (loop size: %u, unrolled: %u)\n", pSample->GetName().c_str(), loopSize, pRegion->pUnrolledLoop->GetLoopSize()));
+    }
+
+    uint InstrumentResourceManager::GetPreloadSamples(Sample* pSample, uint maxSamplesPerCycle) {
+        // samples which can be memory mapped are "cached" as a whole, so
+        // they are played without disk streaming at all
+        SampleFile* pSampleFile = dynamic_cast<SampleFile*>(pSample);
+        if (pSampleFile && pSampleFile->IsMappable()) return uint(pSample->GetTotalFrameCount());
+        // the name of sfz samples is their file name
+        return DiskLatency::PreloadSamples(pSample->GetName(), pSample->GetSampleRate(), maxSamplesPerCycle);
+    }
+
     void InstrumentResourceManager::DeleteRegionIfNotUsed(::sfz::Region* pRegion, region_info_t* pRegInfo) {
         ::sfz::File* file = pRegInfo->file;
         if (file == NULL) return;
@@ -78,9 +78,12 @@ namespace LinuxSampler { namespace sfz {
             virtual void               Destroy(::sfz::Instrument* pResource, void* pArg);
             virtual void               DeleteRegionIfNotUsed(::sfz::Region* pRegion, region_info_t* pRegInfo);
             virtual void               DeleteSampleIfNotUsed(Sample* pSample, region_info_t* pRegInfo);
+            virtual uint               GetPreloadSamples(Sample* pSample, uint maxSamplesPerCycle) OVERRIDE;
         private:
             typedef ResourceConsumer< ::sfz::File> SfzConsumer;
 
+            void UnrollLoop(::sfz::Region* pRegion, uint maxSamplesPerCycle);
+
             class SfzResourceManager : public ResourceManager<String, ::sfz::File> {
                 protected:
                     // implementation of derived abstract methods from 'ResourceManager'
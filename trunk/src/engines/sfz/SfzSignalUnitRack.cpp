@@ -37,7 +37,7 @@ namespace LinuxSampler { namespace sfz {
     }
     
     double SfzSignalUnit::GetSampleRate() {
-        return pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+        return pVoice->GetSubfragmentRate();
     }
     
     float SfzSignalUnit::GetInfluence(ArrayList< ::sfz::CC>& cc) {
@@ -451,7 +451,7 @@ namespace LinuxSampler { namespace sfz {
     }
      
     double CCUnit::GetSampleRate() {
-        return pVoice->GetSampleRate() / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+        return pVoice->GetSubfragmentRate();
     }
     
     
@@ -28,13 +28,20 @@
 #include "Stream.h"
 #include "../../common/global_private.h"
 
+#if CONFIG_32BIT_SAMPLES
+// 24 bit and float samples are streamed as 32 bit integers (see SampleFile)
+# define SFZ_STREAM_MAX_BYTES_PER_SAMPLE 4
+#else
+# define SFZ_STREAM_MAX_BYTES_PER_SAMPLE 3
+#endif
+
 namespace LinuxSampler { namespace sfz {
 
     Stream::Stream (
         uint BufferSize,
         uint BufferWrapElements,
         ::sfz::SampleManager* pSampleManager
-    ) : LinuxSampler::StreamBase< ::sfz::Region>(BufferSize, BufferWrapElements) {
+    ) : LinuxSampler::StreamBase< ::sfz::Region>(BufferSize, BufferWrapElements, SFZ_STREAM_MAX_BYTES_PER_SAMPLE) {
         this->pSampleManager = pSampleManager;
     }
 
@@ -46,7 +53,8 @@ namespace LinuxSampler { namespace sfz {
         // refill the disk stream buffer
         if (this->DoLoop) { // honor looping
             total_readsamples  = pSample->ReadAndLoop(pBuf, SamplesToRead, &PlaybackState, pRegion);
-            endofsamplereached = (this->PlaybackState.position >= pSample->GetTotalFrameCount());
+            endofsamplereached = (this->PlaybackState.position >= pSample->GetTotalFrameCount() ||
+                                  total_readsamples < SamplesToRead); // no more data in the file
             dmsg(5,("Refilled stream %d with %ld (SamplePos: %lu)", this->hThis, total_readsamples, this->PlaybackState.position));
         }
         else { // normal forward playback
@@ -62,7 +70,8 @@ namespace LinuxSampler { namespace sfz {
             // we have to store the position within the sample, because other streams might use the same sample
             this->SampleOffset = pSample->GetPos();
 
-            endofsamplereached = (SampleOffset >= pSample->GetTotalFrameCount());
+            endofsamplereached = (SampleOffset >= pSample->GetTotalFrameCount() ||
+                                  SamplesToRead > 0); // no more data in the file
             dmsg(5,("Refilled stream %d with %ld (SamplePos: %lu)", this->hThis, total_readsamples, this->SampleOffset));
         }
 
@@ -73,6 +82,14 @@ namespace LinuxSampler { namespace sfz {
         return total_readsamples;
     }
 
+    const void* Stream::GetSource() {
+        return (pRegion) ? pRegion->pSample : NULL;
+    }
+
+    String Stream::GetSourceFile() {
+        return (pRegion && pRegion->pSample) ? pRegion->pSample->GetFile() : String();
+    }
+
     void Stream::Kill() {
         if(pRegion) pSampleManager->SetSampleNotInUse(pRegion->pSample, pRegion);
         StreamBase< ::sfz::Region>::Kill();
@@ -44,6 +44,10 @@ namespace LinuxSampler { namespace sfz {
                 bool            DoLoop
             );
 
+        protected:
+            virtual const void* GetSource();
+            virtual String GetSourceFile();
+
         private:
             ::sfz::SampleManager* pSampleManager;
     };
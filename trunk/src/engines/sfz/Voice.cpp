@@ -296,6 +296,7 @@ namespace LinuxSampler { namespace sfz {
             } else {
                 // kill the voice fast
                 SignalRack.EnterFadeOutStage();
+                bFadingOut = true;
             }
         }
     }
@@ -305,7 +306,7 @@ namespace LinuxSampler { namespace sfz {
 
         if (DiskVoice && Pos > pSample->MaxOffset) {
             // The offset is applied to the RAM buffer
-            finalSynthesisParameters.dPos = 0;
+            SynthesisPos() = -INTERPOLATION_PRE_ROLL;
             Pos = 0;
         }
     }
@@ -52,7 +52,7 @@ namespace LinuxSampler { namespace sfz {
             virtual ~Voice();
             void SetOutput(AudioOutputDevice* pAudioOutputDevice);
             void SetEngine(LinuxSampler::Engine* pEngine);
-            void CalculateFadeOutCoeff(float FadeOutTime, float SampleRate);
+            void CalculateFadeOutCoeff(float FadeOutTime, float SampleRate) OVERRIDE;
             virtual release_trigger_t GetReleaseTriggerFlags() OVERRIDE;
 
             virtual void VoiceFreed() OVERRIDE { SignalRack.Reset(); }
@@ -87,6 +87,7 @@ namespace LinuxSampler { namespace sfz {
             virtual void             ProcessGroupEvent(RTList<Event>::Iterator& itEvent) OVERRIDE;
             virtual void             SetSampleStartOffset() OVERRIDE;
             virtual int              GetRAMCacheOffset() OVERRIDE { return pRegion->pSample->RAMCacheOffset; }
+            virtual const UnrolledLoop* GetUnrolledLoop() OVERRIDE { return pRegion->pUnrolledLoop; }
             virtual int              CalculatePan(uint8_t pan) OVERRIDE;
 
         private:
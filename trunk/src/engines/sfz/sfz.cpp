@@ -127,11 +127,13 @@ namespace sfz
     Region::Region()
     {
         pSample = NULL;
+        pUnrolledLoop = NULL;
         seq_counter = 1;
     }
 
     Region::~Region()
     {
+        if (pUnrolledLoop) delete pUnrolledLoop;
         DestroySampleIfNotUsed();
     }
 
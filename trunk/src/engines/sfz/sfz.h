@@ -33,6 +33,7 @@
 
 #include "../common/SampleFile.h"
 #include "../common/SampleManager.h"
+#include "../common/UnrolledLoop.h"
 #include "../../common/ArrayList.h"
 #include "../../common/optional.h"
 #include "../../common/Exception.h"
@@ -592,6 +593,9 @@ namespace sfz
         Sample* GetSample(bool create = true);
         void DestroySampleIfNotUsed();
 
+        /// Unrolled copy of the loop for RAM playback (or NULL), created by the engine when the instrument is loaded
+        LinuxSampler::UnrolledLoop* pUnrolledLoop;
+
         Region*      GetParent() { return this; }; // needed by EngineBase
         Instrument*  GetInstrument() { return pInstrument; }
         void         SetInstrument(Instrument* pInstrument) { this->pInstrument = pInstrument; }
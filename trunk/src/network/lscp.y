@@ -202,7 +202,7 @@ void yyerror(void* x, const char* s) {
 %type <Char> char char_base alpha_char digit digit_oct digit_hex escape_seq escape_seq_octal escape_seq_hex
 %type <Dotnum> real dotnum volume_value boolean control_value
 %type <Number> number sampler_channel instrument_index fx_send_id audio_channel_index device_index effect_index effect_instance effect_chain chain_pos input_control midi_input_channel_index midi_input_port_index midi_map midi_bank midi_prog midi_ctrl
-%type <String> string string_escaped text text_escaped text_escaped_base stringval stringval_escaped digits param_val_list param_val query_val filename module effect_system db_path map_name entry_name fx_send_name effect_name engine_name line statement command add_instruction create_instruction destroy_instruction get_instruction list_instruction load_instruction send_instruction set_chan_instruction load_instr_args load_engine_args audio_output_type_name midi_input_type_name remove_instruction unmap_instruction set_instruction subscribe_event unsubscribe_event map_instruction reset_instruction clear_instruction find_instruction move_instruction copy_instruction scan_mode edit_instruction format_instruction append_instruction insert_instruction
+%type <String> string string_escaped text text_escaped text_escaped_base stringval stringval_escaped digits param_val_list param_val query_val filename module effect_system db_path map_name entry_name fx_send_name effect_name engine_name line statement command add_instruction create_instruction destroy_instruction get_instruction list_instruction load_instruction send_instruction set_chan_instruction load_instr_args load_engine_args audio_output_type_name midi_input_type_name remove_instruction unmap_instruction set_instruction subscribe_event unsubscribe_event map_instruction reset_instruction clear_instruction find_instruction move_instruction copy_instruction scan_mode edit_instruction format_instruction append_instruction insert_instruction interpolation_algorithm voice_steal_algorithm
 %type <FillResponse> buffer_size_type
 %type <KeyValList> key_val_list query_val_list
 %type <LoadMode> instr_load_mode
@@ -408,6 +408,7 @@ get_instruction       :  AVAILABLE_ENGINES
                       |  TOTAL_STREAM_COUNT                                                         { $$ = LSCPSERVER->GetTotalStreamCount();                           }
                       |  TOTAL_VOICE_COUNT                                                          { $$ = LSCPSERVER->GetTotalVoiceCount();                           }
                       |  TOTAL_VOICE_COUNT_MAX                                                      { $$ = LSCPSERVER->GetTotalVoiceCountMax();                        }
+                      |  TOTAL_CULLED_VOICE_COUNT                                                   { $$ = LSCPSERVER->GetTotalCulledVoiceCount();                     }
                       |  MIDI_INSTRUMENTS SP midi_map                                               { $$ = LSCPSERVER->GetMidiInstrumentMappings($3);                  }
                       |  MIDI_INSTRUMENTS SP ALL                                                    { $$ = LSCPSERVER->GetAllMidiInstrumentMappings();                 }
                       |  MIDI_INSTRUMENT SP INFO SP midi_map SP midi_bank SP midi_prog              { $$ = LSCPSERVER->GetMidiInstrumentMapping($5,$7,$9);             }
@@ -425,6 +426,7 @@ get_instruction       :  AVAILABLE_ENGINES
                       |  VOLUME                                                                     { $$ = LSCPSERVER->GetGlobalVolume();                              }
                       |  VOICES                                                                     { $$ = LSCPSERVER->GetGlobalMaxVoices();                           }
                       |  STREAMS                                                                    { $$ = LSCPSERVER->GetGlobalMaxStreams();                          }
+                      |  SILENCE_THRESHOLD                                                          { $$ = LSCPSERVER->GetGlobalSilenceThreshold();                    }
                       |  FILE SP INSTRUMENTS SP filename                                            { $$ = LSCPSERVER->GetFileInstruments($5);                         }
                       |  FILE SP INSTRUMENT SP INFO SP filename SP instrument_index                 { $$ = LSCPSERVER->GetFileInstrumentInfo($7,$9);                   }
                       ;
@@ -454,6 +456,9 @@ set_instruction       :  AUDIO_OUTPUT_DEVICE_PARAMETER SP number SP string '=' p
                       |  VOLUME SP volume_value                                                           { $$ = LSCPSERVER->SetGlobalVolume($3);                            }
                       |  VOICES SP number                                                                 { $$ = LSCPSERVER->SetGlobalMaxVoices($3);                         }
                       |  STREAMS SP number                                                                { $$ = LSCPSERVER->SetGlobalMaxStreams($3);                        }
+                      |  SILENCE_THRESHOLD SP real                                                        { $$ = LSCPSERVER->SetGlobalSilenceThreshold($3);                  }
+                      |  ENGINE SP PIPELINE SP engine_name SP boolean                                     { $$ = LSCPSERVER->SetEnginePipelined($5, $7);                     }
+                      |  ENGINE SP SUBFRAGMENT_SIZE SP engine_name SP number                              { $$ = LSCPSERVER->SetEngineSubfragmentSize($5, $7);               }
                       ;
 
 create_instruction    :  AUDIO_OUTPUT_DEVICE SP string SP key_val_list  { $$ = LSCPSERVER->CreateAudioOutputDevice($3,$5); }
@@ -515,6 +520,11 @@ set_chan_instruction  :  AUDIO_OUTPUT_DEVICE SP sampler_channel SP device_index
                       |  VOLUME SP sampler_channel SP volume_value                                                           { $$ = LSCPSERVER->SetVolume($5, $3);                 }
                       |  MUTE SP sampler_channel SP boolean                                                                  { $$ = LSCPSERVER->SetChannelMute($5, $3);            }
                       |  SOLO SP sampler_channel SP boolean                                                                  { $$ = LSCPSERVER->SetChannelSolo($5, $3);            }
+                      |  INTERPOLATION SP sampler_channel SP interpolation_algorithm                                         { $$ = LSCPSERVER->SetChannelInterpolation($5, $3);   }
+                      |  VOICE_STEALING SP sampler_channel SP voice_steal_algorithm                                          { $$ = LSCPSERVER->SetChannelVoiceStealing($5, $3);   }
+                      |  VOICE_QUOTA SP sampler_channel SP number                                                            { $$ = LSCPSERVER->SetChannelVoiceQuota($5, $3);      }
+                      |  RESERVED_VOICES SP sampler_channel SP number                                                        { $$ = LSCPSERVER->SetChannelReservedVoices($5, $3);  }
+                      |  CPU_BUDGET SP sampler_channel SP real                                                               { $$ = LSCPSERVER->SetChannelCpuBudget($5, $3);       }
                       |  MIDI_INSTRUMENT_MAP SP sampler_channel SP midi_map                                                  { $$ = LSCPSERVER->SetChannelMap($3, $5);             }
                       |  MIDI_INSTRUMENT_MAP SP sampler_channel SP NONE                                                      { $$ = LSCPSERVER->SetChannelMap($3, -1);             }
                       |  MIDI_INSTRUMENT_MAP SP sampler_channel SP DEFAULT                                                   { $$ = LSCPSERVER->SetChannelMap($3, -2);             }
@@ -688,6 +698,18 @@ scan_mode                 :  RECURSIVE      { $$ = "RECURSIVE"; }
                           |  FLAT           { $$ = "FLAT"; }
                           ;
 
+interpolation_algorithm   :  LINEAR  { $$ = "LINEAR"; }
+                          |  CUBIC   { $$ = "CUBIC";  }
+                          |  SINC    { $$ = "SINC";   }
+                          ;
+
+voice_steal_algorithm     :  NONE                 { $$ = "NONE";                }
+                          |  OLDEST_VOICE_ON_KEY  { $$ = "OLDEST_VOICE_ON_KEY"; }
+                          |  OLDEST_KEY           { $$ = "OLDEST_KEY";          }
+                          |  QUIETEST             { $$ = "QUIETEST";            }
+                          |  OLDEST_RELEASED      { $$ = "OLDEST_RELEASED";     }
+                          ;
+
 effect_system             :  string
                           ;
 
@@ -1057,6 +1079,9 @@ TOTAL_VOICE_COUNT    :  'T''O''T''A''L''_''V''O''I''C''E''_''C''O''U''N''T'
 TOTAL_VOICE_COUNT_MAX:  'T''O''T''A''L''_''V''O''I''C''E''_''C''O''U''N''T''_''M''A''X'
                      ;
 
+TOTAL_CULLED_VOICE_COUNT:  'T''O''T''A''L''_''C''U''L''L''E''D''_''V''O''I''C''E''_''C''O''U''N''T'
+                     ;
+
 GLOBAL_INFO          :  'G''L''O''B''A''L''_''I''N''F''O'
                      ;
 
@@ -1252,6 +1277,51 @@ MUTE                  :  'M''U''T''E'
 SOLO                  :  'S''O''L''O'
                       ;
 
+INTERPOLATION         :  'I''N''T''E''R''P''O''L''A''T''I''O''N'
+                      ;
+
+PIPELINE              :  'P''I''P''E''L''I''N''E'
+                      ;
+
+SUBFRAGMENT_SIZE      :  'S''U''B''F''R''A''G''M''E''N''T''_''S''I''Z''E'
+                      ;
+
+SILENCE_THRESHOLD     :  'S''I''L''E''N''C''E''_''T''H''R''E''S''H''O''L''D'
+                      ;
+
+LINEAR                :  'L''I''N''E''A''R'
+                      ;
+
+CUBIC                 :  'C''U''B''I''C'
+                      ;
+
+SINC                  :  'S''I''N''C'
+                      ;
+
+VOICE_STEALING        :  'V''O''I''C''E''_''S''T''E''A''L''I''N''G'
+                      ;
+
+VOICE_QUOTA           :  'V''O''I''C''E''_''Q''U''O''T''A'
+                      ;
+
+RESERVED_VOICES       :  'R''E''S''E''R''V''E''D''_''V''O''I''C''E''S'
+                      ;
+
+CPU_BUDGET            :  'C''P''U''_''B''U''D''G''E''T'
+                      ;
+
+OLDEST_VOICE_ON_KEY   :  'O''L''D''E''S''T''_''V''O''I''C''E''_''O''N''_''K''E''Y'
+                      ;
+
+OLDEST_KEY            :  'O''L''D''E''S''T''_''K''E''Y'
+                      ;
+
+QUIETEST              :  'Q''U''I''E''T''E''S''T'
+                      ;
+
+OLDEST_RELEASED       :  'O''L''D''E''S''T''_''R''E''L''E''A''S''E''D'
+                      ;
+
 VOICES                :  'V''O''I''C''E''S'
                       ;
 
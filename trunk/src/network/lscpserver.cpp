@@ -1184,6 +1184,8 @@ String LSCPServer::GetEngineInfo(String EngineName) {
             Engine* pEngine = EngineFactory::Create(EngineName);
             result.Add("DESCRIPTION", _escapeLscpResponse(pEngine->Description()));
             result.Add("VERSION",     pEngine->Version());
+            result.Add("PIPELINE",    EngineFactory::Pipelined(EngineName));
+            result.Add("SUBFRAGMENT_SIZE", EngineFactory::SubfragmentSize(EngineName));
             EngineFactory::Destroy(pEngine);
         }
         catch (Exception e) {
@@ -1217,6 +1219,12 @@ String LSCPServer::GetChannelInfo(uint uiSamplerChannel) {
         int Mute = 0;
         bool Solo = false;
         String MidiInstrumentMap = "NONE";
+        String Interpolation = "NONE";
+        String VoiceStealing = "NONE";
+        int VoiceQuota = 0;
+        int ReservedVoices = 0;
+        float CpuBudget = 0.0f;
+        float CpuLoad = 0.0f;
 
         if (pEngineChannel) {
             EngineName          = pEngineChannel->EngineName();
@@ -1240,6 +1248,22 @@ String LSCPServer::GetChannelInfo(uint uiSamplerChannel) {
                 MidiInstrumentMap = "DEFAULT";
             else
                 MidiInstrumentMap = ToString(pEngineChannel->GetMidiInstrumentMap());
+            switch (pEngineChannel->GetInterpolation()) {
+                case interpolation_linear: Interpolation = "LINEAR"; break;
+                case interpolation_cubic:  Interpolation = "CUBIC";  break;
+                case interpolation_sinc:   Interpolation = "SINC";   break;
+            }
+            switch (pEngineChannel->GetVoiceStealAlgorithm()) {
+                case voice_steal_algo_none:             VoiceStealing = "NONE";                break;
+                case voice_steal_algo_oldestvoiceonkey: VoiceStealing = "OLDEST_VOICE_ON_KEY"; break;
+                case voice_steal_algo_oldestkey:        VoiceStealing = "OLDEST_KEY";          break;
+                case voice_steal_algo_quietest:         VoiceStealing = "QUIETEST";            break;
+                case voice_steal_algo_oldestreleased:   VoiceStealing = "OLDEST_RELEASED";     break;
+            }
+            VoiceQuota     = pEngineChannel->GetVoiceQuota();
+            ReservedVoices = pEngineChannel->GetReservedVoices();
+            CpuBudget      = pEngineChannel->GetCpuBudget();
+            CpuLoad        = pEngineChannel->GetRenderLoad();
 	}
 
         result.Add("ENGINE_NAME", EngineName);
@@ -1273,6 +1297,12 @@ String LSCPServer::GetChannelInfo(uint uiSamplerChannel) {
         result.Add("MUTE", Mute == -1 ? "MUTED_BY_SOLO" : (Mute ? "true" : "false"));
         result.Add("SOLO", Solo);
         result.Add("MIDI_INSTRUMENT_MAP", MidiInstrumentMap);
+        result.Add("INTERPOLATION", Interpolation);
+        result.Add("VOICE_STEALING", VoiceStealing);
+        result.Add("VOICE_QUOTA", VoiceQuota);
+        result.Add("RESERVED_VOICES", ReservedVoices);
+        result.Add("CPU_BUDGET", CpuBudget);
+        result.Add("CPU_LOAD", CpuLoad);
     }
     catch (Exception e) {
          result.Error(e);
@@ -2162,6 +2192,96 @@ String LSCPServer::SetChannelSolo(bool bSolo, uint uiSamplerChannel) {
     return result.Produce();
 }
 
+/**
+ * Will be called by the parser to select the interpolation algorithm of a
+ * particular sampler channel.
+ */
+String LSCPServer::SetChannelInterpolation(String Algorithm, uint uiSamplerChannel) {
+    dmsg(2,("LSCPServer: SetChannelInterpolation(Algorithm=%s,uiSamplerChannel=%d)\n",Algorithm.c_str(),uiSamplerChannel));
+    LSCPResultSet result;
+    try {
+        EngineChannel* pEngineChannel = GetEngineChannel(uiSamplerChannel);
+
+        if      (Algorithm == "LINEAR") pEngineChannel->SetInterpolation(interpolation_linear);
+        else if (Algorithm == "CUBIC")  pEngineChannel->SetInterpolation(interpolation_cubic);
+        else if (Algorithm == "SINC")   pEngineChannel->SetInterpolation(interpolation_sinc);
+        else throw Exception("Unknown interpolation algorithm: " + Algorithm);
+    } catch (Exception e) {
+        result.Error(e);
+    }
+    return result.Produce();
+}
+
+/**
+ * Will be called by the parser to select the voice stealing algorithm of a
+ * particular sampler channel.
+ */
+String LSCPServer::SetChannelVoiceStealing(String Algorithm, uint uiSamplerChannel) {
+    dmsg(2,("LSCPServer: SetChannelVoiceStealing(Algorithm=%s,uiSamplerChannel=%d)\n",Algorithm.c_str(),uiSamplerChannel));
+    LSCPResultSet result;
+    try {
+        EngineChannel* pEngineChannel = GetEngineChannel(uiSamplerChannel);
+
+        if      (Algorithm == "NONE")                pEngineChannel->SetVoiceStealAlgorithm(voice_steal_algo_none);
+        else if (Algorithm == "OLDEST_VOICE_ON_KEY") pEngineChannel->SetVoiceStealAlgorithm(voice_steal_algo_oldestvoiceonkey);
+        else if (Algorithm == "OLDEST_KEY")          pEngineChannel->SetVoiceStealAlgorithm(voice_steal_algo_oldestkey);
+        else if (Algorithm == "QUIETEST")            pEngineChannel->SetVoiceStealAlgorithm(voice_steal_algo_quietest);
+        else if (Algorithm == "OLDEST_RELEASED")     pEngineChannel->SetVoiceStealAlgorithm(voice_steal_algo_oldestreleased);
+        else throw Exception("Unknown voice stealing algorithm: " + Algorithm);
+    } catch (Exception e) {
+        result.Error(e);
+    }
+    return result.Produce();
+}
+
+/**
+ * Will be called by the parser to limit the amount of voices a particular
+ * sampler channel may use at the same time.
+ */
+String LSCPServer::SetChannelVoiceQuota(int iVoices, uint uiSamplerChannel) {
+    dmsg(2,("LSCPServer: SetChannelVoiceQuota(iVoices=%d,uiSamplerChannel=%d)\n",iVoices,uiSamplerChannel));
+    LSCPResultSet result;
+    try {
+        EngineChannel* pEngineChannel = GetEngineChannel(uiSamplerChannel);
+        pEngineChannel->SetVoiceQuota(iVoices);
+    } catch (Exception e) {
+        result.Error(e);
+    }
+    return result.Produce();
+}
+
+/**
+ * Will be called by the parser to reserve voices of the engine for a
+ * particular sampler channel.
+ */
+String LSCPServer::SetChannelReservedVoices(int iVoices, uint uiSamplerChannel) {
+    dmsg(2,("LSCPServer: SetChannelReservedVoices(iVoices=%d,uiSamplerChannel=%d)\n",iVoices,uiSamplerChannel));
+    LSCPResultSet result;
+    try {
+        EngineChannel* pEngineChannel = GetEngineChannel(uiSamplerChannel);
+        pEngineChannel->SetReservedVoices(iVoices);
+    } catch (Exception e) {
+        result.Error(e);
+    }
+    return result.Produce();
+}
+
+/**
+ * Will be called by the parser to limit the CPU time a particular sampler
+ * channel may spend for rendering its voices.
+ */
+String LSCPServer::SetChannelCpuBudget(double dBudget, uint uiSamplerChannel) {
+    dmsg(2,("LSCPServer: SetChannelCpuBudget(dBudget=%f,uiSamplerChannel=%d)\n",dBudget,uiSamplerChannel));
+    LSCPResultSet result;
+    try {
+        EngineChannel* pEngineChannel = GetEngineChannel(uiSamplerChannel);
+        pEngineChannel->SetCpuBudget(dBudget);
+    } catch (Exception e) {
+        result.Error(e);
+    }
+    return result.Produce();
+}
+
 /**
  * Determines whether there is at least one solo channel in the channel list.
  *
@@ -3269,6 +3389,17 @@ String LSCPServer::GetTotalVoiceCount() {
     return result.Produce();
 }
 
+/**
+ * Will be called by the parser to return the total number of voices faded
+ * out early, because they were inaudible.
+ */
+String LSCPServer::GetTotalCulledVoiceCount() {
+    dmsg(2,("LSCPServer: GetTotalCulledVoiceCount()\n"));
+    LSCPResultSet result;
+    result.Add(pSampler->GetCulledVoiceCount());
+    return result.Produce();
+}
+
 /**
  * Will be called by the parser to return the maximum number of voices.
  */
@@ -3308,6 +3439,42 @@ String LSCPServer::SetGlobalMaxVoices(int iVoices) {
     return result.Produce();
 }
 
+/**
+ * Will be called by the parser to enable or disable pipelined rendering of
+ * all engine instances of the given engine type.
+ */
+String LSCPServer::SetEnginePipelined(String EngineName, bool bPipelined) {
+    dmsg(2,("LSCPServer: SetEnginePipelined(EngineName=%s,bPipelined=%d)\n", EngineName.c_str(), bPipelined));
+    LSCPResultSet result;
+    {
+        LockGuard lock(RTNotifyMutex);
+        try {
+            EngineFactory::SetPipelined(EngineName, bPipelined);
+        } catch (Exception e) {
+            result.Error(e);
+        }
+    }
+    return result.Produce();
+}
+
+/**
+ * Will be called by the parser to set the subfragment size of all engine
+ * instances of the given engine type.
+ */
+String LSCPServer::SetEngineSubfragmentSize(String EngineName, int Samples) {
+    dmsg(2,("LSCPServer: SetEngineSubfragmentSize(EngineName=%s,Samples=%d)\n", EngineName.c_str(), Samples));
+    LSCPResultSet result;
+    {
+        LockGuard lock(RTNotifyMutex);
+        try {
+            EngineFactory::SetSubfragmentSize(EngineName, Samples);
+        } catch (Exception e) {
+            result.Error(e);
+        }
+    }
+    return result.Produce();
+}
+
 /**
  * Will be called by the parser to return the sampler global maximum
  * allowed number of disk streams.
@@ -3355,6 +3522,24 @@ String LSCPServer::SetGlobalVolume(double dVolume) {
     return result.Produce();
 }
 
+String LSCPServer::GetGlobalSilenceThreshold() {
+    LSCPResultSet result;
+    result.Add(ToString(GLOBAL_SILENCE_THRESHOLD)); // see common/global_private.cpp
+    return result.Produce();
+}
+
+String LSCPServer::SetGlobalSilenceThreshold(double dThreshold) {
+    LSCPResultSet result;
+    try {
+        if (dThreshold > 0) throw Exception("Silence threshold may not be above 0 dBFS");
+        GLOBAL_SILENCE_THRESHOLD = dThreshold; // see common/global_private.cpp
+        LSCPServer::SendLSCPNotify(LSCPEvent(LSCPEvent::event_global_info, "SILENCE_THRESHOLD", GLOBAL_SILENCE_THRESHOLD));
+    } catch (Exception e) {
+        result.Error(e);
+    }
+    return result.Produce();
+}
+
 String LSCPServer::GetFileInstruments(String Filename) {
     dmsg(2,("LSCPServer: GetFileInstruments(String Filename=%s)\n",Filename.c_str()));
     LSCPResultSet result;
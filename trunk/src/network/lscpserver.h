@@ -145,6 +145,11 @@ class LSCPServer : public Thread {
         String SetVolume(double dVolume, uint uiSamplerChannel);
         String SetChannelMute(bool bMute, uint uiSamplerChannel);
         String SetChannelSolo(bool bSolo, uint uiSamplerChannel);
+        String SetChannelInterpolation(String Algorithm, uint uiSamplerChannel);
+        String SetChannelVoiceStealing(String Algorithm, uint uiSamplerChannel);
+        String SetChannelVoiceQuota(int iVoices, uint uiSamplerChannel);
+        String SetChannelReservedVoices(int iVoices, uint uiSamplerChannel);
+        String SetChannelCpuBudget(double dBudget, uint uiSamplerChannel);
         String AddOrReplaceMIDIInstrumentMapping(uint MidiMapID, uint MidiBank, uint MidiProg, String EngineType, String InstrumentFile, uint InstrumentIndex, float Volume, MidiInstrumentMapper::mode_t LoadMode, String Name, bool bModal);
         String RemoveMIDIInstrumentMapping(uint MidiMapID, uint MidiBank, uint MidiProg);
         String GetMidiInstrumentMappings(uint MidiMapID);
@@ -226,12 +231,17 @@ class LSCPServer : public Thread {
         String GetTotalStreamCount();
         String GetTotalVoiceCount();
         String GetTotalVoiceCountMax();
+        String GetTotalCulledVoiceCount();
         String GetGlobalMaxVoices();
         String SetGlobalMaxVoices(int iVoices);
+        String SetEnginePipelined(String EngineName, bool bPipelined);
+        String SetEngineSubfragmentSize(String EngineName, int Samples);
         String GetGlobalMaxStreams();
         String SetGlobalMaxStreams(int iStreams);
         String GetGlobalVolume();
         String SetGlobalVolume(double dVolume);
+        String GetGlobalSilenceThreshold();
+        String SetGlobalSilenceThreshold(double dThreshold);
         String GetFileInstruments(String Filename);
         String ListFileInstruments(String Filename);
         String GetFileInstrumentInfo(String Filename, uint InstrumentID);
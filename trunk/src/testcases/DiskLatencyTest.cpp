@@ -0,0 +1,80 @@
+#include "DiskLatencyTest.h"
+
+#include <iostream>
+
+#define SAMPLE_RATE   44100
+#define FRAGMENT_SIZE 128
+#define FAST_LATENCY  150     // microseconds, a fast SSD
+#define HDD_LATENCY   5000    // microseconds, a hard disk
+#define SLOW_LATENCY  2000000 // microseconds, a hard disk spinning up
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DiskLatencyTest);
+
+using namespace std;
+using namespace LinuxSampler;
+
+// the statistics are kept per storage device, so any existing file will do
+static const String file = ".";
+
+static void addLatencies(RTMath::usecs_t Latency, int Count) {
+    for (int i = 0; i < Count; i++)
+        DiskLatency::AddStreamStartLatency(file, Latency);
+}
+
+
+// DiskLatencyTest
+
+void DiskLatencyTest::printTestSuiteName() {
+    cout << "\b \nRunning DiskLatency Tests: " << flush;
+}
+
+void DiskLatencyTest::setUp() {
+}
+
+void DiskLatencyTest::tearDown() {
+    DiskLatency::ForgetFile(file);
+}
+
+// Check if the default preload is used as long as there are not enough
+// measurements on the device.
+void DiskLatencyTest::testPreloadWithoutMeasurements() {
+    addLatencies(FAST_LATENCY, DISK_LATENCY_MIN_MEASUREMENTS - 1);
+    CPPUNIT_ASSERT_EQUAL(uint(CONFIG_PRELOAD_SAMPLES), DiskLatency::PreloadSamples(file, SAMPLE_RATE, FRAGMENT_SIZE));
+}
+
+// sample points a voice transposed up to the max. pitch reads during twice the
+// latency measured on the device, plus one audio fragment
+static uint consumedSamples() {
+    const RTMath::usecs_t latency = DiskLatency::StreamStartLatency(file);
+    return uint(2.0 * double(latency) / 1000000.0 * SAMPLE_RATE * double(1 << CONFIG_MAX_PITCH)) +
+           (FRAGMENT_SIZE << CONFIG_MAX_PITCH);
+}
+
+// Check if the preload covers the measured latency even for voices
+// transposed up to the max. pitch, and if it is clamped to its bounds.
+void DiskLatencyTest::testPreloadClamping() {
+    // fast device: lower bound, unless a voice at max. pitch needs more
+    addLatencies(FAST_LATENCY, DISK_LATENCY_MIN_MEASUREMENTS);
+    uint preload = DiskLatency::PreloadSamples(file, SAMPLE_RATE, FRAGMENT_SIZE);
+    #if CONFIG_ADAPTIVE_PRELOAD
+    CPPUNIT_ASSERT(DiskLatency::StreamStartLatency(file) >= FAST_LATENCY);
+    CPPUNIT_ASSERT(preload >= consumedSamples());
+    CPPUNIT_ASSERT(preload >= CONFIG_PRELOAD_SAMPLES / 8);
+    if (consumedSamples() < CONFIG_PRELOAD_SAMPLES / 8)
+        CPPUNIT_ASSERT_EQUAL(uint(CONFIG_PRELOAD_SAMPLES / 8), preload);
+
+    // more than 0.1% slower stream starts make it a hard disk
+    addLatencies(HDD_LATENCY, 10);
+    preload = DiskLatency::PreloadSamples(file, SAMPLE_RATE, FRAGMENT_SIZE);
+    CPPUNIT_ASSERT(DiskLatency::StreamStartLatency(file) >= HDD_LATENCY);
+    CPPUNIT_ASSERT(preload >= consumedSamples() || preload == CONFIG_PRELOAD_SAMPLES * 8);
+    CPPUNIT_ASSERT(preload <= CONFIG_PRELOAD_SAMPLES * 8);
+
+    // spinning up takes longer than the largest preload allowed covers
+    addLatencies(SLOW_LATENCY, 10);
+    preload = DiskLatency::PreloadSamples(file, SAMPLE_RATE, FRAGMENT_SIZE);
+    CPPUNIT_ASSERT_EQUAL(uint(CONFIG_PRELOAD_SAMPLES * 8), preload);
+    #else
+    CPPUNIT_ASSERT_EQUAL(uint(CONFIG_PRELOAD_SAMPLES), preload);
+    #endif
+}
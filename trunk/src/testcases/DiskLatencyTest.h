@@ -0,0 +1,28 @@
+#ifndef __LS_DISKLATENCYTEST_H__
+#define __LS_DISKLATENCYTEST_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// the disk latency statistics we want to test
+#include "../engines/common/DiskLatency.h"
+
+class DiskLatencyTest : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE(DiskLatencyTest);
+    CPPUNIT_TEST(printTestSuiteName);
+    CPPUNIT_TEST(testPreloadWithoutMeasurements);
+    CPPUNIT_TEST(testPreloadClamping);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp();
+        void tearDown();
+
+        void printTestSuiteName();
+
+        void testPreloadWithoutMeasurements();
+        void testPreloadClamping();
+};
+
+#endif // __LS_DISKLATENCYTEST_H__
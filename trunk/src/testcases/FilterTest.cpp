@@ -0,0 +1,136 @@
+#include "FilterTest.h"
+
+#include "../common/Features.h"
+
+#include <iostream>
+#include <math.h>
+#include <float.h>
+
+#define SAMPLE_RATE  44100
+#define BLOCK_SIZE   128
+#define TAIL_BLOCKS  2000 // about 6s, long enough for all filter tails to decay to zero
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FilterTest);
+
+using namespace std;
+using namespace LinuxSampler;
+
+// filters whose decaying tails are checked (the gig filters expect cutoff and
+// resonance as controller values 0..127)
+static const struct {
+    Filter::vcf_type_t type;
+    float              cutoff;
+    float              resonance;
+} filters[] = {
+    { Filter::vcf_type_gig_lowpass,      40.0f,  20.0f },
+    { Filter::vcf_type_gig_lowpassturbo, 40.0f,  20.0f },
+    { Filter::vcf_type_gig_bandpass,     40.0f,  20.0f },
+    { Filter::vcf_type_1p_lowpass,       200.0f, 0.5f  },
+    { Filter::vcf_type_2p_lowpass,       200.0f, 0.5f  },
+    { Filter::vcf_type_2p_bandpass,      200.0f, 0.5f  },
+    { Filter::vcf_type_4p_lowpass,       200.0f, 0.5f  },
+    { Filter::vcf_type_6p_lowpass,       200.0f, 0.5f  }
+};
+static const int filtersCount = sizeof(filters) / sizeof(filters[0]);
+
+static bool isDenormal(float f) {
+    return f != 0.0f && fabs(f) < FLT_MIN;
+}
+
+// returns true if the FPU currently flushes denormal results to zero
+static bool denormalsAreFlushed() {
+    volatile float f = FLT_MIN;
+    f *= 0.5f;
+    return f == 0.0f;
+}
+
+static void initFilter(Filter& filter, int i) {
+    filter.SetType(filters[i].type);
+    filter.SetParameters(filters[i].cutoff, filters[i].resonance, SAMPLE_RATE);
+    filter.Reset();
+}
+
+
+// FilterTest
+
+void FilterTest::printTestSuiteName() {
+    cout << "\b \nRunning Filter Tests: " << flush;
+}
+
+void FilterTest::setUp() {
+    Features::detect();
+    bDenormalsAreZero = Features::supportsDenormalsAreZeroMode();
+}
+
+void FilterTest::tearDown() {
+}
+
+// Feeds an impulse to the filter, followed by @a iBlocks blocks of silence.
+// pBuf contains the last block afterwards. Returns true if any output sample
+// point was a denormal number.
+bool FilterTest::renderTail(Filter& filter, float* pBuf, int iBlocks) {
+    bool bDenormal = false;
+    for (int k = 0; k < BLOCK_SIZE; ++k) pBuf[k] = 0.0f;
+    pBuf[0] = 1.0f;
+    filter.Apply(pBuf, BLOCK_SIZE);
+    for (int i = 0; i < iBlocks; ++i) {
+        for (int k = 0; k < BLOCK_SIZE; ++k) pBuf[k] = 0.0f;
+        filter.Apply(pBuf, BLOCK_SIZE);
+        for (int k = 0; k < BLOCK_SIZE; ++k)
+            if (isDenormal(pBuf[k])) bDenormal = true;
+    }
+    return bDenormal;
+}
+
+// Check if the FPU actually flushes denormal results to zero in the
+// respective mode, and only in that mode.
+void FilterTest::testDenormalsAreZeroMode() {
+    if (!bDenormalsAreZero) return; // not supported on this system
+    {
+        Features::DenormalsAreZeroScope scope(true);
+        CPPUNIT_ASSERT(denormalsAreFlushed());
+    }
+    {
+        Features::DenormalsAreZeroScope scope(false);
+        CPPUNIT_ASSERT(!denormalsAreFlushed());
+    }
+}
+
+// Check if the tails of all filters decay without going through denormal
+// numbers, either because the FPU flushes them to zero, or because the
+// filters prevent them by themselves on FPUs which can't (in which case the
+// tails just settle at a tiny, but normal level).
+void FilterTest::testDecayingTailIsFlushedToZero() {
+    #if HAVE_FPU_FTZ_MODE
+    if (!bDenormalsAreZero) return; // not supported by this CPU
+    #endif
+    Features::DenormalsAreZeroScope scope(true);
+    float buf[BLOCK_SIZE];
+    for (int i = 0; i < filtersCount; ++i) {
+        Filter filter;
+        initFilter(filter, i);
+        CPPUNIT_ASSERT(!renderTail(filter, buf, TAIL_BLOCKS));
+        #if HAVE_FPU_FTZ_MODE
+        for (int k = 0; k < BLOCK_SIZE; ++k)
+            CPPUNIT_ASSERT(buf[k] == 0.0f);
+        #endif
+    }
+}
+
+// Counter check of the test above: without flush to zero mode, the filter
+// tails do pass through denormal numbers on FPUs which support that mode
+// (since the filters rely on it there).
+void FilterTest::testDecayingTailWithoutFlushToZero() {
+    #if !HAVE_FPU_FTZ_MODE
+    return; // filters prevent denormals by themselves
+    #endif
+    Features::DenormalsAreZeroScope scope(false);
+    float buf[BLOCK_SIZE];
+    bool bDenormal = false;
+    for (int i = 0; i < filtersCount; ++i) {
+        Filter filter;
+        initFilter(filter, i);
+        if (renderTail(filter, buf, TAIL_BLOCKS)) bDenormal = true;
+    }
+    CPPUNIT_ASSERT(bDenormal);
+}
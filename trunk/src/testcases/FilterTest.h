@@ -0,0 +1,34 @@
+#ifndef __LS_FILTERTEST_H__
+#define __LS_FILTERTEST_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// the Filter class we want to test
+#include "../engines/gig/Filter.h"
+
+class FilterTest : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE(FilterTest);
+    CPPUNIT_TEST(printTestSuiteName);
+    CPPUNIT_TEST(testDenormalsAreZeroMode);
+    CPPUNIT_TEST(testDecayingTailIsFlushedToZero);
+    CPPUNIT_TEST(testDecayingTailWithoutFlushToZero);
+    CPPUNIT_TEST_SUITE_END();
+
+    private:
+        bool bDenormalsAreZero; // true if the FPU supports flushing denormals to zero
+
+        bool renderTail(LinuxSampler::Filter& filter, float* pBuf, int iBlocks);
+    public:
+        void setUp();
+        void tearDown();
+
+        void printTestSuiteName();
+
+        void testDenormalsAreZeroMode();
+        void testDecayingTailIsFlushedToZero();
+        void testDecayingTailWithoutFlushToZero();
+};
+
+#endif // __LS_FILTERTEST_H__
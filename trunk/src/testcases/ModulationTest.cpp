@@ -0,0 +1,172 @@
+#include "ModulationTest.h"
+
+#include <iostream>
+#include <math.h>
+
+#define SUBFRAGMENT_RATE  1378 // 44100 Hz / 32 sample points per subfragment
+#define STEPS             4000
+#define MAX_BLOCK_SIZE    16   // same as CONTROL_BLOCK_SIZE of AbstractVoice
+#define RELEASE_STEP      700  // step at which the note is released
+#define MAX_DEVIATION     1e-4f // linear segments rendered step by step accumulate rounding errors, blocks don't
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ModulationTest);
+
+using namespace std;
+using namespace LinuxSampler;
+
+// Renders the LFO wave once step by step and once in blocks of varying size,
+// returns true if both are equal.
+template<class T_LFO>
+static bool blocksEqualSteps(float Frequency, start_level_t StartLevel, bool FlipPhase) {
+    T_LFO lfoSteps(1200.0f);
+    T_LFO lfoBlocks(1200.0f);
+    lfoSteps.trigger(Frequency, StartLevel, 600, 300, FlipPhase, SUBFRAGMENT_RATE);
+    lfoBlocks.trigger(Frequency, StartLevel, 600, 300, FlipPhase, SUBFRAGMENT_RATE);
+    lfoSteps.updateByMIDICtrlValue(64);
+    lfoBlocks.updateByMIDICtrlValue(64);
+    float block[MAX_BLOCK_SIZE];
+    for (int i = 0, n = 1; i < STEPS; i += n, n = n % MAX_BLOCK_SIZE + 1) {
+        lfoBlocks.render(block, n);
+        for (int k = 0; k < n; ++k)
+            if (block[k] != lfoSteps.render()) return false;
+    }
+    return true;
+}
+
+// Envelope generator whose only segment is a power curve (as used by the sfz
+// engine's envelope generators).
+class PowEG : public EG {
+    public:
+        PowEG(float Exp, float Steps) {
+            Level     = 0.0f;
+            Offset    = 0.0f;
+            Coeff     = 1.0f;
+            this->Exp = Exp;
+            X         = 0.0f;
+            XDelta    = 1.0f / Steps;
+            StepsLeft = int(Steps);
+            Segment   = segment_pow;
+        }
+
+        void update(event_t Event, uint SampleRate) {
+            enterEndStage();
+        }
+};
+
+static float processStep(EG& eg) {
+    switch (eg.getSegmentType()) {
+        case EG::segment_lin: return eg.processLin();
+        case EG::segment_exp: return eg.processExp();
+        case EG::segment_pow: return eg.processPow();
+        default:              return eg.getLevel();
+    }
+}
+
+// Renders the envelope once step by step and once in blocks like
+// AbstractVoice::Synthesize() does (that is the block is dropped whenever the
+// envelope changes its stage, and it ends before the note is released).
+// Returns the maximum deviation between both.
+static float blocksDeviation(EG& egSteps, EG& egBlocks) {
+    float block[MAX_BLOCK_SIZE];
+    int pos = 0, size = 0;
+    float deviation = 0.0f;
+    for (int i = 0; i < STEPS; ++i) {
+        if (i == RELEASE_STEP) {
+            egSteps.update(EG::event_release, SUBFRAGMENT_RATE);
+            egBlocks.update(EG::event_release, SUBFRAGMENT_RATE);
+            size = 0;
+        }
+        if (pos >= size) {
+            size = MAX_BLOCK_SIZE;
+            if (i < RELEASE_STEP && RELEASE_STEP - i < size) size = RELEASE_STEP - i;
+            egBlocks.render(block, size);
+            pos = 0;
+        }
+        const float level = block[pos++];
+        egBlocks.advance(level);
+        deviation = fmax(deviation, fabs(level - processStep(egSteps)));
+
+        if (egSteps.active()) {
+            egSteps.increment(1);
+            if (!egSteps.toStageEndLeft()) egSteps.update(EG::event_stage_end, SUBFRAGMENT_RATE);
+        }
+        if (egBlocks.active()) {
+            egBlocks.increment(1);
+            if (!egBlocks.toStageEndLeft()) {
+                egBlocks.update(EG::event_stage_end, SUBFRAGMENT_RATE);
+                size = 0;
+            }
+        }
+        if (egSteps.getSegmentType() != egBlocks.getSegmentType()) return 1.0f;
+    }
+    return deviation;
+}
+
+
+// ModulationTest
+
+void ModulationTest::printTestSuiteName() {
+    cout << "\b \nRunning Modulation Tests: " << flush;
+}
+
+void ModulationTest::setUp() {
+}
+
+void ModulationTest::tearDown() {
+}
+
+// Check if all LFO types render the same wave in blocks as step by step.
+void ModulationTest::testLFOBlocks() {
+    const start_level_t startLevels[] = { start_level_max, start_level_mid, start_level_min };
+    for (int i = 0; i < 3; ++i) {
+        for (int flip = 0; flip < 2; ++flip) {
+            CPPUNIT_ASSERT((blocksEqualSteps<LFOTriangleIntMath<range_unsigned> >(5.3f, startLevels[i], flip)));
+            CPPUNIT_ASSERT((blocksEqualSteps<LFOTriangleIntMath<range_signed> >(5.3f, startLevels[i], flip)));
+            CPPUNIT_ASSERT((blocksEqualSteps<LFOTriangleIntAbsMath<range_unsigned> >(5.3f, startLevels[i], flip)));
+            CPPUNIT_ASSERT((blocksEqualSteps<LFOTriangleIntAbsMath<range_signed> >(5.3f, startLevels[i], flip)));
+            CPPUNIT_ASSERT((blocksEqualSteps<LFOTriangleDiHarmonic<range_unsigned> >(5.3f, startLevels[i], flip)));
+            CPPUNIT_ASSERT((blocksEqualSteps<LFOTriangleDiHarmonic<range_signed> >(5.3f, startLevels[i], flip)));
+        }
+    }
+    CPPUNIT_ASSERT((blocksEqualSteps<SineLFO<range_unsigned> >(5.3f, start_level_mid, false)));
+    CPPUNIT_ASSERT((blocksEqualSteps<SineLFO<range_signed> >(5.3f, start_level_mid, false)));
+    CPPUNIT_ASSERT((blocksEqualSteps<SawLFO<range_unsigned, true> >(5.3f, start_level_mid, false)));
+    CPPUNIT_ASSERT((blocksEqualSteps<SawLFO<range_signed, false> >(5.3f, start_level_mid, false)));
+    CPPUNIT_ASSERT((blocksEqualSteps<PulseLFO<range_unsigned, 250> >(5.3f, start_level_mid, false)));
+    CPPUNIT_ASSERT((blocksEqualSteps<PulseLFO<range_signed, 750> >(5.3f, start_level_mid, false)));
+}
+
+// Check if the ADSR envelope (linear and exponential segments) renders the
+// same levels in blocks as step by step, through all its stages.
+void ModulationTest::testEGBlocks() {
+    gig::EGADSR egSteps, egBlocks;
+    egSteps.trigger(100, 0.25f, false, 0.4f, 1.0, true, 500, 0.8f, 1.0f, SUBFRAGMENT_RATE);
+    egBlocks.trigger(100, 0.25f, false, 0.4f, 1.0, true, 500, 0.8f, 1.0f, SUBFRAGMENT_RATE);
+    CPPUNIT_ASSERT(blocksDeviation(egSteps, egBlocks) < MAX_DEVIATION);
+    CPPUNIT_ASSERT(!egBlocks.active());
+}
+
+// Check the same for a power curve segment.
+void ModulationTest::testEGPowBlocks() {
+    PowEG egSteps(2.5f, 1000.0f), egBlocks(2.5f, 1000.0f);
+    CPPUNIT_ASSERT(blocksDeviation(egSteps, egBlocks) < MAX_DEVIATION);
+}
+
+// Check the same for the (linear) pitch decay envelope.
+void ModulationTest::testEGDecayBlocks() {
+    gig::EGDecay egSteps, egBlocks;
+    egSteps.trigger(0.5f, 1.5f, SUBFRAGMENT_RATE);
+    egBlocks.trigger(0.5f, 1.5f, SUBFRAGMENT_RATE);
+    float block[MAX_BLOCK_SIZE];
+    float deviation = 0.0f;
+    for (int i = 0, n = 1; i < STEPS && egSteps.active(); i += n, n = n % MAX_BLOCK_SIZE + 1) {
+        egBlocks.render(block, n);
+        for (int k = 0; k < n && egSteps.active(); ++k) {
+            egBlocks.advance(block[k]);
+            deviation = fmax(deviation, fabs(block[k] - egSteps.render()));
+            egSteps.increment(1);
+            if (!egSteps.toEndLeft()) egSteps.update();
+        }
+    }
+    CPPUNIT_ASSERT(deviation < MAX_DEVIATION);
+}
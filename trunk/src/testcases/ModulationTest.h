@@ -0,0 +1,39 @@
+#ifndef __LS_MODULATIONTEST_H__
+#define __LS_MODULATIONTEST_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// the envelope generators and LFOs we want to test
+#include "../engines/gig/EGADSR.h"
+#include "../engines/gig/EGDecay.h"
+#include "../engines/common/LFOTriangleIntMath.h"
+#include "../engines/common/LFOTriangleIntAbsMath.h"
+#include "../engines/common/LFOTriangleDiHarmonic.h"
+#include "../engines/common/SineLFO.h"
+#include "../engines/common/SawLFO.h"
+#include "../engines/common/PulseLFO.h"
+
+class ModulationTest : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE(ModulationTest);
+    CPPUNIT_TEST(printTestSuiteName);
+    CPPUNIT_TEST(testLFOBlocks);
+    CPPUNIT_TEST(testEGBlocks);
+    CPPUNIT_TEST(testEGPowBlocks);
+    CPPUNIT_TEST(testEGDecayBlocks);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp();
+        void tearDown();
+
+        void printTestSuiteName();
+
+        void testLFOBlocks();
+        void testEGBlocks();
+        void testEGPowBlocks();
+        void testEGDecayBlocks();
+};
+
+#endif // __LS_MODULATIONTEST_H__
@@ -308,3 +308,51 @@ void PoolTest::testInvalidIterators() {
     CPPUNIT_ASSERT(pool.end() != true);
     CPPUNIT_ASSERT(!pool.end());
 }
+
+void PoolTest::testCountElements() {
+    Pool<int> pool(10);
+    RTList<int> list1(&pool);
+    RTList<int> list2(&pool);
+    CPPUNIT_ASSERT(pool.countFreeElements() == 10);
+    CPPUNIT_ASSERT(pool.poolHasFreeElements(10));
+    CPPUNIT_ASSERT(!pool.poolHasFreeElements(11));
+
+    for (int i = 0; i < 4; i++) *list1.allocAppend() = i;
+    for (int i = 0; i < 3; i++) *list2.allocPrepend() = i;
+    CPPUNIT_ASSERT(list1.count() == 4);
+    CPPUNIT_ASSERT(list2.count() == 3);
+    CPPUNIT_ASSERT(pool.countFreeElements() == 3);
+    CPPUNIT_ASSERT(pool.poolHasFreeElements(3));
+    CPPUNIT_ASSERT(!pool.poolHasFreeElements(4));
+
+    RTList<int>::Iterator it = list1.first();
+    it.moveToEndOf(&list2);
+    CPPUNIT_ASSERT(list1.count() == 3);
+    CPPUNIT_ASSERT(list2.count() == 4);
+
+    it = list2.first();
+    it.moveBefore(list1.first());
+    CPPUNIT_ASSERT(list1.count() == 4);
+    CPPUNIT_ASSERT(list2.count() == 3);
+
+    it = list2.last();
+    it.moveAfter(list1.last());
+    CPPUNIT_ASSERT(list1.count() == 5);
+    CPPUNIT_ASSERT(list2.count() == 2);
+
+    it = list1.first();
+    list1.free(it);
+    CPPUNIT_ASSERT(list1.count() == 4);
+    CPPUNIT_ASSERT(pool.countFreeElements() == 4);
+
+    list1.clear();
+    CPPUNIT_ASSERT(list1.count() == 0);
+    CPPUNIT_ASSERT(pool.countFreeElements() == 8);
+
+    list2.clear();
+    CPPUNIT_ASSERT(list2.count() == 0);
+    CPPUNIT_ASSERT(pool.countFreeElements() == 10);
+
+    pool.resizePool(20);
+    CPPUNIT_ASSERT(pool.countFreeElements() == 20);
+}
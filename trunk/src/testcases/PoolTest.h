@@ -46,6 +46,7 @@ class PoolTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testFreePool);
     CPPUNIT_TEST(testAccessElements);
     CPPUNIT_TEST(testInvalidIterators);
+    CPPUNIT_TEST(testCountElements);
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -68,6 +69,7 @@ class PoolTest : public CppUnit::TestFixture {
         void testFreePool();
         void testAccessElements();
         void testInvalidIterators();
+        void testCountElements();
 };
 
 #endif // __LS_POOLTEST_H__
@@ -0,0 +1,143 @@
+#include "ResamplerTest.h"
+
+#include <iostream>
+#include <math.h>
+#include <string.h>
+
+#define SOURCE_FRAMES 64
+#define OUTPUT_FRAMES 48
+#define IMPULSE       10000
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ResamplerTest);
+
+using namespace std;
+using namespace LinuxSampler;
+using namespace LinuxSampler::gig;
+
+static const interpolation_t algorithms[] = {
+    interpolation_linear, interpolation_cubic, interpolation_sinc
+};
+static const int algorithmsCount = sizeof(algorithms) / sizeof(algorithms[0]);
+
+// Plays a mono sample consisting of a single impulse at source sample point
+// @a iImpulsePos from its start (like a voice does) and returns the output
+// sample point where the impulse is heard loudest. If @a pPeak is given, the
+// peak of the rendered signal as measured by the synthesizer is stored there.
+template<bool INTERPOLATE, bool SIMD>
+static int renderImpulse(interpolation_t algorithm, int iImpulsePos, float fPitch, float* pPeak = NULL) {
+    sample_t src[SOURCE_FRAMES + MAX_INTERPOLATION_READ_AHEAD];
+    memset(src, 0, sizeof(src));
+    src[iImpulsePos] = IMPULSE;
+    float outL[OUTPUT_FRAMES], outR[OUTPUT_FRAMES];
+    memset(outL, 0, sizeof(outL));
+    memset(outR, 0, sizeof(outR));
+
+    int mixerMode = 0;
+    MIXER_MODE_SET_LEFT(mixerMode, true);
+    MIXER_MODE_SET_RIGHT(mixerMode, true);
+    MIXER_MODE_SET_IMPLEMENTATION(mixerMode, SIMD);
+
+    SynthesisParam param;
+    param.pMixFunction = Mixer::GetMixFunction(mixerMode);
+    param.fFinalPitch = fPitch;
+    param.fFinalVolumeLeft = 1.0f;
+    param.fFinalVolumeRight = 1.0f;
+    param.fFinalVolumeDeltaLeft = 0.0f;
+    param.fFinalVolumeDeltaRight = 0.0f;
+    param.pSrc = src;
+    param.Interpolation = algorithm;
+    param.dPos = -INTERPOLATION_PRE_ROLL; // see AbstractVoice::SetSampleStartOffset()
+    param.pOutLeft = outL;
+    param.pOutRight = outR;
+    param.uiToGo = OUTPUT_FRAMES;
+    param.fPeak = (pPeak) ? 0.0f : -1.0f;
+    Synthesizer<MONO, false, false, INTERPOLATE, false, false, SIMD>::SynthesizeSubFragment(&param, NULL);
+    if (pPeak) *pPeak = param.fPeak;
+
+    int peak = 0;
+    for (int i = 1; i < OUTPUT_FRAMES; ++i)
+        if (fabs(outL[i]) > fabs(outL[peak])) peak = i;
+    return peak;
+}
+
+static int impulseOutputPos(interpolation_t algorithm, int iImpulsePos, float fPitch, bool bSIMD) {
+#if HAVE_GCC_VECTOR_EXTENSIONS
+    if (bSIMD) return renderImpulse<true,true>(algorithm, iImpulsePos, fPitch);
+#endif
+    return renderImpulse<true,false>(algorithm, iImpulsePos, fPitch);
+}
+
+// returns the peak of the rendered impulse instead
+static float impulsePeak(interpolation_t algorithm, float fPitch, bool bSIMD) {
+    float fPeak = -1.0f;
+#if HAVE_GCC_VECTOR_EXTENSIONS
+    if (bSIMD) {
+        renderImpulse<true,true>(algorithm, 20, fPitch, &fPeak);
+        return fPeak;
+    }
+#endif
+    renderImpulse<true,false>(algorithm, 20, fPitch, &fPeak);
+    return fPeak;
+}
+
+// same without interpolation (thus pitch 1.0)
+static int impulseOutputPos(int iImpulsePos) {
+    return renderImpulse<false,false>(interpolation_linear, iImpulsePos, 1.0f);
+}
+
+
+// ResamplerTest
+
+void ResamplerTest::printTestSuiteName() {
+    cout << "\b \nRunning Resampler Tests: " << flush;
+}
+
+void ResamplerTest::setUp() {
+}
+
+void ResamplerTest::tearDown() {
+}
+
+// Check if all interpolation algorithms play an impulse at the same position
+// as without interpolation, with the C++ and the SIMD implementation.
+void ResamplerTest::testImpulsePosition() {
+    CPPUNIT_ASSERT_EQUAL(20, impulseOutputPos(20));
+    for (int i = 0; i < algorithmsCount; ++i) {
+        CPPUNIT_ASSERT_EQUAL(20, impulseOutputPos(algorithms[i], 20, 1.0f, false));
+        CPPUNIT_ASSERT_EQUAL(20, impulseOutputPos(algorithms[i], 20, 1.0f, true));
+    }
+}
+
+// Check if an impulse right at the sample start (the attack transient) is not
+// lost by any interpolation algorithm.
+void ResamplerTest::testImpulseAtSampleStart() {
+    CPPUNIT_ASSERT_EQUAL(0, impulseOutputPos(0));
+    for (int i = 0; i < algorithmsCount; ++i) {
+        CPPUNIT_ASSERT_EQUAL(0, impulseOutputPos(algorithms[i], 0, 1.0f, false));
+        CPPUNIT_ASSERT_EQUAL(0, impulseOutputPos(algorithms[i], 0, 1.0f, true));
+    }
+}
+
+// Check if the impulse is heard at the correct position when the sample is
+// pitched one octave down.
+void ResamplerTest::testImpulsePositionPitched() {
+    for (int i = 0; i < algorithmsCount; ++i) {
+        CPPUNIT_ASSERT_EQUAL(0,  impulseOutputPos(algorithms[i], 0, 0.5f, false));
+        CPPUNIT_ASSERT_EQUAL(0,  impulseOutputPos(algorithms[i], 0, 0.5f, true));
+        CPPUNIT_ASSERT_EQUAL(40, impulseOutputPos(algorithms[i], 20, 0.5f, false));
+        CPPUNIT_ASSERT_EQUAL(40, impulseOutputPos(algorithms[i], 20, 0.5f, true));
+    }
+}
+
+// Check if the synthesizer measures the peak of the rendered signal (as used
+// for culling silent voices) correctly, for all interpolation algorithms (the
+// sinc interpolation band limits the impulse, so its peak is a bit lower).
+void ResamplerTest::testSignalPeak() {
+    float fPeak = -1.0f;
+    renderImpulse<false,false>(interpolation_linear, 20, 1.0f, &fPeak);
+    CPPUNIT_ASSERT_EQUAL(float(IMPULSE), fPeak);
+    for (int i = 0; i < algorithmsCount; ++i) {
+        CPPUNIT_ASSERT(fabs(impulsePeak(algorithms[i], 1.0f, false) - IMPULSE) < IMPULSE * 0.15f);
+        CPPUNIT_ASSERT(fabs(impulsePeak(algorithms[i], 1.0f, true) - IMPULSE) < IMPULSE * 0.15f);
+    }
+}
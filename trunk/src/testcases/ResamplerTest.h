@@ -0,0 +1,32 @@
+#ifndef __LS_RESAMPLERTEST_H__
+#define __LS_RESAMPLERTEST_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// the synthesis core (and its Resampler) we want to test
+#include "../engines/gig/Synthesizer.h"
+
+class ResamplerTest : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE(ResamplerTest);
+    CPPUNIT_TEST(printTestSuiteName);
+    CPPUNIT_TEST(testImpulsePosition);
+    CPPUNIT_TEST(testImpulseAtSampleStart);
+    CPPUNIT_TEST(testImpulsePositionPitched);
+    CPPUNIT_TEST(testSignalPeak);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp();
+        void tearDown();
+
+        void printTestSuiteName();
+
+        void testImpulsePosition();
+        void testImpulseAtSampleStart();
+        void testImpulsePositionPitched();
+        void testSignalPeak();
+};
+
+#endif // __LS_RESAMPLERTEST_H__